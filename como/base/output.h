@@ -50,6 +50,12 @@ Q_SIGNALS:
      * Notifies that the output has been turned on and the wake can be decorated.
      */
     void wake_up();
+
+    /**
+     * Emitted right before the output is painted. Input coalesced per frame is flushed here so it
+     * is part of the frame.
+     */
+    void about_to_paint();
 };
 
 class output
@@ -0,0 +1,309 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "plugin_index.h"
+
+#include "logging.h"
+
+#include <KPackage/PackageLoader>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace como::base
+{
+
+namespace
+{
+
+constexpr int index_version{1};
+
+qint64 modification_time(QString const& path)
+{
+    QFileInfo const info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+}
+
+plugin_index::plugin_index()
+{
+    // Static plugins change with the binary.
+    application_mtime = modification_time(QCoreApplication::applicationFilePath());
+
+    if (qEnvironmentVariableIsSet("KWIN_PLUGIN_INDEX_CACHE")
+        && !qEnvironmentVariableIntValue("KWIN_PLUGIN_INDEX_CACHE")) {
+        return;
+    }
+
+    auto const location = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (location.isEmpty()) {
+        return;
+    }
+
+    cache_file = location + QStringLiteral("/como/plugin-index.json");
+    load();
+}
+
+plugin_index::~plugin_index() = default;
+
+QList<KPluginMetaData> plugin_index::plugins(QString const& plugin_namespace)
+{
+    return get(source_type::plugins, plugin_namespace, {}).metadata;
+}
+
+KPluginMetaData plugin_index::find_plugin(QString const& plugin_namespace, QString const& id)
+{
+    return find(get(source_type::plugins, plugin_namespace, {}), id);
+}
+
+QList<KPluginMetaData> plugin_index::packages(QString const& package_type, QString const& root)
+{
+    return get(source_type::packages, package_type, root).metadata;
+}
+
+KPluginMetaData
+plugin_index::find_package(QString const& package_type, QString const& root, QString const& id)
+{
+    return find(get(source_type::packages, package_type, root), id);
+}
+
+void plugin_index::refresh()
+{
+    bool changed{false};
+
+    for (auto& [key, src] : sources) {
+        if (!is_current(src)) {
+            scan(src);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        save();
+    }
+}
+
+plugin_index::source&
+plugin_index::get(source_type type, QString const& name, QString const& root)
+{
+    auto key = (type == source_type::plugins ? QStringLiteral("plugins:")
+                                             : QStringLiteral("packages:"))
+        + name + QLatin1Char(':') + root;
+
+    if (auto it = sources.find(key); it != sources.end()) {
+        return it->second;
+    }
+
+    auto& src = sources[key];
+    src.key = key;
+    src.type = type;
+    src.name = name;
+    src.root = root;
+
+    if (!restore(src, persisted.value(key).toObject())) {
+        scan(src);
+        save();
+    }
+
+    return src;
+}
+
+KPluginMetaData plugin_index::find(source& src, QString const& id)
+{
+    auto match = [&src, &id] {
+        for (auto const& data : std::as_const(src.metadata)) {
+            if (data.pluginId().compare(id, Qt::CaseInsensitive) == 0) {
+                return data;
+            }
+        }
+        return KPluginMetaData();
+    };
+
+    auto data = match();
+    if (!data.isValid() && !is_current(src)) {
+        // The plugin might have been installed since the last scan.
+        scan(src);
+        save();
+        data = match();
+    }
+
+    return data;
+}
+
+std::vector<plugin_index::file_stamp> plugin_index::stamp_directories(source const& src) const
+{
+    QStringList candidates;
+
+    if (src.type == source_type::packages) {
+        candidates = QStandardPaths::locateAll(
+            QStandardPaths::GenericDataLocation, src.root, QStandardPaths::LocateDirectory);
+    } else if (QDir::isAbsolutePath(src.name)) {
+        candidates << src.name;
+    } else {
+        for (auto const& path : QCoreApplication::libraryPaths()) {
+            candidates << path + QLatin1Char('/') + src.name;
+        }
+    }
+
+    std::vector<file_stamp> stamps;
+    for (auto const& dir : std::as_const(candidates)) {
+        if (auto const mtime = modification_time(dir); mtime >= 0) {
+            stamps.push_back({dir, mtime});
+        }
+    }
+    return stamps;
+}
+
+bool plugin_index::is_current(source const& src) const
+{
+    if (stamp_directories(src) != src.directories) {
+        return false;
+    }
+
+    return std::all_of(src.files.cbegin(), src.files.cend(), [](auto const& file) {
+        return modification_time(file.path) == file.mtime;
+    });
+}
+
+void plugin_index::scan(source& src)
+{
+    if (src.type == source_type::plugins) {
+        src.metadata = KPluginMetaData::findPlugins(src.name);
+    } else {
+        src.metadata = KPackage::PackageLoader::self()->listPackages(src.name, src.root);
+    }
+
+    src.directories = stamp_directories(src);
+    src.files.clear();
+    src.static_ids.clear();
+
+    QJsonArray directories;
+    for (auto const& dir : src.directories) {
+        directories.append(QJsonObject{{QStringLiteral("path"), dir.path},
+                                       {QStringLiteral("mtime"), dir.mtime}});
+    }
+
+    QJsonArray files;
+    for (auto const& data : std::as_const(src.metadata)) {
+        if (data.isStaticPlugin()) {
+            src.static_ids << data.pluginId();
+            continue;
+        }
+
+        auto const mtime = modification_time(data.fileName());
+        src.files.push_back({data.fileName(), mtime});
+        files.append(QJsonObject{{QStringLiteral("path"), data.fileName()},
+                                 {QStringLiteral("mtime"), mtime},
+                                 {QStringLiteral("metadata"), data.rawData()}});
+    }
+
+    persisted[src.key]
+        = QJsonObject{{QStringLiteral("directories"), directories},
+                      {QStringLiteral("files"), files},
+                      {QStringLiteral("static"), QJsonArray::fromStringList(src.static_ids)}};
+}
+
+bool plugin_index::restore(source& src, QJsonObject const& json) const
+{
+    if (json.isEmpty()) {
+        return false;
+    }
+
+    std::vector<file_stamp> directories;
+    for (auto const& value : json.value(QStringLiteral("directories")).toArray()) {
+        auto const dir = value.toObject();
+        directories.push_back({dir.value(QStringLiteral("path")).toString(),
+                               dir.value(QStringLiteral("mtime")).toInteger()});
+    }
+    if (directories != stamp_directories(src)) {
+        return false;
+    }
+
+    QList<KPluginMetaData> metadata;
+    QStringList static_ids;
+    std::vector<file_stamp> files;
+
+    // Static plugins come first like with KPluginMetaData::findPlugins.
+    for (auto const& value : json.value(QStringLiteral("static")).toArray()) {
+        auto const id = value.toString();
+        auto data = KPluginMetaData::findPluginById(src.name, id);
+        if (!data.isValid() || !data.isStaticPlugin()) {
+            return false;
+        }
+        metadata << data;
+        static_ids << id;
+    }
+
+    for (auto const& value : json.value(QStringLiteral("files")).toArray()) {
+        auto const file = value.toObject();
+        auto const path = file.value(QStringLiteral("path")).toString();
+        auto const mtime = file.value(QStringLiteral("mtime")).toInteger();
+
+        if (modification_time(path) != mtime) {
+            return false;
+        }
+
+        metadata << KPluginMetaData(file.value(QStringLiteral("metadata")).toObject(), path);
+        files.push_back({path, mtime});
+    }
+
+    src.directories = std::move(directories);
+    src.files = std::move(files);
+    src.static_ids = static_ids;
+    src.metadata = metadata;
+    return true;
+}
+
+void plugin_index::load()
+{
+    QFile file(cache_file);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    auto const root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value(QStringLiteral("version")).toInt() != index_version
+        || root.value(QStringLiteral("application_mtime")).toInteger() != application_mtime) {
+        qCDebug(KWIN_CORE) << "Plugin index outdated, rebuilding it";
+        return;
+    }
+
+    persisted = root.value(QStringLiteral("sources")).toObject();
+}
+
+void plugin_index::save() const
+{
+    if (cache_file.isEmpty()) {
+        return;
+    }
+    if (!QDir().mkpath(QFileInfo(cache_file).absolutePath())) {
+        qCWarning(KWIN_CORE) << "Could not create plugin index directory for" << cache_file;
+        return;
+    }
+
+    QJsonObject const root{{QStringLiteral("version"), index_version},
+                           {QStringLiteral("application_mtime"), application_mtime},
+                           {QStringLiteral("sources"), persisted}};
+
+    QSaveFile file(cache_file);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KWIN_CORE) << "Could not write plugin index" << cache_file;
+        return;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qCWarning(KWIN_CORE) << "Could not write plugin index" << cache_file;
+    }
+}
+
+}
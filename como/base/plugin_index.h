@@ -0,0 +1,106 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "como_export.h"
+
+#include <KPluginMetaData>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <map>
+#include <vector>
+
+namespace como::base
+{
+
+/**
+ * Index of the metadata of effect, script and decoration plugins.
+ *
+ * Plugins are either binary plugins in a plugin namespace or KPackage packages. Each source is
+ * scanned once on first use and then served from memory. The index is persisted in the user's
+ * cache location and reused on the next start as long as the modification times of the search
+ * directories and of all plugin files are unchanged. Setting KWIN_PLUGIN_INDEX_CACHE=0 disables
+ * the persistent index.
+ *
+ * Lookups that do not find a plugin check the source for changes on disk and rescan it if needed,
+ * so newly installed plugins are found. Must only be used from the main thread.
+ */
+class COMO_EXPORT plugin_index
+{
+public:
+    plugin_index();
+    ~plugin_index();
+
+    plugin_index(plugin_index const&) = delete;
+    plugin_index& operator=(plugin_index const&) = delete;
+
+    /**
+     * All binary plugins in @a plugin_namespace, including static ones.
+     */
+    QList<KPluginMetaData> plugins(QString const& plugin_namespace);
+    KPluginMetaData find_plugin(QString const& plugin_namespace, QString const& id);
+
+    /**
+     * All packages of @a package_type below @a root in the generic data locations.
+     */
+    QList<KPluginMetaData> packages(QString const& package_type, QString const& root);
+    KPluginMetaData find_package(QString const& package_type,
+                                 QString const& root,
+                                 QString const& id);
+
+    /**
+     * Checks all sources in use for changes on disk and rescans changed ones.
+     */
+    void refresh();
+
+private:
+    enum class source_type {
+        plugins,
+        packages,
+    };
+
+    struct file_stamp {
+        QString path;
+        qint64 mtime;
+
+        bool operator==(file_stamp const&) const = default;
+    };
+
+    struct source {
+        QString key;
+        source_type type;
+        // Plugin namespace or package type.
+        QString name;
+        // Package root.
+        QString root;
+
+        std::vector<file_stamp> directories;
+        std::vector<file_stamp> files;
+        // Static plugins have no file and are identified by their id.
+        QStringList static_ids;
+
+        QList<KPluginMetaData> metadata;
+    };
+
+    source& get(source_type type, QString const& name, QString const& root);
+    KPluginMetaData find(source& src, QString const& id);
+
+    std::vector<file_stamp> stamp_directories(source const& src) const;
+    bool is_current(source const& src) const;
+    void scan(source& src);
+    bool restore(source& src, QJsonObject const& json) const;
+
+    void load();
+    void save() const;
+
+    std::map<QString, source> sources;
+    QJsonObject persisted;
+    QString cache_file;
+    qint64 application_mtime{0};
+};
+
+}
@@ -0,0 +1,165 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "startup_tracer.h"
+
+#include "logging.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <algorithm>
+
+namespace como::base
+{
+
+namespace
+{
+
+double to_us(std::chrono::nanoseconds time)
+{
+    return std::chrono::duration<double, std::micro>(time).count();
+}
+
+}
+
+startup_tracer::scope::scope(startup_tracer& tracer, QString name, QString category)
+    : tracer{tracer}
+    , name{std::move(name)}
+    , category{std::move(category)}
+    , begin{tracer.now()}
+{
+}
+
+startup_tracer::scope::~scope()
+{
+    tracer.add(name, category, begin);
+}
+
+startup_tracer::startup_tracer()
+    : origin{std::chrono::steady_clock::now()}
+{
+}
+
+std::chrono::nanoseconds startup_tracer::now() const
+{
+    return std::chrono::steady_clock::now() - origin;
+}
+
+void startup_tracer::add(QString const& name,
+                         QString const& category,
+                         std::chrono::nanoseconds begin,
+                         std::chrono::nanoseconds end)
+{
+    if (finished()) {
+        // Reinitialization at runtime, for example of the compositor, is not part of the startup.
+        // Xwayland though is started on demand and commonly becomes ready only after the first
+        // frame. Its first start is still recorded.
+        if (category != QStringLiteral("xwl")
+            || std::any_of(recorded.cbegin(), recorded.cend(), [&](auto const& phase) {
+                   return phase.name == name && phase.category == category;
+               })) {
+            return;
+        }
+
+        recorded.push_back({name, category, begin, end});
+        write_requested();
+        return;
+    }
+    recorded.push_back({name, category, begin, end});
+}
+
+void startup_tracer::add(QString const& name,
+                         QString const& category,
+                         std::chrono::nanoseconds begin)
+{
+    add(name, category, begin, now());
+}
+
+void startup_tracer::finish()
+{
+    if (finished()) {
+        return;
+    }
+
+    first_frame_time = now();
+    qCDebug(KWIN_CORE) << "First frame presented after"
+                       << std::chrono::duration_cast<std::chrono::milliseconds>(*first_frame_time)
+                              .count()
+                       << "ms";
+
+    write_requested();
+}
+
+bool startup_tracer::finished() const
+{
+    return first_frame_time.has_value();
+}
+
+std::optional<std::chrono::nanoseconds> startup_tracer::first_frame() const
+{
+    return first_frame_time;
+}
+
+std::vector<startup_tracer::phase> const& startup_tracer::phases() const
+{
+    return recorded;
+}
+
+QJsonDocument startup_tracer::chrome_trace() const
+{
+    auto const pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+
+    for (auto const& phase : recorded) {
+        events.append(QJsonObject{{QStringLiteral("name"), phase.name},
+                                  {QStringLiteral("cat"), phase.category},
+                                  {QStringLiteral("ph"), QStringLiteral("X")},
+                                  {QStringLiteral("ts"), to_us(phase.begin)},
+                                  {QStringLiteral("dur"), to_us(phase.duration())},
+                                  {QStringLiteral("pid"), pid},
+                                  {QStringLiteral("tid"), 0}});
+    }
+
+    if (first_frame_time) {
+        events.append(QJsonObject{{QStringLiteral("name"), QStringLiteral("first frame")},
+                                  {QStringLiteral("cat"), QStringLiteral("render")},
+                                  {QStringLiteral("ph"), QStringLiteral("i")},
+                                  {QStringLiteral("s"), QStringLiteral("g")},
+                                  {QStringLiteral("ts"), to_us(*first_frame_time)},
+                                  {QStringLiteral("pid"), pid},
+                                  {QStringLiteral("tid"), 0}});
+    }
+
+    return QJsonDocument(QJsonObject{{QStringLiteral("traceEvents"), events},
+                                     {QStringLiteral("displayTimeUnit"), QStringLiteral("ms")}});
+}
+
+void startup_tracer::write_requested() const
+{
+    auto const path = qEnvironmentVariable("KWIN_STARTUP_TRACE");
+    if (!path.isEmpty()) {
+        write(path);
+    }
+}
+
+bool startup_tracer::write(QString const& path) const
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KWIN_CORE) << "Could not write startup trace" << path;
+        return false;
+    }
+
+    file.write(chrome_trace().toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qCWarning(KWIN_CORE) << "Could not write startup trace" << path;
+        return false;
+    }
+    return true;
+}
+
+}
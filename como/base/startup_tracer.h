@@ -0,0 +1,104 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "como_export.h"
+
+#include <QJsonDocument>
+#include <QString>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace como::base
+{
+
+/**
+ * Records the duration of the initialization phases of the compositor until the first frame has
+ * been presented.
+ *
+ * Times are relative to the creation of the tracer, which is the first member of the base
+ * platform. The trace can be exported in the Chrome trace event format for viewing it in
+ * chrome://tracing or Perfetto. When the environment variable KWIN_STARTUP_TRACE is set to a file
+ * path the trace is written there once the first frame has been presented.
+ *
+ * Phases after the first frame are ignored, except the first start of Xwayland, which is started
+ * on demand. The trace is written again when it is recorded.
+ */
+class COMO_EXPORT startup_tracer
+{
+public:
+    struct phase {
+        QString name;
+        // Subsystem, for example base, render, win, input, xwl or script.
+        QString category;
+        std::chrono::nanoseconds begin;
+        std::chrono::nanoseconds end;
+
+        std::chrono::nanoseconds duration() const
+        {
+            return end - begin;
+        }
+    };
+
+    /**
+     * Records a phase from its construction until its destruction.
+     */
+    class COMO_EXPORT scope
+    {
+    public:
+        scope(startup_tracer& tracer, QString name, QString category);
+        ~scope();
+
+        scope(scope const&) = delete;
+        scope& operator=(scope const&) = delete;
+
+    private:
+        startup_tracer& tracer;
+        QString name;
+        QString category;
+        std::chrono::nanoseconds begin;
+    };
+
+    startup_tracer();
+
+    /**
+     * Time since the tracer was created.
+     */
+    std::chrono::nanoseconds now() const;
+
+    void add(QString const& name,
+             QString const& category,
+             std::chrono::nanoseconds begin,
+             std::chrono::nanoseconds end);
+
+    /**
+     * Records a phase that started at @a begin and ends now.
+     */
+    void add(QString const& name, QString const& category, std::chrono::nanoseconds begin);
+
+    /**
+     * Called on every presented frame. The first call ends the startup and writes the trace if
+     * requested. Later calls are ignored.
+     */
+    void finish();
+
+    bool finished() const;
+    std::optional<std::chrono::nanoseconds> first_frame() const;
+    std::vector<phase> const& phases() const;
+
+    QJsonDocument chrome_trace() const;
+    bool write(QString const& path) const;
+
+private:
+    void write_requested() const;
+
+    std::chrono::steady_clock::time_point origin;
+    std::vector<phase> recorded;
+    std::optional<std::chrono::nanoseconds> first_frame_time;
+};
+
+}
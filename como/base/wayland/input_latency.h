@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace como::base::wayland
+{
+
+/**
+ * Timing of a processed input event. All values are in CLOCK_MONOTONIC time.
+ */
+struct input_latency_mark {
+    // Kernel timestamp of the event.
+    std::chrono::nanoseconds event;
+    std::chrono::nanoseconds process_begin;
+    std::chrono::nanoseconds process_end;
+};
+
+/**
+ * Records processed input events for measuring the latency until the frame that reflects them is
+ * presented.
+ *
+ * Outputs query the earliest input since the last one they presented. Every input is assumed to
+ * be reflected in the next presented frame of each output.
+ */
+class input_latency_tracker
+{
+public:
+    /**
+     * Records an input event. @a time_msec is the millisecond timestamp of the event as provided by
+     * libinput, @a begin and @a end are the monotonic times around processing it.
+     */
+    void add(uint32_t time_msec, std::chrono::nanoseconds begin, std::chrono::nanoseconds end)
+    {
+        // Device timestamps wrap around after 49 days. Reconstruct the full time from the distance
+        // to now.
+        auto const begin_ms = std::chrono::duration_cast<std::chrono::milliseconds>(begin);
+        auto const age
+            = std::chrono::milliseconds(static_cast<uint32_t>(begin_ms.count()) - time_msec);
+
+        if (age > max_age) {
+            // Not a kernel timestamp, for example from a fake input device.
+            return;
+        }
+
+        marks.push_back({++last, {begin_ms - age, begin, end}});
+        if (marks.size() > max_marks) {
+            marks.pop_front();
+        }
+    }
+
+    /**
+     * Identifies the last recorded input.
+     */
+    uint64_t last_id() const
+    {
+        return last;
+    }
+
+    /**
+     * Returns the input with the earliest event time recorded after the input @a id.
+     */
+    std::optional<input_latency_mark> earliest_since(uint64_t id) const
+    {
+        std::optional<input_latency_mark> earliest;
+
+        for (auto it = marks.rbegin(); it != marks.rend() && it->id > id; ++it) {
+            if (!earliest || it->mark.event < earliest->event) {
+                earliest = it->mark;
+            }
+        }
+        return earliest;
+    }
+
+private:
+    struct entry {
+        uint64_t id;
+        input_latency_mark mark;
+    };
+
+    static constexpr size_t max_marks{512};
+    static constexpr std::chrono::milliseconds max_age{10000};
+
+    std::deque<entry> marks;
+    uint64_t last{0};
+};
+
+}
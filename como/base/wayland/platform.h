@@ -9,7 +9,10 @@
 
 #include <como/base/backend/wlroots/backend.h>
 #include <como/base/platform_qobject.h>
+#include <como/base/plugin_index.h>
 #include <como/base/singleton_interface.h>
+#include <como/base/startup_tracer.h>
+#include <como/base/wayland/input_latency.h>
 #include <como/base/wayland/platform_helpers.h>
 #include <como/input/wayland/platform.h>
 #include <como/render/wayland/platform.h>
@@ -59,6 +62,7 @@ public:
         , backend{*this, args.headless}
     {
         wayland::platform_init(*this);
+        startup.add(QStringLiteral("base platform"), QStringLiteral("base"), {});
     }
 
     platform(type const&) = delete;
@@ -72,11 +76,14 @@ public:
         singleton_interface::get_outputs = {};
     }
 
+    // First member to cover the complete startup.
+    startup_tracer startup;
     std::unique_ptr<platform_qobject> qobject;
     base::operation_mode operation_mode;
     output_topology topology;
     base::config config;
     std::unique_ptr<base::options> options;
+    base::plugin_index plugins;
 
     std::unique_ptr<wayland::server<type>> server;
     std::unique_ptr<Wrapland::Server::drm_lease_device_v1> drm_lease_device;
@@ -91,6 +98,8 @@ public:
     backend_t backend;
     QProcessEnvironment process_environment;
 
+    input_latency_tracker input_latency;
+
     Mod mod;
 };
 
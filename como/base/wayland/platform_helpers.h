@@ -10,6 +10,7 @@
 #include <como/base/options.h>
 #include <como/base/platform_helpers.h>
 #include <como/base/seat/backend/wlroots/session.h>
+#include <como/base/startup_tracer.h>
 #include <como/base/types.h>
 #include <como/utils/flags.h>
 
@@ -61,7 +62,11 @@ void platform_init(Platform& platform)
     session->take_control(platform.server->display->native());
     platform.session = std::move(session);
 
-    platform.options = create_options(platform.operation_mode, platform.config.main);
+    {
+        startup_tracer::scope trace(
+            platform.startup, QStringLiteral("options"), QStringLiteral("base"));
+        platform.options = create_options(platform.operation_mode, platform.config.main);
+    }
 
     base::platform_init(platform);
 }
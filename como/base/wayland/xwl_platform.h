@@ -9,7 +9,10 @@
 
 #include <como/base/backend/wlroots/backend.h>
 #include <como/base/platform_qobject.h>
+#include <como/base/plugin_index.h>
 #include <como/base/singleton_interface.h>
+#include <como/base/startup_tracer.h>
+#include <como/base/wayland/input_latency.h>
 #include <como/base/wayland/platform_helpers.h>
 #include <como/base/x11/data.h>
 #include <como/base/x11/event_filter_manager.h>
@@ -64,6 +67,7 @@ public:
         , x11_event_filters{std::make_unique<base::x11::event_filter_manager>()}
     {
         wayland::platform_init(*this);
+        startup.add(QStringLiteral("base platform"), QStringLiteral("base"), {});
     }
 
     xwl_platform(type const&) = delete;
@@ -77,12 +81,15 @@ public:
         singleton_interface::get_outputs = {};
     }
 
+    // First member to cover the complete startup.
+    startup_tracer startup;
     std::unique_ptr<platform_qobject> qobject;
     base::operation_mode operation_mode;
     output_topology topology;
     base::config config;
     base::x11::data x11_data;
     std::unique_ptr<base::options> options;
+    base::plugin_index plugins;
 
     std::unique_ptr<wayland::server<type>> server;
     std::unique_ptr<Wrapland::Server::drm_lease_device_v1> drm_lease_device;
@@ -96,6 +103,8 @@ public:
     backend_t backend;
     QProcessEnvironment process_environment;
 
+    input_latency_tracker input_latency;
+
     std::unique_ptr<x11::event_filter_manager> x11_event_filters;
 
     Mod mod;
@@ -9,7 +9,9 @@
 #include <como/base/logging.h>
 #include <como/base/platform_helpers.h>
 #include <como/base/platform_qobject.h>
+#include <como/base/plugin_index.h>
 #include <como/base/singleton_interface.h>
+#include <como/base/startup_tracer.h>
 #include <como/base/x11/data.h>
 #include <como/base/x11/event_filter.h>
 #include <como/base/x11/event_filter_manager.h>
@@ -65,6 +67,7 @@ public:
         x11_data.screen_number = QX11Info::appScreen();
 
         platform_init(*this);
+        startup.add(QStringLiteral("base platform"), QStringLiteral("base"), {});
     }
 
     virtual ~platform()
@@ -91,6 +94,8 @@ public:
         update_outputs_impl<base::x11::xcb::randr::current_resources>();
     }
 
+    // First member to cover the complete startup.
+    startup_tracer startup;
     std::unique_ptr<platform_qobject> qobject;
     base::operation_mode operation_mode;
     output_topology topology;
@@ -100,6 +105,7 @@ public:
 
     std::unique_ptr<backend::x11::wm_selection_owner> owner;
     std::unique_ptr<base::options> options;
+    base::plugin_index plugins;
     std::unique_ptr<base::seat::session> session;
     std::unique_ptr<x11::event_filter_manager> x11_event_filters;
 
@@ -10,11 +10,13 @@
 #include <como/input/event_spy.h>
 #include <como/input/keyboard.h>
 #include <como/input/qt_event.h>
+#include <como_export.h>
 
 #include <KLocalizedString>
 #include <QDebug>
 #include <QMetaEnum>
 #include <QTextEdit>
+#include <typeinfo>
 
 namespace como::debug
 {
@@ -24,7 +26,7 @@ class input_filter : public input::event_spy<Redirect>
 {
 public:
     input_filter(Redirect& redirect, QTextEdit* textEdit)
-        : input::event_spy<Redirect>(redirect)
+        : input::event_spy<Redirect>(redirect, input::event_spy_kinds<input_filter>())
         , m_textEdit(textEdit)
     {
         m_textEdit->document()->setMaximumBlockCount(1000);
@@ -610,4 +612,29 @@ private:
     static constexpr char s_tableEnd[] = "</table>";
 };
 
+COMO_EXPORT QString input_dispatch_name(std::type_info const& type);
+
+/**
+ * Lists the filters in processing order and the spies together with the number of events each of
+ * them was called for.
+ */
+template<typename Redirect>
+QString input_dispatch_report(Redirect const& redirect)
+{
+    QString text;
+
+    auto add_section = [&text](QString const& title, auto const& receivers) {
+        text.append(title + QLatin1Char('\n'));
+        for (auto receiver : receivers) {
+            text.append(QStringLiteral("  %1: %2\n")
+                            .arg(input_dispatch_name(typeid(*receiver)))
+                            .arg(receiver->dispatch_count));
+        }
+    };
+
+    add_section(i18nc("Input event filters in the debug console", "Filters"), redirect.m_filters);
+    add_section(i18nc("Input event spies in the debug console", "Spies"), redirect.m_spies);
+    return text;
+}
+
 }
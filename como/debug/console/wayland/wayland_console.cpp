@@ -17,10 +17,32 @@
 #include "ui_debug_console.h"
 
 #include <Wrapland/Server/surface.h>
+#include <cstdlib>
+#include <cxxabi.h>
 
 namespace como::debug
 {
 
+QString input_dispatch_name(std::type_info const& type)
+{
+    auto name = QString::fromLatin1(type.name());
+
+    int status{0};
+    if (auto demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status)) {
+        name = QString::fromLatin1(demangled);
+        std::free(demangled);
+    }
+
+    // Filters and spies are templated on the redirect. Only the class name is of interest.
+    if (auto const args = name.indexOf(QLatin1Char('<')); args >= 0) {
+        name.truncate(args);
+    }
+    if (auto const scope = name.lastIndexOf(QLatin1String("::")); scope >= 0) {
+        name.remove(0, scope + 2);
+    }
+    return name;
+}
+
 wayland_console_model::wayland_console_model(QObject* parent)
     : console_model(parent)
 {
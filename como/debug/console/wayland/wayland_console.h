@@ -12,8 +12,14 @@
 
 #include <como/debug/console/console.h>
 #include <como/input/redirect_qobject.h>
+#include <como/render/wayland/input_latency.h>
 #include <como_export.h>
 
+#include <KLocalizedString>
+#include <QJsonDocument>
+#include <QPlainTextEdit>
+#include <QTimer>
+
 namespace como::debug
 {
 
@@ -75,14 +81,39 @@ public:
             this->m_ui->inputDevicesView->setItemDelegate(new wayland_console_delegate(this));
         }
 
+        dispatch_text_edit = new QPlainTextEdit(this);
+        dispatch_text_edit->setReadOnly(true);
+        dispatch_text_edit->setMaximumHeight(200);
+        this->m_ui->input->layout()->addWidget(dispatch_text_edit);
+
+        // Refresh the dispatch counters while the input tab is shown.
+        dispatch_timer.setInterval(1000);
+        QObject::connect(&dispatch_timer, &QTimer::timeout, this, [this, &space] {
+            dispatch_text_edit->setPlainText(input_dispatch_report(*space.input));
+        });
+
+        latency_text_edit = new QPlainTextEdit(this);
+        latency_text_edit->setReadOnly(true);
+        auto const latency_tab = this->m_ui->tabWidget->addTab(
+            latency_text_edit, i18nc("Tab of the debug console", "Input Latency"));
+
         QObject::connect(
-            this->m_ui->tabWidget, &QTabWidget::currentChanged, this, [this, &space](int index) {
+            this->m_ui->tabWidget,
+            &QTabWidget::currentChanged,
+            this,
+            [this, &space, latency_tab](int index) {
                 // delay creation of input event filter until the tab is selected
                 if (!m_inputFilter && index == 2) {
                     m_inputFilter = std::make_unique<input_filter<typename Space::input_t>>(
                         *space.input, this->m_ui->inputTextEdit);
                     space.input->m_spies.push_back(m_inputFilter.get());
                 }
+                if (index == 2) {
+                    dispatch_text_edit->setPlainText(input_dispatch_report(*space.input));
+                    dispatch_timer.start();
+                } else {
+                    dispatch_timer.stop();
+                }
                 if (index == 5) {
                     update_keyboard_tab();
                     QObject::connect(space.input->qobject.get(),
@@ -90,6 +121,11 @@ public:
                                      this,
                                      &wayland_console::update_keyboard_tab);
                 }
+                if (index == latency_tab) {
+                    auto const report = render::wayland::input_latency_report(space.base.outputs);
+                    latency_text_edit->setPlainText(
+                        QString::fromUtf8(QJsonDocument(report).toJson(QJsonDocument::Indented)));
+                }
             });
 
         // TODO(romangg): Can we do that on Wayland differently?
@@ -153,6 +189,9 @@ private:
     }
 
     std::unique_ptr<input_filter<typename Space::input_t>> m_inputFilter;
+    QPlainTextEdit* dispatch_text_edit;
+    QTimer dispatch_timer;
+    QPlainTextEdit* latency_text_edit;
 };
 
 }
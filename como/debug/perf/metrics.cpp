@@ -0,0 +1,198 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "metrics.h"
+
+#include <QStringList>
+#include <algorithm>
+#include <cassert>
+
+namespace como::debug
+{
+
+namespace
+{
+
+QString escape_label(QString value)
+{
+    value.replace(QLatin1Char('\\'), QStringLiteral("\\\\"));
+    value.replace(QLatin1Char('"'), QStringLiteral("\\\""));
+    value.replace(QLatin1Char('\n'), QStringLiteral("\\n"));
+    return value;
+}
+
+QString format_labels(metric_labels const& labels)
+{
+    QStringList pairs;
+    for (auto const& [key, value] : labels) {
+        pairs << key + QStringLiteral("=\"") + escape_label(value) + QLatin1Char('"');
+    }
+    return pairs.join(QLatin1Char(','));
+}
+
+QString with_labels(QString const& name, QString const& labels, QString const& extra = {})
+{
+    if (labels.isEmpty() && extra.isEmpty()) {
+        return name;
+    }
+    if (labels.isEmpty()) {
+        return name + QLatin1Char('{') + extra + QLatin1Char('}');
+    }
+    if (extra.isEmpty()) {
+        return name + QLatin1Char('{') + labels + QLatin1Char('}');
+    }
+    return name + QLatin1Char('{') + labels + QLatin1Char(',') + extra + QLatin1Char('}');
+}
+
+QString format_value(double value)
+{
+    return QString::number(value, 'g', 15);
+}
+
+}
+
+metric_histogram::metric_histogram(std::vector<double> bounds)
+    : bounds{std::move(bounds)}
+    , buckets{std::make_unique<std::atomic<uint64_t>[]>(this->bounds.size() + 1)}
+{
+    assert(std::is_sorted(this->bounds.cbegin(), this->bounds.cend()));
+}
+
+void metric_histogram::observe(double value)
+{
+    auto const it = std::lower_bound(bounds.cbegin(), bounds.cend(), value);
+    buckets[it - bounds.cbegin()].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::vector<double> metric_histogram::frame_bounds()
+{
+    return {0.0005, 0.001, 0.002, 0.004, 0.006, 0.008, 0.012, 0.0167, 0.025, 0.0334, 0.05, 0.1};
+}
+
+metrics_registry& metrics_registry::instance()
+{
+    static metrics_registry registry;
+    return registry;
+}
+
+template<typename Metric, typename... Args>
+Metric& metrics_registry::get(QString const& name,
+                              QString const& help,
+                              metric_labels const& labels,
+                              Args&&... args)
+{
+    std::lock_guard lock(mutex);
+
+    auto& fam = families[name];
+    if (fam.help.isEmpty()) {
+        fam.help = help;
+    }
+
+    auto const key = format_labels(labels);
+    if (auto it = fam.series.find(key); it != fam.series.end()) {
+        // A name must always be used with the same metric type.
+        assert(std::holds_alternative<std::unique_ptr<Metric>>(it->second));
+        return *std::get<std::unique_ptr<Metric>>(it->second);
+    }
+
+    auto metric = std::make_unique<Metric>(std::forward<Args>(args)...);
+    auto& ref = *metric;
+    fam.series.emplace(key, std::move(metric));
+    return ref;
+}
+
+metric_counter&
+metrics_registry::counter(QString const& name, QString const& help, metric_labels const& labels)
+{
+    return get<metric_counter>(name, help, labels);
+}
+
+metric_gauge&
+metrics_registry::gauge(QString const& name, QString const& help, metric_labels const& labels)
+{
+    return get<metric_gauge>(name, help, labels);
+}
+
+metric_histogram& metrics_registry::histogram(QString const& name,
+                                              QString const& help,
+                                              std::vector<double> const& bounds,
+                                              metric_labels const& labels)
+{
+    return get<metric_histogram>(name, help, labels, bounds);
+}
+
+void metrics_registry::remove(metric_labels const& labels)
+{
+    std::lock_guard lock(mutex);
+
+    auto const key = format_labels(labels);
+    for (auto& [name, fam] : families) {
+        fam.series.erase(key);
+    }
+}
+
+QByteArray metrics_registry::prometheus() const
+{
+    std::lock_guard lock(mutex);
+
+    QString text;
+    for (auto const& [name, fam] : families) {
+        if (fam.series.empty()) {
+            continue;
+        }
+
+        auto const type = std::visit(
+            [](auto const& metric) {
+                using metric_t = typename std::decay_t<decltype(metric)>::element_type;
+                if constexpr (std::is_same_v<metric_t, metric_counter>) {
+                    return QStringLiteral("counter");
+                } else if constexpr (std::is_same_v<metric_t, metric_gauge>) {
+                    return QStringLiteral("gauge");
+                } else {
+                    return QStringLiteral("histogram");
+                }
+            },
+            fam.series.cbegin()->second);
+
+        text += QStringLiteral("# HELP ") + name + QLatin1Char(' ') + fam.help + QLatin1Char('\n');
+        text += QStringLiteral("# TYPE ") + name + QLatin1Char(' ') + type + QLatin1Char('\n');
+
+        for (auto const& [labels, metric] : fam.series) {
+            if (auto counter = std::get_if<std::unique_ptr<metric_counter>>(&metric)) {
+                text += with_labels(name, labels) + QLatin1Char(' ')
+                    + format_value((*counter)->value()) + QLatin1Char('\n');
+            } else if (auto gauge = std::get_if<std::unique_ptr<metric_gauge>>(&metric)) {
+                text += with_labels(name, labels) + QLatin1Char(' ')
+                    + format_value((*gauge)->value()) + QLatin1Char('\n');
+            } else {
+                auto const& hist = *std::get<std::unique_ptr<metric_histogram>>(metric);
+                auto const bucket_name = name + QStringLiteral("_bucket");
+
+                // Buckets are cumulative in the exposition format.
+                uint64_t cumulative{0};
+                for (size_t i = 0; i <= hist.bounds.size(); i++) {
+                    cumulative += hist.buckets[i].load(std::memory_order_relaxed);
+                    auto const bound = i < hist.bounds.size() ? format_value(hist.bounds[i])
+                                                              : QStringLiteral("+Inf");
+                    auto const le = QStringLiteral("le=\"") + bound + QLatin1Char('"');
+                    text += with_labels(bucket_name, labels, le) + QLatin1Char(' ')
+                        + QString::number(cumulative) + QLatin1Char('\n');
+                }
+
+                text += with_labels(name + QStringLiteral("_sum"), labels) + QLatin1Char(' ')
+                    + format_value(hist.sum.load(std::memory_order_relaxed)) + QLatin1Char('\n');
+                text += with_labels(name + QStringLiteral("_count"), labels) + QLatin1Char(' ')
+                    + QString::number(hist.count.load(std::memory_order_relaxed))
+                    + QLatin1Char('\n');
+            }
+        }
+    }
+
+    return text.toUtf8();
+}
+
+}
@@ -0,0 +1,157 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "como_export.h"
+
+#include <QByteArray>
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace como::debug
+{
+
+using metric_labels = std::vector<std::pair<QString, QString>>;
+
+/**
+ * Monotonically increasing value.
+ */
+class COMO_EXPORT metric_counter
+{
+public:
+    void add(double value = 1)
+    {
+        count.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    double value() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> count{0};
+};
+
+/**
+ * Value that can go up and down.
+ */
+class COMO_EXPORT metric_gauge
+{
+public:
+    void set(double value)
+    {
+        current.store(value, std::memory_order_relaxed);
+    }
+
+    void add(double value)
+    {
+        current.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    double value() const
+    {
+        return current.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> current{0};
+};
+
+/**
+ * Distribution of values in cumulative buckets. Durations are recorded in seconds.
+ */
+class COMO_EXPORT metric_histogram
+{
+public:
+    explicit metric_histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    void observe(std::chrono::nanoseconds duration)
+    {
+        observe(std::chrono::duration<double>(duration).count());
+    }
+
+    /**
+     * Bucket bounds in seconds suited for durations in the range of a frame.
+     */
+    static std::vector<double> frame_bounds();
+
+    std::vector<double> const bounds;
+
+private:
+    friend class metrics_registry;
+
+    // One more than bounds for the values above the last bound.
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    std::atomic<uint64_t> count{0};
+    std::atomic<double> sum{0};
+};
+
+/**
+ * Process wide registry of performance metrics.
+ *
+ * Metrics are identified by their name and labels and are created on first request. The returned
+ * references stay valid until the series are removed, so callers should look them up once and
+ * keep them. Updating metrics is lock-free and can be done from any thread.
+ */
+class COMO_EXPORT metrics_registry
+{
+public:
+    static metrics_registry& instance();
+
+    metric_counter&
+    counter(QString const& name, QString const& help, metric_labels const& labels = {});
+    metric_gauge& gauge(QString const& name, QString const& help, metric_labels const& labels = {});
+    metric_histogram& histogram(QString const& name,
+                                QString const& help,
+                                std::vector<double> const& bounds,
+                                metric_labels const& labels = {});
+
+    /**
+     * Removes the series with exactly @a labels of all metrics, for example the ones of an output
+     * that got unplugged. References to them become invalid.
+     */
+    void remove(metric_labels const& labels);
+
+    /**
+     * All metrics in the Prometheus text exposition format.
+     */
+    QByteArray prometheus() const;
+
+private:
+    metrics_registry() = default;
+
+    using metric = std::variant<std::unique_ptr<metric_counter>,
+                                std::unique_ptr<metric_gauge>,
+                                std::unique_ptr<metric_histogram>>;
+
+    struct family {
+        QString help;
+        // Series by their formatted labels.
+        std::map<QString, metric> series;
+    };
+
+    template<typename Metric, typename... Args>
+    Metric& get(QString const& name,
+                QString const& help,
+                metric_labels const& labels,
+                Args&&... args);
+
+    mutable std::mutex mutex;
+    std::map<QString, family> families;
+};
+
+}
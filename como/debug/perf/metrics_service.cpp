@@ -0,0 +1,158 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "metrics_service.h"
+
+#include "metrics.h"
+
+#include <como/base/logging.h>
+
+#include <QDBusConnection>
+#include <QFile>
+#include <QSocketNotifier>
+#include <QStandardPaths>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace como::debug
+{
+
+namespace
+{
+
+bool set_address(sockaddr_un& address, QByteArray const& path)
+{
+    if (path.size() >= static_cast<qsizetype>(sizeof(address.sun_path))) {
+        return false;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.constData(), path.size());
+    return true;
+}
+
+bool is_in_use(sockaddr_un const& address)
+{
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        return false;
+    }
+
+    auto const in_use
+        = ::connect(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) == 0;
+    close(fd);
+    return in_use;
+}
+
+}
+
+metrics_service::metrics_service()
+{
+    QDBusConnection::sessionBus().registerObject(
+        QStringLiteral("/Metrics"), this, QDBusConnection::ExportScriptableSlots);
+    listen();
+}
+
+metrics_service::~metrics_service()
+{
+    QDBusConnection::sessionBus().unregisterObject(QStringLiteral("/Metrics"));
+
+    notifier.reset();
+    if (socket_fd != -1) {
+        close(socket_fd);
+        unlink(QFile::encodeName(socket_path).constData());
+    }
+}
+
+QString metrics_service::metrics() const
+{
+    return QString::fromUtf8(metrics_registry::instance().prometheus());
+}
+
+void metrics_service::listen()
+{
+    if (qEnvironmentVariableIsSet("KWIN_METRICS_SOCKET")) {
+        socket_path = qEnvironmentVariable("KWIN_METRICS_SOCKET");
+    } else if (auto const dir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+               !dir.isEmpty()) {
+        socket_path = dir + QStringLiteral("/como-metrics");
+    }
+
+    if (socket_path.isEmpty()) {
+        return;
+    }
+
+    auto const path = QFile::encodeName(socket_path);
+    sockaddr_un address;
+    if (!set_address(address, path)) {
+        qCWarning(KWIN_CORE) << "Metrics socket path too long:" << socket_path;
+        return;
+    }
+
+    if (is_in_use(address)) {
+        qCWarning(KWIN_CORE) << "Metrics socket" << socket_path << "is used by another process";
+        return;
+    }
+
+    // Remove a stale socket of a previous session.
+    unlink(path.constData());
+
+    socket_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (socket_fd == -1) {
+        qCWarning(KWIN_CORE) << "Failed to create metrics socket:" << strerror(errno);
+        return;
+    }
+
+    if (bind(socket_fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) == -1
+        || chmod(path.constData(), S_IRUSR | S_IWUSR) == -1 || ::listen(socket_fd, 4) == -1) {
+        qCWarning(KWIN_CORE) << "Failed to listen on metrics socket" << socket_path << ":"
+                             << strerror(errno);
+        close(socket_fd);
+        socket_fd = -1;
+        return;
+    }
+
+    notifier = std::make_unique<QSocketNotifier>(socket_fd, QSocketNotifier::Read);
+    QObject::connect(notifier.get(), &QSocketNotifier::activated, this, [this] { accept(); });
+}
+
+void metrics_service::accept()
+{
+    while (true) {
+        int client = accept4(socket_fd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (client == -1) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                qCWarning(KWIN_CORE) << "Failed to accept metrics client:" << strerror(errno);
+            }
+            return;
+        }
+
+        auto const text = metrics_registry::instance().prometheus();
+        qsizetype written{0};
+
+        // The text fits into the socket buffer. Clients not reading it are not waited for.
+        while (written < text.size()) {
+            auto const count = send(
+                client, text.constData() + written, text.size() - written, MSG_NOSIGNAL);
+            if (count <= 0) {
+                if (count == -1 && errno == EINTR) {
+                    continue;
+                }
+                qCDebug(KWIN_CORE) << "Could not send metrics to client";
+                break;
+            }
+            written += count;
+        }
+
+        close(client);
+    }
+}
+
+}
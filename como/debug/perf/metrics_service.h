@@ -0,0 +1,53 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "como_export.h"
+
+#include <QObject>
+#include <QString>
+#include <memory>
+
+class QSocketNotifier;
+
+namespace como::debug
+{
+
+/**
+ * Exports the metrics registry on D-Bus and on a UNIX socket.
+ *
+ * The D-Bus interface org.kde.KWin.Metrics is on /Metrics. The socket is created in the runtime
+ * directory with the name como-metrics, or at the path set with KWIN_METRICS_SOCKET. Setting that
+ * variable to an empty value disables the socket. Every client connecting to it receives the
+ * metrics in the Prometheus text exposition format and is disconnected afterwards, for example:
+ *
+ *     socat - UNIX-CONNECT:$XDG_RUNTIME_DIR/como-metrics
+ */
+class COMO_EXPORT metrics_service : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.KWin.Metrics")
+
+public:
+    metrics_service();
+    ~metrics_service() override;
+
+public Q_SLOTS:
+    /**
+     * All metrics in the Prometheus text exposition format.
+     */
+    Q_SCRIPTABLE QString metrics() const;
+
+private:
+    void listen();
+    void accept();
+
+    int socket_fd{-1};
+    QString socket_path;
+    std::unique_ptr<QSocketNotifier> notifier;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <QMetaType>
 #include <QPointF>
 #include <cstdint>
+#include <vector>
 
 namespace como::input
 {
@@ -49,10 +50,19 @@ struct button_event {
     event<pointer> base;
 };
 
+struct motion_sample {
+    QPointF delta;
+    QPointF unaccel_delta;
+    uint32_t time_msec;
+};
+
 struct motion_event {
     QPointF delta;
     QPointF unaccel_delta;
     event<pointer> base;
+
+    // Set when multiple motions were coalesced into this event. The deltas above are their sums.
+    std::vector<motion_sample> samples;
 };
 
 struct motion_absolute_event {
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "event.h"
+#include "event_kind.h"
 
 #include <QSet>
 #include <QTabletEvent>
@@ -15,8 +16,8 @@ namespace como::input
 {
 
 /**
- * Sends an event through all InputFilters.
- * The method @p function is invoked on each input filter. Processing is stopped if
+ * Sends an event through all InputFilters handling the event @p kind.
+ * The method @p function is invoked on each of these input filters. Processing is stopped if
  * a filter returns @c true for @p function.
  *
  * The UnaryPredicate is defined like the UnaryPredicate of std::any_of.
@@ -29,9 +30,17 @@ namespace como::input
  * bind.
  */
 template<typename Filters, typename UnaryPredicate>
-void process_filters(Filters const& filters, UnaryPredicate function)
+void process_filters(Filters const& filters, event_kind kind, UnaryPredicate function)
 {
-    static_cast<void>(std::any_of(filters.cbegin(), filters.cend(), function));
+    for (auto filter : filters) {
+        if (flags(filter->handled).none_of(kind)) {
+            continue;
+        }
+        filter->dispatch_count++;
+        if (function(filter)) {
+            return;
+        }
+    }
 }
 
 /**
@@ -50,6 +59,9 @@ void process_filters(Filters const& filters, UnaryPredicate function)
  * a filter returns @c false the next one is invoked. This means a filter
  * installed early gets to see more events than a filter installed later on.
  *
+ * A filter is only called for the event kinds it declares as handled on construction. In-tree
+ * filters pass event_filter_kinds() to handle exactly the events of the methods they override.
+ *
  * Deleting an instance of event_filter automatically uninstalls it from
  * InputRedirection.
  */
@@ -57,8 +69,9 @@ template<typename Redirect>
 class event_filter
 {
 public:
-    explicit event_filter(Redirect& redirect)
+    explicit event_filter(Redirect& redirect, event_kind handled = event_kind::all)
         : redirect{redirect}
+        , handled{handled}
     {
     }
 
@@ -187,6 +200,47 @@ public:
     }
 
     Redirect& redirect;
+
+    event_kind const handled;
+    // Number of events the filter was called for.
+    uint64_t dispatch_count{0};
 };
 
+/**
+ * The event kinds of the methods the filter type @p Filter overrides.
+ */
+template<typename Filter>
+constexpr event_kind event_filter_kinds()
+{
+    auto overridden = [](auto handler, event_kind kind) {
+        return overridden_kind<event_filter>(handler, kind);
+    };
+
+    return static_cast<event_kind>(
+        overridden(&Filter::button, event_kind::button)
+        | overridden(&Filter::motion, event_kind::motion)
+        | overridden(&Filter::axis, event_kind::axis)
+        | overridden(&Filter::key, event_kind::key)
+        | overridden(&Filter::key_repeat, event_kind::key_repeat)
+        | overridden(&Filter::touch_down, event_kind::touch_down)
+        | overridden(&Filter::touch_motion, event_kind::touch_motion)
+        | overridden(&Filter::touch_up, event_kind::touch_up)
+        | overridden(&Filter::touch_cancel, event_kind::touch_cancel)
+        | overridden(&Filter::touch_frame, event_kind::touch_frame)
+        | overridden(&Filter::pinch_begin, event_kind::pinch_begin)
+        | overridden(&Filter::pinch_update, event_kind::pinch_update)
+        | overridden(&Filter::pinch_end, event_kind::pinch_end)
+        | overridden(&Filter::swipe_begin, event_kind::swipe_begin)
+        | overridden(&Filter::swipe_update, event_kind::swipe_update)
+        | overridden(&Filter::swipe_end, event_kind::swipe_end)
+        | overridden(&Filter::hold_begin, event_kind::hold_begin)
+        | overridden(&Filter::hold_end, event_kind::hold_end)
+        | overridden(&Filter::switch_toggle, event_kind::switch_toggle)
+        | overridden(&Filter::tabletToolEvent, event_kind::tablet_tool)
+        | overridden(&Filter::tabletToolButtonEvent, event_kind::tablet_tool_button)
+        | overridden(&Filter::tabletPadButtonEvent, event_kind::tablet_pad_button)
+        | overridden(&Filter::tabletPadStripEvent, event_kind::tablet_pad_strip)
+        | overridden(&Filter::tabletPadRingEvent, event_kind::tablet_pad_ring));
+}
+
 }
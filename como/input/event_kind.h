@@ -0,0 +1,90 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/utils/flags.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace como::input
+{
+
+/**
+ * Kinds of input events dispatched to filters and spies. Filters and spies declare the kinds they
+ * handle, so they are not called for any other.
+ */
+enum class event_kind : uint32_t {
+    none = 0,
+    button = 1 << 0,
+    motion = 1 << 1,
+    axis = 1 << 2,
+    key = 1 << 3,
+    key_repeat = 1 << 4,
+    touch_down = 1 << 5,
+    touch_motion = 1 << 6,
+    touch_up = 1 << 7,
+    touch_cancel = 1 << 8,
+    touch_frame = 1 << 9,
+    pinch_begin = 1 << 10,
+    pinch_update = 1 << 11,
+    pinch_end = 1 << 12,
+    swipe_begin = 1 << 13,
+    swipe_update = 1 << 14,
+    swipe_end = 1 << 15,
+    hold_begin = 1 << 16,
+    hold_end = 1 << 17,
+    switch_toggle = 1 << 18,
+    tablet_tool = 1 << 19,
+    tablet_tool_button = 1 << 20,
+    tablet_pad_button = 1 << 21,
+    tablet_pad_strip = 1 << 22,
+    tablet_pad_ring = 1 << 23,
+
+    pointer = button | motion | axis,
+    keyboard = key | key_repeat,
+    touch_point = touch_down | touch_motion | touch_up,
+    touch = touch_point | touch_cancel | touch_frame,
+    pinch = pinch_begin | pinch_update | pinch_end,
+    swipe = swipe_begin | swipe_update | swipe_end,
+    hold = hold_begin | hold_end,
+    gesture = pinch | swipe | hold,
+    tablet = tablet_tool | tablet_tool_button | tablet_pad_button | tablet_pad_strip
+        | tablet_pad_ring,
+    all = 0xffffffff,
+};
+
+template<typename Handler>
+struct handler_class;
+
+template<typename Class, typename Handler>
+struct handler_class<Handler Class::*> {
+    using type = Class;
+};
+
+template<template<typename> class Receiver, typename Class>
+struct is_receiver_base : std::false_type {
+};
+
+template<template<typename> class Receiver, typename Redirect>
+struct is_receiver_base<Receiver, Receiver<Redirect>> : std::true_type {
+};
+
+/**
+ * Returns @p kind as bit mask if the @p handler of a filter or spy is declared by another class
+ * than the receiver base class template @p Receiver, that means if it is overridden. Taking the
+ * address of an inherited member gives a pointer to a member of the base class.
+ */
+template<template<typename> class Receiver, typename Handler>
+constexpr uint32_t overridden_kind(Handler /*handler*/, event_kind kind)
+{
+    using owner = typename handler_class<Handler>::type;
+    return is_receiver_base<Receiver, owner>::value ? 0 : static_cast<uint32_t>(kind);
+}
+
+}
+
+ENUM_FLAGS(como::input::event_kind)
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "event.h"
+#include "event_kind.h"
 
 #include <como/utils/algorithm.h>
 
@@ -18,8 +19,8 @@ namespace como::input
 {
 
 /**
- * Sends an event through all input event spies.
- * The @p function is invoked on each event_spy.
+ * Sends an event through all input event spies handling the event @p kind.
+ * The @p function is invoked on each of these event spies.
  *
  * The UnaryFunction is defined like the UnaryFunction of std::for_each.
  * The signature of the function should be equivalent to the following:
@@ -31,9 +32,14 @@ namespace como::input
  * bind.
  */
 template<typename Spies, typename UnaryFunction>
-void process_spies(Spies const& spies, UnaryFunction function)
+void process_spies(Spies const& spies, event_kind kind, UnaryFunction function)
 {
-    std::for_each(spies.cbegin(), spies.cend(), function);
+    for (auto spy : spies) {
+        if (flags(spy->handled).any_of(kind)) {
+            spy->dispatch_count++;
+            function(spy);
+        }
+    }
 }
 
 /**
@@ -43,6 +49,9 @@ void process_spies(Spies const& spies, UnaryFunction function)
  * support event filtering. Each event_spy gets to see all input events,
  * the processing happens prior to sending events through the InputEventFilters.
  *
+ * A spy is only called for the event kinds it declares as handled on construction. In-tree spies
+ * pass event_spy_kinds() to handle exactly the events of the methods they override.
+ *
  * Deleting an instance of event_spy automatically uninstalls it from
  * InputRedirection.
  */
@@ -52,8 +61,9 @@ class event_spy
 public:
     using motion_event_t = input::motion_event;
 
-    event_spy(Redirect& redirect)
+    event_spy(Redirect& redirect, event_kind handled = event_kind::all)
         : redirect{redirect}
+        , handled{handled}
     {
     }
 
@@ -151,6 +161,45 @@ public:
     }
 
     Redirect& redirect;
+
+    event_kind const handled;
+    // Number of events the spy was called for.
+    uint64_t dispatch_count{0};
 };
 
+/**
+ * The event kinds of the methods the spy type @p Spy overrides.
+ */
+template<typename Spy>
+constexpr event_kind event_spy_kinds()
+{
+    auto overridden = [](auto handler, event_kind kind) {
+        return overridden_kind<event_spy>(handler, kind);
+    };
+
+    return static_cast<event_kind>(
+        overridden(&Spy::button, event_kind::button)
+        | overridden(&Spy::motion, event_kind::motion)
+        | overridden(&Spy::axis, event_kind::axis)
+        | overridden(&Spy::key, event_kind::key)
+        | overridden(&Spy::key_repeat, event_kind::key_repeat)
+        | overridden(&Spy::touch_down, event_kind::touch_down)
+        | overridden(&Spy::touch_motion, event_kind::touch_motion)
+        | overridden(&Spy::touch_up, event_kind::touch_up)
+        | overridden(&Spy::pinch_begin, event_kind::pinch_begin)
+        | overridden(&Spy::pinch_update, event_kind::pinch_update)
+        | overridden(&Spy::pinch_end, event_kind::pinch_end)
+        | overridden(&Spy::swipe_begin, event_kind::swipe_begin)
+        | overridden(&Spy::swipe_update, event_kind::swipe_update)
+        | overridden(&Spy::swipe_end, event_kind::swipe_end)
+        | overridden(&Spy::hold_begin, event_kind::hold_begin)
+        | overridden(&Spy::hold_end, event_kind::hold_end)
+        | overridden(&Spy::switch_toggle, event_kind::switch_toggle)
+        | overridden(&Spy::tabletToolEvent, event_kind::tablet_tool)
+        | overridden(&Spy::tabletToolButtonEvent, event_kind::tablet_tool_button)
+        | overridden(&Spy::tabletPadButtonEvent, event_kind::tablet_pad_button)
+        | overridden(&Spy::tabletPadStripEvent, event_kind::tablet_pad_strip)
+        | overridden(&Spy::tabletPadRingEvent, event_kind::tablet_pad_ring));
+}
+
 }
@@ -28,7 +28,7 @@ class decoration_event_filter : public event_filter<Redirect>
 {
 public:
     explicit decoration_event_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<decoration_event_filter>())
     {
     }
 
@@ -26,7 +26,7 @@ class dpms_filter : public event_filter<Redirect>
 {
 public:
     explicit dpms_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<dpms_filter>())
         , redirect{redirect}
     {
     }
@@ -24,7 +24,7 @@ class drag_and_drop_filter : public event_filter<Redirect>
 {
 public:
     explicit drag_and_drop_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<drag_and_drop_filter>())
     {
     }
 
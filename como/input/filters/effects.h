@@ -21,7 +21,7 @@ class effects_filter : public event_filter<Redirect>
 {
 public:
     explicit effects_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<effects_filter>())
     {
     }
 
@@ -29,7 +29,7 @@ class forward_filter : public event_filter<Redirect>
 {
 public:
     explicit forward_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<forward_filter>())
     {
     }
 
@@ -65,7 +65,16 @@ public:
         seat->setTimestamp(event.base.time_msec);
 
         seat->pointers().set_position(this->redirect.pointer->pos());
-        if (!event.delta.isNull()) {
+
+        if (!event.samples.empty()) {
+            // Coalesced motion. Relative pointer clients still receive every motion.
+            for (auto const& sample : event.samples) {
+                seat->pointers().relative_motion(
+                    QSizeF(sample.delta.x(), sample.delta.y()),
+                    QSizeF(sample.unaccel_delta.x(), sample.unaccel_delta.y()),
+                    sample.time_msec);
+            }
+        } else if (!event.delta.isNull()) {
             seat->pointers().relative_motion(
                 QSizeF(event.delta.x(), event.delta.y()),
                 QSizeF(event.unaccel_delta.x(), event.unaccel_delta.y()),
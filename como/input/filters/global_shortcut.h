@@ -24,7 +24,7 @@ class global_shortcut_filter : public event_filter<Redirect>
 {
 public:
     explicit global_shortcut_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<global_shortcut_filter>())
     {
         m_powerDown = new QTimer;
         m_powerDown->setSingleShot(true);
@@ -208,6 +208,7 @@ public:
                 m_gestureTaken = true;
                 process_filters(
                     this->redirect.m_filters,
+                    event_kind::touch_cancel,
                     std::bind(&event_filter<Redirect>::touch_cancel, std::placeholders::_1));
                 this->redirect.platform.shortcuts->processSwipeStart(
                     win::input_device_type::touchscreen, m_touchPoints.count());
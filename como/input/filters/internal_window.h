@@ -30,7 +30,7 @@ public:
     using internal_window_t = typename Redirect::space_t::internal_window_t;
 
     explicit internal_window_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<internal_window_filter>())
     {
     }
 
@@ -28,7 +28,7 @@ class lock_screen_filter : public event_filter<Redirect>
 {
 public:
     explicit lock_screen_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<lock_screen_filter>())
     {
     }
 
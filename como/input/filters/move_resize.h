@@ -22,7 +22,7 @@ class move_resize_filter : public event_filter<Redirect>
 {
 public:
     explicit move_resize_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<move_resize_filter>())
     {
     }
 
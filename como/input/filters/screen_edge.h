@@ -21,7 +21,7 @@ class screen_edge_filter : public event_filter<Redirect>
 {
 public:
     explicit screen_edge_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<screen_edge_filter>())
     {
     }
 
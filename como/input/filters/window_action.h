@@ -28,7 +28,7 @@ class window_action_filter : public event_filter<Redirect>
 {
 public:
     explicit window_action_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<window_action_filter>())
     {
     }
 
@@ -28,7 +28,7 @@ class window_selector_filter : public event_filter<Redirect>
 {
 public:
     explicit window_selector_filter(Redirect& redirect)
-        : event_filter<Redirect>(redirect)
+        : event_filter<Redirect>(redirect, event_filter_kinds<window_selector_filter>())
     {
     }
 
@@ -22,6 +22,7 @@ void keyboard_redirect_prepare_key(Keyboard& keys, key_event const& event)
 {
     event.base.dev->xkb->update_key(event.keycode, event.state);
     process_spies(keys.redirect->m_spies,
+                  event_kind::key,
                   std::bind(&event_spy<Redirect>::key, std::placeholders::_1, event));
 }
 
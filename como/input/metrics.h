@@ -0,0 +1,90 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "event.h"
+
+#include <como/debug/perf/metrics.h>
+
+#include <chrono>
+#include <type_traits>
+
+namespace como::input
+{
+
+/**
+ * Performance metrics of processing input events.
+ */
+struct input_metrics {
+    input_metrics()
+        : input_metrics(debug::metrics_registry::instance())
+    {
+    }
+
+    template<typename Event>
+    void record(std::chrono::nanoseconds duration)
+    {
+        if constexpr (is_any_of<Event,
+                                button_event,
+                                motion_event,
+                                motion_absolute_event,
+                                axis_event>) {
+            pointer.add();
+        } else if constexpr (is_any_of<Event,
+                                       swipe_begin_event,
+                                       swipe_update_event,
+                                       swipe_end_event,
+                                       pinch_begin_event,
+                                       pinch_update_event,
+                                       pinch_end_event,
+                                       hold_begin_event,
+                                       hold_end_event>) {
+            gesture.add();
+        } else if constexpr (std::is_same_v<Event, key_event>) {
+            keyboard.add();
+        } else if constexpr (is_any_of<Event,
+                                       touch_down_event,
+                                       touch_up_event,
+                                       touch_motion_event>) {
+            touch.add();
+        } else {
+            static_assert(!sizeof(Event), "No counter for the event type");
+        }
+        processing.observe(duration);
+    }
+
+    debug::metric_counter& pointer;
+    debug::metric_counter& gesture;
+    debug::metric_counter& keyboard;
+    debug::metric_counter& touch;
+    debug::metric_histogram& processing;
+
+private:
+    template<typename Event, typename... Events>
+    static constexpr bool is_any_of = (std::is_same_v<Event, Events> || ...);
+
+    explicit input_metrics(debug::metrics_registry& registry)
+        : pointer{counter(registry, QStringLiteral("pointer"))}
+        , gesture{counter(registry, QStringLiteral("gesture"))}
+        , keyboard{counter(registry, QStringLiteral("keyboard"))}
+        , touch{counter(registry, QStringLiteral("touch"))}
+        , processing{registry.histogram(
+              QStringLiteral("como_input_processing_seconds"),
+              QStringLiteral("Time for processing an input event in filters, spies and clients."),
+              debug::metric_histogram::frame_bounds())}
+    {
+    }
+
+    static debug::metric_counter& counter(debug::metrics_registry& registry,
+                                          QString const& device)
+    {
+        return registry.counter(QStringLiteral("como_input_events_total"),
+                                QStringLiteral("Processed input events."),
+                                {{QStringLiteral("device"), device}});
+    }
+};
+
+}
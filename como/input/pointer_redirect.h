@@ -19,6 +19,7 @@ void pointer_redirect_process_button_spies(Pointer& ptr, button_event const& eve
 {
     using redirect_t = std::remove_pointer_t<decltype(ptr.redirect)>;
     process_spies(ptr.redirect->m_spies,
+                  event_kind::button,
                   std::bind(&event_spy<redirect_t>::button, std::placeholders::_1, event));
 }
 
@@ -15,7 +15,7 @@ class activity_spy : public event_spy<Redirect>
 {
 public:
     explicit activity_spy(Redirect& redirect)
-        : event_spy<Redirect>(redirect)
+        : event_spy<Redirect>(redirect, event_spy_kinds<activity_spy>())
     {
     }
 
@@ -33,7 +33,7 @@ class modifier_only_shortcuts_spy : public event_spy<Redirect>
 {
 public:
     explicit modifier_only_shortcuts_spy(Redirect& redirect)
-        : event_spy<Redirect>(redirect)
+        : event_spy<Redirect>(redirect, event_spy_kinds<modifier_only_shortcuts_spy>())
         , qobject{std::make_unique<modifier_only_shortcuts_spy_qobject>()}
     {
         QObject::connect(redirect.space.qobject.get(),
@@ -17,7 +17,7 @@ class tablet_mode_switch_spy : public input::event_spy<Redirect>
 {
 public:
     tablet_mode_switch_spy(Redirect& redirect, Manager& manager)
-        : event_spy<Redirect>(redirect)
+        : event_spy<Redirect>(redirect, event_spy_kinds<tablet_mode_switch_spy>())
         , manager(manager)
     {
     }
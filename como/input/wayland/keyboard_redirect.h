@@ -25,7 +25,7 @@ class key_state_changed_spy : public event_spy<Redirect>
 {
 public:
     key_state_changed_spy(Redirect& redirect)
-        : event_spy<Redirect>(redirect)
+        : event_spy<Redirect>(redirect, event_spy_kinds<key_state_changed_spy>())
     {
     }
 
@@ -40,7 +40,7 @@ class modifiers_changed_spy : public event_spy<Redirect>
 {
 public:
     modifiers_changed_spy(Redirect& redirect)
-        : event_spy<Redirect>(redirect)
+        : event_spy<Redirect>(redirect, event_spy_kinds<modifiers_changed_spy>())
         , m_modifiers()
     {
     }
@@ -197,6 +197,7 @@ public:
         keyboard_redirect_prepare_key<Redirect>(*this, event);
 
         process_filters(redirect->m_filters,
+                        event_kind::key,
                         std::bind(&event_filter<Redirect>::key, std::placeholders::_1, event));
         xkb->forward_modifiers();
     }
@@ -204,9 +205,11 @@ public:
     void process_key_repeat(key_event const& event)
     {
         process_spies(redirect->m_spies,
+                      event_kind::key_repeat,
                       std::bind(&event_spy<Redirect>::key_repeat, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::key_repeat,
             std::bind(&event_filter<Redirect>::key_repeat, std::placeholders::_1, event));
     }
 
@@ -5,13 +5,25 @@
 */
 #pragma once
 
+#include <como/input/event.h>
+
 #include <QPointF>
+#include <QTimer>
 #include <cstdint>
 #include <deque>
+#include <optional>
 
 namespace como::input::wayland
 {
 
+/**
+ * Defers motions while the device is processing an event and optionally coalesces motions until
+ * the next frame.
+ *
+ * With coalescing the position update, focus search and client motion happen once per frame
+ * instead of once per device event. Coalescing is flushed on about_to_paint of an output or after
+ * one refresh cycle of the output the device is on, whatever comes first.
+ */
 template<typename Device>
 class motion_scheduler
 {
@@ -19,6 +31,9 @@ public:
     motion_scheduler(Device& device)
         : device{device}
     {
+        flush_timer.setSingleShot(true);
+        flush_timer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&flush_timer, &QTimer::timeout, &flush_timer, [this] { flush(); });
     }
 
     void lock()
@@ -61,6 +76,89 @@ public:
         motions.emplace_back(position{{}, delta, unaccel_delta, time, false});
     }
 
+    void set_coalescing(bool enable)
+    {
+        if (!enable) {
+            flush();
+        }
+        coalescing = enable;
+    }
+
+    /**
+     * Adds the motion to the coalesced one. Returns false if the motion must be processed now.
+     */
+    bool coalesce(motion_event const& event)
+    {
+        if (!coalescing || flushing) {
+            return false;
+        }
+        if (pending && pending->abs) {
+            flush();
+        }
+        if (!pending) {
+            pending = coalesced{};
+            start_flush_timer();
+        }
+
+        auto& motion = pending->relative;
+        motion.delta += event.delta;
+        motion.unaccel_delta += event.unaccel_delta;
+        motion.base = event.base;
+
+        if (event.samples.empty()) {
+            motion.samples.push_back({event.delta, event.unaccel_delta, event.base.time_msec});
+        } else {
+            motion.samples.insert(motion.samples.end(), event.samples.begin(), event.samples.end());
+        }
+        return true;
+    }
+
+    bool coalesce(motion_absolute_event const& event)
+    {
+        if (!coalescing || flushing) {
+            return false;
+        }
+        if (pending && !pending->abs) {
+            flush();
+        }
+        if (!pending) {
+            pending = coalesced{};
+            pending->abs = true;
+            start_flush_timer();
+        }
+
+        // Only the last absolute position is of interest.
+        pending->absolute = event;
+        return true;
+    }
+
+    /**
+     * Processes the coalesced motion. Must be called before any other event of the device is
+     * processed to retain the order of events.
+     */
+    void flush()
+    {
+        flush_timer.stop();
+
+        if (!pending) {
+            return;
+        }
+
+        auto const motion = std::move(*pending);
+        pending.reset();
+
+        flushing = true;
+        if (motion.abs) {
+            device.process_motion_absolute(motion.absolute);
+        } else if (motion.relative.samples.size() == 1) {
+            device.process_motion(
+                {motion.relative.delta, motion.relative.unaccel_delta, motion.relative.base});
+        } else {
+            device.process_motion(motion.relative);
+        }
+        flushing = false;
+    }
+
 private:
     struct position {
         QPointF pos;
@@ -70,8 +168,25 @@ private:
         bool abs;
     };
 
+    struct coalesced {
+        bool abs{false};
+        motion_event relative;
+        motion_absolute_event absolute;
+    };
+
+    void start_flush_timer()
+    {
+        flush_timer.start(device.frame_interval());
+    }
+
     std::deque<position> motions;
     int locked{0};
+
+    bool coalescing{false};
+    bool flushing{false};
+    std::optional<coalesced> pending;
+    QTimer flush_timer;
+
     Device& device;
 };
 
@@ -129,6 +129,29 @@ public:
                          &win::space_qobject::wayland_window_added,
                          qobject.get(),
                          setup_move_resize_notify_on_signal);
+
+        // Opt-in since it delays motions by up to one frame when nothing else is painted.
+        if (qEnvironmentVariableIntValue("KWIN_INPUT_COALESCE_MOTION") == 1) {
+            init_motion_coalescing();
+        }
+    }
+
+    /**
+     * Refresh cycle of the output the pointer is on. Coalesced motions are flushed latest after
+     * that time.
+     */
+    std::chrono::milliseconds frame_interval() const
+    {
+        auto const& outputs = redirect->platform.base.outputs;
+        if (outputs.empty()) {
+            return std::chrono::milliseconds(16);
+        }
+
+        auto output = base::get_nearest_output(outputs, m_pos.toPoint());
+
+        // Refresh rate is in mHz.
+        auto const refresh = std::max(output->refresh_rate(), 1000);
+        return std::chrono::milliseconds(std::max(1000 * 1000 / refresh, 1));
     }
 
     void updateAfterScreenChange()
@@ -381,6 +404,9 @@ public:
             motions.schedule(event.delta, event.unaccel_delta, event.base.time_msec);
             return;
         }
+        if (event.base.dev && motions.coalesce(event)) {
+            return;
+        }
 
         blocker block(&motions);
 
@@ -389,8 +415,10 @@ public:
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::motion,
                       std::bind(&event_spy<Redirect>::motion, std::placeholders::_1, event));
         process_filters(redirect->m_filters,
+                        event_kind::motion,
                         std::bind(&event_filter<Redirect>::motion, std::placeholders::_1, event));
 
         process_frame();
@@ -402,6 +430,9 @@ public:
             motions.schedule(event.pos, event.base.time_msec);
             return;
         }
+        if (event.base.dev && motions.coalesce(event)) {
+            return;
+        }
 
         auto const& space_size = redirect->platform.base.topology.size;
         auto const pos
@@ -414,9 +445,11 @@ public:
         auto motion_ev = motion_event({{}, {}, event.base});
 
         process_spies(redirect->m_spies,
+                      event_kind::motion,
                       std::bind(&event_spy<Redirect>::motion, std::placeholders::_1, motion_ev));
         process_filters(
             redirect->m_filters,
+            event_kind::motion,
             std::bind(&event_filter<Redirect>::motion, std::placeholders::_1, motion_ev));
 
         process_frame();
@@ -424,6 +457,8 @@ public:
 
     void processMotion(QPointF const& pos, uint32_t time, input::pointer* device = nullptr)
     {
+        motions.flush();
+
         // Events for motion_absolute_event have positioning relative to screen size.
         auto const& space_size = redirect->platform.base.topology.size;
         auto const rel_pos = QPointF(pos.x() / space_size.width(), pos.y() / space_size.height());
@@ -434,6 +469,8 @@ public:
 
     void process_button(button_event const& event)
     {
+        motions.flush();
+
         if (event.state == button_state::pressed) {
             // Check focus before processing spies/filters.
             device_redirect_update(this);
@@ -442,6 +479,7 @@ public:
         update_button(event);
         pointer_redirect_process_button_spies(*this, event);
         process_filters(redirect->m_filters,
+                        event_kind::button,
                         std::bind(&event_filter<Redirect>::button, std::placeholders::_1, event));
 
         if (event.state == button_state::released) {
@@ -454,11 +492,15 @@ public:
 
     void process_axis(axis_event const& event)
     {
+        motions.flush();
+
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::axis,
                       std::bind(&event_spy<Redirect>::axis, std::placeholders::_1, event));
         process_filters(redirect->m_filters,
+                        event_kind::axis,
                         std::bind(&event_filter<Redirect>::axis, std::placeholders::_1, event));
 
         process_frame();
@@ -466,10 +508,14 @@ public:
 
     void process_swipe_begin(swipe_begin_event const& event)
     {
+        motions.flush();
+
         process_spies(redirect->m_spies,
+                      event_kind::swipe_begin,
                       std::bind(&event_spy<Redirect>::swipe_begin, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::swipe_begin,
             std::bind(&event_filter<Redirect>::swipe_begin, std::placeholders::_1, event));
     }
 
@@ -478,9 +524,11 @@ public:
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::swipe_update,
                       std::bind(&event_spy<Redirect>::swipe_update, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::swipe_update,
             std::bind(&event_filter<Redirect>::swipe_update, std::placeholders::_1, event));
     }
 
@@ -489,20 +537,26 @@ public:
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::swipe_end,
                       std::bind(&event_spy<Redirect>::swipe_end, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::swipe_end,
             std::bind(&event_filter<Redirect>::swipe_end, std::placeholders::_1, event));
     }
 
     void process_pinch_begin(pinch_begin_event const& event)
     {
+        motions.flush();
+
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::pinch_begin,
                       std::bind(&event_spy<Redirect>::pinch_begin, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::pinch_begin,
             std::bind(&event_filter<Redirect>::pinch_begin, std::placeholders::_1, event));
     }
 
@@ -511,9 +565,11 @@ public:
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::pinch_update,
                       std::bind(&event_spy<Redirect>::pinch_update, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::pinch_update,
             std::bind(&event_filter<Redirect>::pinch_update, std::placeholders::_1, event));
     }
 
@@ -522,20 +578,26 @@ public:
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::pinch_end,
                       std::bind(&event_spy<Redirect>::pinch_end, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::pinch_end,
             std::bind(&event_filter<Redirect>::pinch_end, std::placeholders::_1, event));
     }
 
     void process_hold_begin(hold_begin_event const& event)
     {
+        motions.flush();
+
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::hold_begin,
                       std::bind(&event_spy<Redirect>::hold_begin, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::hold_begin,
             std::bind(&event_filter<Redirect>::hold_begin, std::placeholders::_1, event));
     }
 
@@ -544,8 +606,10 @@ public:
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
+                      event_kind::hold_end,
                       std::bind(&event_spy<Redirect>::hold_end, std::placeholders::_1, event));
         process_filters(redirect->m_filters,
+                        event_kind::hold_end,
                         std::bind(&event_filter<Redirect>::hold_end, std::placeholders::_1, event));
     }
 
@@ -837,6 +901,26 @@ private:
         redirect->platform.base.server->seat()->pointers().set_focused_surface(nullptr);
     }
 
+    void init_motion_coalescing()
+    {
+        auto connect_output = [this](auto output) {
+            QObject::connect(output->qobject.get(),
+                             &base::output_qobject::about_to_paint,
+                             qobject.get(),
+                             [this] { motions.flush(); });
+        };
+
+        for (auto output : redirect->platform.base.outputs) {
+            connect_output(output);
+        }
+        QObject::connect(redirect->platform.base.qobject.get(),
+                         &base::platform_qobject::output_added,
+                         qobject.get(),
+                         connect_output);
+
+        motions.set_coalescing(true);
+    }
+
     void update_position(QPointF pos)
     {
         auto confineToBoundingBox = [](QPointF const& pos, QRectF const& boundingBox) {
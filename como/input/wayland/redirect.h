@@ -33,6 +33,7 @@
 #include <como/input/filters/virtual_terminal.h>
 #include <como/input/filters/window_action.h>
 #include <como/input/filters/window_selector.h>
+#include <como/input/metrics.h>
 #include <como/input/redirect_qobject.h>
 #include <como/input/spies/activity.h>
 #include <como/input/spies/touch_hide_cursor.h>
@@ -45,6 +46,7 @@
 #include <Wrapland/Server/seat.h>
 #include <Wrapland/Server/touch_pool.h>
 #include <Wrapland/Server/virtual_keyboard_v1.h>
+#include <chrono>
 #include <unordered_map>
 
 namespace como::input::wayland
@@ -410,65 +412,83 @@ private:
         QObject::connect(pointer,
                          &pointer::button_changed,
                          pointer_red->qobject.get(),
-                         [pointer_red](auto const& event) { pointer_red->process_button(event); });
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_button(event); });
+                         });
 
         QObject::connect(pointer,
                          &pointer::motion,
                          pointer_red->qobject.get(),
-                         [pointer_red](auto const& event) { pointer_red->process_motion(event); });
-        QObject::connect(
-            pointer,
-            &pointer::motion_absolute,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_motion_absolute(event); });
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_motion(event); });
+                         });
+        QObject::connect(pointer,
+                         &pointer::motion_absolute,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(
+                                 event, [&] { pointer_red->process_motion_absolute(event); });
+                         });
 
         QObject::connect(pointer,
                          &pointer::axis_changed,
                          pointer_red->qobject.get(),
-                         [pointer_red](auto const& event) { pointer_red->process_axis(event); });
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_axis(event); });
+                         });
 
-        QObject::connect(
-            pointer,
-            &pointer::pinch_begin,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_pinch_begin(event); });
-        QObject::connect(
-            pointer,
-            &pointer::pinch_update,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_pinch_update(event); });
-        QObject::connect(
-            pointer,
-            &pointer::pinch_end,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_pinch_end(event); });
+        QObject::connect(pointer,
+                         &pointer::pinch_begin,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_pinch_begin(event); });
+                         });
+        QObject::connect(pointer,
+                         &pointer::pinch_update,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(
+                                 event, [&] { pointer_red->process_pinch_update(event); });
+                         });
+        QObject::connect(pointer,
+                         &pointer::pinch_end,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_pinch_end(event); });
+                         });
 
-        QObject::connect(
-            pointer,
-            &pointer::swipe_begin,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_swipe_begin(event); });
-        QObject::connect(
-            pointer,
-            &pointer::swipe_update,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_swipe_update(event); });
-        QObject::connect(
-            pointer,
-            &pointer::swipe_end,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_swipe_end(event); });
+        QObject::connect(pointer,
+                         &pointer::swipe_begin,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_swipe_begin(event); });
+                         });
+        QObject::connect(pointer,
+                         &pointer::swipe_update,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(
+                                 event, [&] { pointer_red->process_swipe_update(event); });
+                         });
+        QObject::connect(pointer,
+                         &pointer::swipe_end,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_swipe_end(event); });
+                         });
 
-        QObject::connect(
-            pointer,
-            &pointer::hold_begin,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_hold_begin(event); });
-        QObject::connect(
-            pointer,
-            &pointer::hold_end,
-            pointer_red->qobject.get(),
-            [pointer_red](auto const& event) { pointer_red->process_hold_end(event); });
+        QObject::connect(pointer,
+                         &pointer::hold_begin,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_hold_begin(event); });
+                         });
+        QObject::connect(pointer,
+                         &pointer::hold_end,
+                         pointer_red->qobject.get(),
+                         [this, pointer_red](auto const& event) {
+                             process_timed(event, [&] { pointer_red->process_hold_end(event); });
+                         });
 
         QObject::connect(pointer, &pointer::frame, pointer_red->qobject.get(), [pointer_red] {
             pointer_red->process_frame();
@@ -489,7 +509,9 @@ private:
         QObject::connect(keyboard,
                          &keyboard::key_changed,
                          keyboard_red->qobject.get(),
-                         [keyboard_red](auto const& event) { keyboard_red->process_key(event); });
+                         [this, keyboard_red](auto const& event) {
+                             process_timed(event, [&] { keyboard_red->process_key(event); });
+                         });
         QObject::connect(
             keyboard,
             &keyboard::modifiers_changed,
@@ -531,15 +553,21 @@ private:
         QObject::connect(touch->qobject.get(),
                          &touch_qobject::down,
                          touch_red->qobject.get(),
-                         [touch_red](auto const& event) { touch_red->process_down(event); });
+                         [this, touch_red](auto const& event) {
+                             process_timed(event, [&] { touch_red->process_down(event); });
+                         });
         QObject::connect(touch->qobject.get(),
                          &touch_qobject::up,
                          touch_red->qobject.get(),
-                         [touch_red](auto const& event) { touch_red->process_up(event); });
+                         [this, touch_red](auto const& event) {
+                             process_timed(event, [&] { touch_red->process_up(event); });
+                         });
         QObject::connect(touch->qobject.get(),
                          &touch_qobject::motion,
                          touch_red->qobject.get(),
-                         [touch_red](auto const& event) { touch_red->process_motion(event); });
+                         [this, touch_red](auto const& event) {
+                             process_timed(event, [&] { touch_red->process_motion(event); });
+                         });
         QObject::connect(touch->qobject.get(),
                          &touch_qobject::cancel,
                          touch_red->qobject.get(),
@@ -556,6 +584,20 @@ private:
         }
     }
 
+    /**
+     * Processes the event and records its timing for the input-to-photon latency statistics.
+     */
+    template<typename Event, typename Process>
+    void process_timed(Event const& event, Process&& process)
+    {
+        auto const begin = std::chrono::steady_clock::now().time_since_epoch();
+        process();
+        auto const end = std::chrono::steady_clock::now().time_since_epoch();
+
+        platform.base.input_latency.add(event.base.time_msec, begin, end);
+        metrics.record<Event>(end - begin);
+    }
+
     void handle_switch_added(input::switch_device* switch_device)
     {
         QObject::connect(
@@ -633,6 +675,7 @@ private:
 
     std::unique_ptr<wayland::input_method<type>> input_method;
     std::unique_ptr<dbus::tablet_mode_manager<type>> tablet_mode_manager;
+    input_metrics metrics;
     std::unique_ptr<Wrapland::Server::FakeInput> fake_input;
 
     std::unordered_map<Wrapland::Server::FakeInputDevice*, fake::devices<type>> fake_devices;
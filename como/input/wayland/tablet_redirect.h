@@ -89,9 +89,11 @@ public:
                         button);
 
         process_spies(redirect->m_spies,
+                      event_kind::tablet_tool,
                       std::bind(&event_spy<Redirect>::tabletToolEvent, std::placeholders::_1, &ev));
         process_filters(
             redirect->m_filters,
+            event_kind::tablet_tool,
             std::bind(&input::event_filter<Redirect>::tabletToolEvent, std::placeholders::_1, &ev));
 
         tip.down = tip_down;
@@ -107,10 +109,12 @@ public:
         }
 
         process_spies(redirect->m_spies,
+                      event_kind::tablet_tool_button,
                       std::bind(&event_spy<Redirect>::tabletToolButtonEvent,
                                 std::placeholders::_1,
                                 pressed_buttons.tool));
         process_filters(redirect->m_filters,
+                        event_kind::tablet_tool_button,
                         std::bind(&input::event_filter<Redirect>::tabletToolButtonEvent,
                                   std::placeholders::_1,
                                   pressed_buttons.tool));
@@ -125,10 +129,12 @@ public:
         }
 
         process_spies(redirect->m_spies,
+                      event_kind::tablet_pad_button,
                       std::bind(&event_spy<Redirect>::tabletPadButtonEvent,
                                 std::placeholders::_1,
                                 pressed_buttons.pad));
         process_filters(redirect->m_filters,
+                        event_kind::tablet_pad_button,
                         std::bind(&input::event_filter<Redirect>::tabletPadButtonEvent,
                                   std::placeholders::_1,
                                   pressed_buttons.pad));
@@ -137,12 +143,14 @@ public:
     void tabletPadStripEvent(int number, int position, bool is_finger)
     {
         process_spies(redirect->m_spies,
+                      event_kind::tablet_pad_strip,
                       std::bind(&event_spy<Redirect>::tabletPadStripEvent,
                                 std::placeholders::_1,
                                 number,
                                 position,
                                 is_finger));
         process_filters(redirect->m_filters,
+                        event_kind::tablet_pad_strip,
                         std::bind(&input::event_filter<Redirect>::tabletPadStripEvent,
                                   std::placeholders::_1,
                                   number,
@@ -153,12 +161,14 @@ public:
     void tabletPadRingEvent(int number, int position, bool is_finger)
     {
         process_spies(redirect->m_spies,
+                      event_kind::tablet_pad_ring,
                       std::bind(&event_spy<Redirect>::tabletPadRingEvent,
                                 std::placeholders::_1,
                                 number,
                                 position,
                                 is_finger));
         process_filters(redirect->m_filters,
+                        event_kind::tablet_pad_ring,
                         std::bind(&input::event_filter<Redirect>::tabletPadRingEvent,
                                   std::placeholders::_1,
                                   number,
@@ -84,8 +84,10 @@ public:
         }
         process_spies(
             redirect->m_spies,
+            event_kind::touch_down,
             std::bind(&event_spy<Redirect>::touch_down, std::placeholders::_1, event_abs));
         process_filters(redirect->m_filters,
+                        event_kind::touch_down,
                         std::bind(&input::event_filter<Redirect>::touch_down,
                                   std::placeholders::_1,
                                   event_abs));
@@ -97,9 +99,11 @@ public:
         window_already_updated_this_cycle = false;
 
         process_spies(redirect->m_spies,
+                      event_kind::touch_up,
                       std::bind(&event_spy<Redirect>::touch_up, std::placeholders::_1, event));
         process_filters(
             redirect->m_filters,
+            event_kind::touch_up,
             std::bind(&input::event_filter<Redirect>::touch_up, std::placeholders::_1, event));
 
         window_already_updated_this_cycle = false;
@@ -121,8 +125,10 @@ public:
 
         process_spies(
             redirect->m_spies,
+            event_kind::touch_motion,
             std::bind(&event_spy<Redirect>::touch_motion, std::placeholders::_1, event_abs));
         process_filters(redirect->m_filters,
+                        event_kind::touch_motion,
                         std::bind(&input::event_filter<Redirect>::touch_motion,
                                   std::placeholders::_1,
                                   event_abs));
@@ -164,6 +170,7 @@ public:
             return;
         }
         process_filters(redirect->m_filters,
+                        event_kind::touch_frame,
                         std::bind(&event_filter<Redirect>::touch_frame, std::placeholders::_1));
     }
 
@@ -9,6 +9,7 @@
 #include "options.h"
 #include "types.h"
 
+#include <como/base/startup_tracer.h>
 #include <como/win/remnant.h>
 #include <como/win/space_window_release.h>
 #include <como/win/stacking_order.h>
@@ -39,7 +40,12 @@ bool compositor_prepare_scene(Compositor& comp)
 template<typename Compositor>
 void compositor_start_scene(Compositor& comp)
 {
-    comp.scene = comp.create_scene();
+    {
+        base::startup_tracer::scope trace(
+            comp.base.startup, QStringLiteral("scene"), QStringLiteral("render"));
+        comp.scene = comp.create_scene();
+    }
+
     comp.space->stacking.order.render_restack_required = true;
 
     for (auto& win : comp.space->windows) {
@@ -47,7 +53,12 @@ void compositor_start_scene(Compositor& comp)
     }
 
     // Sets also the 'effects' pointer.
-    comp.effects = std::make_unique<typename Compositor::effects_t>(*comp.scene);
+    {
+        base::startup_tracer::scope trace(
+            comp.base.startup, QStringLiteral("effects"), QStringLiteral("render"));
+        comp.effects = std::make_unique<typename Compositor::effects_t>(*comp.scene);
+    }
+
     QObject::connect(comp.effects.get(),
                      &EffectsHandler::screenGeometryChanged,
                      comp.qobject.get(),
@@ -0,0 +1,35 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "input_latency.h"
+
+#include <QDBusConnection>
+#include <QJsonDocument>
+
+namespace como::render::dbus
+{
+
+input_latency_qobject::input_latency_qobject()
+{
+    QDBusConnection::sessionBus().registerObject(
+        QStringLiteral("/InputLatency"), this, QDBusConnection::ExportScriptableSlots);
+}
+
+input_latency_qobject::~input_latency_qobject()
+{
+    QDBusConnection::sessionBus().unregisterObject(QStringLiteral("/InputLatency"));
+}
+
+QString input_latency_qobject::report() const
+{
+    return QString::fromUtf8(QJsonDocument(integration.report()).toJson(QJsonDocument::Compact));
+}
+
+void input_latency_qobject::reset()
+{
+    integration.reset();
+}
+
+}
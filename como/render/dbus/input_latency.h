@@ -0,0 +1,68 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "como_export.h"
+
+#include <como/render/wayland/input_latency.h>
+
+#include <QJsonObject>
+#include <QObject>
+#include <functional>
+#include <memory>
+
+namespace como::render::dbus
+{
+
+struct input_latency_integration {
+    std::function<QJsonObject(void)> report;
+    std::function<void(void)> reset;
+};
+
+/**
+ * Exposes the input-to-photon latency histograms of all outputs on /InputLatency.
+ */
+class COMO_EXPORT input_latency_qobject : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.KWin.InputLatency")
+
+public:
+    input_latency_qobject();
+    ~input_latency_qobject() override;
+
+    input_latency_integration integration;
+
+public Q_SLOTS:
+    /**
+     * JSON object with the histograms of each output by output name. Durations are in
+     * microseconds.
+     */
+    Q_SCRIPTABLE QString report() const;
+    Q_SCRIPTABLE void reset();
+};
+
+template<typename Platform>
+class input_latency
+{
+public:
+    explicit input_latency(Platform& platform)
+        : qobject{std::make_unique<input_latency_qobject>()}
+        , platform{platform}
+    {
+        qobject->integration.report
+            = [this] { return wayland::input_latency_report(this->platform.base.outputs); };
+        qobject->integration.reset
+            = [this] { wayland::input_latency_reset(this->platform.base.outputs); };
+    }
+
+    std::unique_ptr<input_latency_qobject> qobject;
+
+private:
+    Platform& platform;
+};
+
+}
@@ -89,6 +89,11 @@ public:
     PreviousWindowPixmapLockPtr previousWindowPixmapLock;
     AnimationEffect::TerminationFlags terminationFlags;
     GLShader* shader{nullptr};
+
+    // Timeline value and progress of the current frame. Updated whenever the timeline changes so
+    // painting does not need to evaluate the easing curve for every attribute again.
+    float frameValue{0};
+    float frameProgress{0};
 };
 
 } // namespace
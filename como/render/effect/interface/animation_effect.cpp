@@ -16,6 +16,8 @@
 
 #include <QDebug>
 #include <QTimer>
+#include <unordered_map>
+#include <vector>
 
 QDebug operator<<(QDebug dbg, const como::FPx2& fpx2)
 {
@@ -30,6 +32,20 @@ namespace como
 
 QElapsedTimer AnimationEffect::s_clock;
 
+/**
+ * Animations of a single window.
+ */
+struct AniEntry {
+    EffectWindow* window;
+    std::vector<AniData> animations;
+
+    // Area the animations paint to. Null if it must be recomputed.
+    QRect layerRect;
+
+    // Whether the animations can paint anywhere so the whole scene must be repainted.
+    bool needsSceneRepaint{false};
+};
+
 class AnimationEffectPrivate
 {
 public:
@@ -38,7 +54,54 @@ public:
         m_animationsTouched = m_isInitialized = false;
         m_justEndedAnimation = 0;
     }
-    AnimationEffect::AniMap m_animations;
+
+    AniEntry* find(EffectWindow const* window)
+    {
+        auto it = m_index.find(window);
+        return it == m_index.end() ? nullptr : &m_animations[it->second];
+    }
+
+    AniEntry& add(EffectWindow* window)
+    {
+        m_index.emplace(window, m_animations.size());
+        m_animations.push_back({window, {}, {}});
+        return m_animations.back();
+    }
+
+    void remove(size_t index)
+    {
+        m_index.erase(m_animations[index].window);
+        m_animations.erase(m_animations.begin() + index);
+
+        for (auto i = index; i < m_animations.size(); ++i) {
+            m_index[m_animations[i].window] = i;
+        }
+    }
+
+    std::pair<AniEntry*, AniData*> findAnimation(quint64 id)
+    {
+        for (auto& entry : m_animations) {
+            for (auto& anim : entry.animations) {
+                if (anim.id == id) {
+                    return {&entry, &anim};
+                }
+            }
+        }
+        return {nullptr, nullptr};
+    }
+
+    bool needsSceneRepaint() const
+    {
+        return std::any_of(m_animations.cbegin(), m_animations.cend(), [](auto const& entry) {
+            return entry.needsSceneRepaint;
+        });
+    }
+
+    // Animated windows in the order their first animation started. Windows are looked up through
+    // the index, painting only iterates the few windows that are animated.
+    std::vector<AniEntry> m_animations;
+    std::unordered_map<EffectWindow const*, size_t> m_index;
+
     static quint64 m_animCounter;
     quint64 m_justEndedAnimation; // protect against cancel
     std::weak_ptr<FullScreenEffectLock> m_fullScreenEffectLock;
@@ -77,7 +140,7 @@ void AnimationEffect::init()
 
 bool AnimationEffect::isActive() const
 {
-    return !d_ptr->m_animations.isEmpty() && !effects->isScreenLocked();
+    return !d_ptr->m_animations.empty() && !effects->isScreenLocked();
 }
 
 #define RELATIVE_XY(_FIELD_)                                                                       \
@@ -225,13 +288,13 @@ quint64 AnimationEffect::p_animate(EffectWindow* w,
 
     if (!d_ptr->m_isInitialized)
         init(); // needs to ensure the window gets removed if deleted in the same event cycle
-    auto it = d_ptr->m_animations.find(w);
-    if (it == d_ptr->m_animations.end()) {
+    auto entry = d_ptr->find(w);
+    if (!entry) {
         connect(w,
                 &EffectWindow::windowExpandedGeometryChanged,
                 this,
                 &AnimationEffect::_windowExpandedGeometryChanged);
-        it = d_ptr->m_animations.insert(w, QPair<QList<AniData>, QRect>(QList<AniData>(), QRect()));
+        entry = &d_ptr->add(w);
     }
 
     std::shared_ptr<FullScreenEffectLock> fullscreen;
@@ -248,19 +311,19 @@ quint64 AnimationEffect::p_animate(EffectWindow* w,
         previousPixmap = PreviousWindowPixmapLockPtr::create(w);
     }
 
-    it->first.append(AniData(a,              // Attribute
-                             meta,           // Metadata
-                             to,             // Target
-                             delay,          // Delay
-                             from,           // Source
-                             waitAtSource,   // Whether the animation should be kept at source
-                             fullscreen,     // Full screen effect lock
-                             keepAlive,      // Keep alive flag
-                             previousPixmap, // Previous window pixmap lock
-                             shader));
+    auto& animation
+        = entry->animations.emplace_back(a,              // Attribute
+                                         meta,           // Metadata
+                                         to,             // Target
+                                         delay,          // Delay
+                                         from,           // Source
+                                         waitAtSource,   // Keep the animation at source until start
+                                         fullscreen,     // Full screen effect lock
+                                         keepAlive,      // Keep alive flag
+                                         previousPixmap, // Previous window pixmap lock
+                                         shader);
 
     const quint64 ret_id = ++d_ptr->m_animCounter;
-    AniData& animation = it->first.last();
     animation.id = ret_id;
 
     animation.visibleRef = EffectWindowVisibleRef(w,
@@ -277,8 +340,9 @@ quint64 AnimationEffect::p_animate(EffectWindow* w,
     if (!keepAtTarget) {
         animation.terminationFlags |= TerminateAtTarget;
     }
+    updateFrameValues(animation);
 
-    it->second = QRect();
+    entry->layerRect = QRect();
 
     d_ptr->m_animationsTouched = true;
 
@@ -306,25 +370,21 @@ bool AnimationEffect::retarget(quint64 animationId, FPx2 newTarget, int newRemai
         return false;
     }
 
-    for (auto entry = d_ptr->m_animations.begin(), mapEnd = d_ptr->m_animations.end();
-         entry != mapEnd;
-         ++entry) {
-        for (auto anim = entry->first.begin(), animEnd = entry->first.end(); anim != animEnd;
-             ++anim) {
-            if (anim->id == animationId) {
-                anim->from.set(interpolated(*anim, 0), interpolated(*anim, 1));
-                validate(anim->attribute, anim->meta, nullptr, &newTarget, entry.key());
-                anim->to.set(newTarget[0], newTarget[1]);
-
-                anim->timeLine.setDirection(TimeLine::Forward);
-                anim->timeLine.setDuration(std::chrono::milliseconds(newRemainingTime));
-                anim->timeLine.reset();
-
-                return true;
-            }
-        }
+    auto [entry, anim] = d_ptr->findAnimation(animationId);
+    if (!anim) {
+        return false; // no animation found
     }
-    return false; // no animation found
+
+    anim->from.set(interpolated(*anim, 0), interpolated(*anim, 1));
+    validate(anim->attribute, anim->meta, nullptr, &newTarget, entry->window);
+    anim->to.set(newTarget[0], newTarget[1]);
+
+    anim->timeLine.setDirection(TimeLine::Forward);
+    anim->timeLine.setDuration(std::chrono::milliseconds(newRemainingTime));
+    anim->timeLine.reset();
+    updateFrameValues(*anim);
+
+    return true;
 }
 
 bool AnimationEffect::freezeInTime(quint64 animationId, qint64 frozenTime)
@@ -332,21 +392,18 @@ bool AnimationEffect::freezeInTime(quint64 animationId, qint64 frozenTime)
     if (animationId == d_ptr->m_justEndedAnimation) {
         return false; // this is just ending, do not try to retarget it
     }
-    for (auto entry = d_ptr->m_animations.begin(), mapEnd = d_ptr->m_animations.end();
-         entry != mapEnd;
-         ++entry) {
-        for (auto anim = entry->first.begin(), animEnd = entry->first.end(); anim != animEnd;
-             ++anim) {
-            if (anim->id == animationId) {
-                if (frozenTime >= 0) {
-                    anim->timeLine.setElapsed(std::chrono::milliseconds(frozenTime));
-                }
-                anim->frozenTime = frozenTime;
-                return true;
-            }
-        }
+
+    auto anim = d_ptr->findAnimation(animationId).second;
+    if (!anim) {
+        return false; // no animation found
     }
-    return false; // no animation found
+
+    if (frozenTime >= 0) {
+        anim->timeLine.setElapsed(std::chrono::milliseconds(frozenTime));
+        updateFrameValues(*anim);
+    }
+    anim->frozenTime = frozenTime;
+    return true;
 }
 
 bool AnimationEffect::redirect(quint64 animationId,
@@ -357,31 +414,25 @@ bool AnimationEffect::redirect(quint64 animationId,
         return false;
     }
 
-    for (auto entryIt = d_ptr->m_animations.begin(); entryIt != d_ptr->m_animations.end();
-         ++entryIt) {
-        auto animIt = std::find_if(entryIt->first.begin(),
-                                   entryIt->first.end(),
-                                   [animationId](AniData& anim) { return anim.id == animationId; });
-        if (animIt == entryIt->first.end()) {
-            continue;
-        }
-
-        switch (direction) {
-        case Backward:
-            animIt->timeLine.setDirection(TimeLine::Backward);
-            break;
-
-        case Forward:
-            animIt->timeLine.setDirection(TimeLine::Forward);
-            break;
-        }
+    auto anim = d_ptr->findAnimation(animationId).second;
+    if (!anim) {
+        return false;
+    }
 
-        animIt->terminationFlags = terminationFlags & ~TerminateAtTarget;
+    switch (direction) {
+    case Backward:
+        anim->timeLine.setDirection(TimeLine::Backward);
+        break;
 
-        return true;
+    case Forward:
+        anim->timeLine.setDirection(TimeLine::Forward);
+        break;
     }
 
-    return false;
+    anim->terminationFlags = terminationFlags & ~TerminateAtTarget;
+    updateFrameValues(*anim);
+
+    return true;
 }
 
 bool AnimationEffect::complete(quint64 animationId)
@@ -390,21 +441,15 @@ bool AnimationEffect::complete(quint64 animationId)
         return false;
     }
 
-    for (auto entryIt = d_ptr->m_animations.begin(); entryIt != d_ptr->m_animations.end();
-         ++entryIt) {
-        auto animIt = std::find_if(entryIt->first.begin(),
-                                   entryIt->first.end(),
-                                   [animationId](AniData& anim) { return anim.id == animationId; });
-        if (animIt == entryIt->first.end()) {
-            continue;
-        }
-
-        animIt->timeLine.setElapsed(animIt->timeLine.duration());
-
-        return true;
+    auto anim = d_ptr->findAnimation(animationId).second;
+    if (!anim) {
+        return false;
     }
 
-    return false;
+    anim->timeLine.setElapsed(anim->timeLine.duration());
+    updateFrameValues(*anim);
+
+    return true;
 }
 
 bool AnimationEffect::cancel(quint64 animationId)
@@ -414,33 +459,30 @@ bool AnimationEffect::cancel(quint64 animationId)
         return true;
     }
 
-    for (auto entry = d_ptr->m_animations.begin(), mapEnd = d_ptr->m_animations.end();
-         entry != mapEnd;
-         ++entry) {
-        for (auto anim = entry->first.begin(), animEnd = entry->first.end(); anim != animEnd;
-             ++anim) {
-            if (anim->id == animationId) {
-                if (anim->shader
-                    && std::none_of(
-                        entry->first.begin(), entry->first.end(), [animationId](const auto& anim) {
-                            return anim.id != animationId && anim.shader;
-                        })) {
-                    unredirect(entry.key());
-                }
-                entry->first.erase(anim);     // remove the animation
-                if (entry->first.isEmpty()) { // no other animations on the window, release it.
-                    disconnect(entry.key(),
-                               &EffectWindow::windowExpandedGeometryChanged,
-                               this,
-                               &AnimationEffect::_windowExpandedGeometryChanged);
-                    d_ptr->m_animations.erase(entry);
-                }
-                d_ptr->m_animationsTouched = true; // could be called from animationEnded
-                return true;
-            }
-        }
+    auto [entry, anim] = d_ptr->findAnimation(animationId);
+    if (!anim) {
+        return false;
+    }
+
+    auto& animations = entry->animations;
+    if (anim->shader
+        && std::none_of(animations.cbegin(), animations.cend(), [animationId](auto const& other) {
+               return other.id != animationId && other.shader;
+           })) {
+        unredirect(entry->window);
+    }
+
+    animations.erase(animations.begin() + (anim - animations.data())); // remove the animation
+    if (animations.empty()) { // no other animations on the window, release it.
+        disconnect(entry->window,
+                   &EffectWindow::windowExpandedGeometryChanged,
+                   this,
+                   &AnimationEffect::_windowExpandedGeometryChanged);
+        d_ptr->remove(entry - d_ptr->m_animations.data());
     }
-    return false;
+
+    d_ptr->m_animationsTouched = true; // could be called from animationEnded
+    return true;
 }
 
 static int xCoord(const QRect& r, int flag)
@@ -488,17 +530,18 @@ QRect AnimationEffect::clipRect(const QRect& geo, const AniData& anim) const
 
 void AnimationEffect::prePaintWindow(effect::window_prepaint_data& data)
 {
-    auto entry = d_ptr->m_animations.find(&data.window);
+    if (auto entry = d_ptr->find(&data.window)) {
+        auto const now = clock();
 
-    if (entry != d_ptr->m_animations.end()) {
-        for (auto anim = entry->first.begin(); anim != entry->first.end(); ++anim) {
-            if (anim->startTime > clock() && !anim->waitAtSource) {
+        for (auto anim = entry->animations.begin(); anim != entry->animations.end(); ++anim) {
+            if (anim->startTime > now && !anim->waitAtSource) {
                 continue;
             }
 
             if (anim->frozenTime < 0) {
                 anim->timeLine.advance(data.present_time);
             }
+            updateFrameValues(*anim, now);
 
             if (anim->attribute == Opacity || anim->attribute == CrossFadePrevious) {
                 data.set_translucent();
@@ -522,13 +565,11 @@ static inline float geometryCompensation(int flags, float v)
 
 void AnimationEffect::paintWindow(effect::window_paint_data& data)
 {
-    auto entry = d_ptr->m_animations.constFind(&data.window);
-    if (entry != d_ptr->m_animations.constEnd()) {
-        for (QList<AniData>::const_iterator anim = entry->first.constBegin();
-             anim != entry->first.constEnd();
-             ++anim) {
+    if (auto entry = d_ptr->find(&data.window)) {
+        auto const now = clock();
 
-            if (anim->startTime > clock() && !anim->waitAtSource)
+        for (auto anim = entry->animations.cbegin(); anim != entry->animations.cend(); ++anim) {
+            if (anim->startTime > now && !anim->waitAtSource)
                 continue;
 
             switch (anim->attribute) {
@@ -674,61 +715,59 @@ void AnimationEffect::postPaintScreen()
 {
     d_ptr->m_animationsTouched = false;
     bool damageDirty = false;
+    auto const now = clock();
 
-    for (auto entry = d_ptr->m_animations.begin(); entry != d_ptr->m_animations.end();) {
+    for (size_t index = 0; index < d_ptr->m_animations.size();) {
+        auto entry = &d_ptr->m_animations[index];
         bool invalidateLayerRect = false;
-        int animCounter = 0;
-        for (auto anim = entry->first.begin(); anim != entry->first.end();) {
-            if (anim->isActive() || (anim->startTime > clock() && !anim->waitAtSource)) {
-                ++anim;
-                ++animCounter;
+        size_t animIndex = 0;
+
+        while (animIndex < entry->animations.size()) {
+            auto anim = &entry->animations[animIndex];
+            if (anim->isActive() || (anim->startTime > now && !anim->waitAtSource)) {
+                ++animIndex;
                 continue;
             }
-            auto window = entry.key();
+            auto window = entry->window;
             d_ptr->m_justEndedAnimation = anim->id;
             if (anim->shader
-                && std::none_of(
-                    entry->first.begin(), entry->first.end(), [anim](const auto& other) {
-                        return anim->id != other.id && other.shader;
-                    })) {
+                && std::none_of(entry->animations.cbegin(),
+                                entry->animations.cend(),
+                                [anim](auto const& other) {
+                                    return anim->id != other.id && other.shader;
+                                })) {
                 unredirect(window);
             }
             animationEnded(window, anim->attribute, anim->meta);
             d_ptr->m_justEndedAnimation = 0;
             // NOTICE animationEnded is an external call and might have called "::animate"
-            // as a result our iterators could now point random junk on the heap
-            // so we've to restore the former states, ie. find our window list and animation
+            // as a result our pointers could now point to random junk on the heap
+            // so we've to restore the former states, ie. find our window entry again
             if (d_ptr->m_animationsTouched) {
                 d_ptr->m_animationsTouched = false;
-                entry = d_ptr->m_animations.begin();
-                while (entry.key() != window && entry != d_ptr->m_animations.end()) {
-                    ++entry;
-                }
-                Q_ASSERT(
-                    entry
-                    != d_ptr->m_animations.end()); // usercode should not delete animations from
-                                                   // animationEnded (not even possible atm.)
-                anim = entry->first.begin();
-                Q_ASSERT(animCounter < entry->first.count());
-                for (int i = 0; i < animCounter; ++i) {
-                    ++anim;
-                }
+                entry = d_ptr->find(window);
+                // usercode should not delete animations from animationEnded (not even possible
+                // atm.)
+                Q_ASSERT(entry);
+                Q_ASSERT(animIndex < entry->animations.size());
+                index = entry - d_ptr->m_animations.data();
             }
-            anim = entry->first.erase(anim);
+            entry->animations.erase(entry->animations.begin() + animIndex);
             invalidateLayerRect = damageDirty = true;
         }
-        if (entry->first.isEmpty()) {
-            disconnect(entry.key(),
+
+        if (entry->animations.empty()) {
+            disconnect(entry->window,
                        &EffectWindow::windowExpandedGeometryChanged,
                        this,
                        &AnimationEffect::_windowExpandedGeometryChanged);
-            effects->addRepaint(entry->second);
-            entry = d_ptr->m_animations.erase(entry);
+            effects->addRepaint(entry->layerRect);
+            d_ptr->remove(index);
         } else {
             if (invalidateLayerRect) {
-                *const_cast<QRect*>(&(entry->second)) = QRect(); // invalidate
+                entry->layerRect = QRect();
             }
-            ++entry;
+            ++index;
         }
     }
 
@@ -738,13 +777,12 @@ void AnimationEffect::postPaintScreen()
     if (d_ptr->m_needSceneRepaint) {
         effects->addRepaintFull();
     } else {
-        for (auto entry = d_ptr->m_animations.constBegin(); entry != d_ptr->m_animations.constEnd();
-             ++entry) {
-            for (auto anim = entry->first.constBegin(); anim != entry->first.constEnd(); ++anim) {
-                if (anim->startTime > clock())
+        for (auto const& entry : d_ptr->m_animations) {
+            for (auto const& anim : entry.animations) {
+                if (anim.startTime > now)
                     continue;
-                if (!anim->timeLine.done()) {
-                    entry.key()->addLayerRepaint(entry->second);
+                if (!anim.timeLine.done()) {
+                    entry.window->addLayerRepaint(entry.layerRect);
                     break;
                 }
             }
@@ -756,12 +794,26 @@ void AnimationEffect::postPaintScreen()
 
 float AnimationEffect::interpolated(const AniData& a, int i) const
 {
-    return a.from[i] + a.timeLine.value() * (a.to[i] - a.from[i]);
+    return a.from[i] + a.frameValue * (a.to[i] - a.from[i]);
 }
 
 float AnimationEffect::progress(const AniData& a) const
 {
-    return a.startTime < clock() ? a.timeLine.value() : 0.0;
+    return a.frameProgress;
+}
+
+void AnimationEffect::updateFrameValues(AniData& a, qint64 now)
+{
+    a.frameValue = a.timeLine.value();
+
+    // The values are taken before painting, when the clock may not have advanced past the start
+    // time yet. Like in the paint passes an animation runs from its start time on.
+    a.frameProgress = a.startTime <= now ? a.frameValue : 0.0;
+}
+
+void AnimationEffect::updateFrameValues(AniData& a)
+{
+    updateFrameValues(a, clock());
 }
 
 // TODO - get this out of the header - the functionpointer usage of QEasingCurve somehow sucks ;-)
@@ -826,17 +878,22 @@ void AnimationEffect::setMetaData(MetaType type, uint value, uint& meta)
 
 void AnimationEffect::triggerRepaint()
 {
-    for (auto entry = d_ptr->m_animations.constBegin(); entry != d_ptr->m_animations.constEnd();
-         ++entry) {
-        *const_cast<QRect*>(&(entry->second)) = QRect();
+    auto const now = clock();
+
+    for (auto& entry : d_ptr->m_animations) {
+        entry.layerRect = QRect();
+
+        // Delayed animations might have started meanwhile.
+        for (auto& anim : entry.animations) {
+            updateFrameValues(anim, now);
+        }
     }
     updateLayerRepaints();
     if (d_ptr->m_needSceneRepaint) {
         effects->addRepaintFull();
     } else {
-        for (auto it = d_ptr->m_animations.constBegin(); it != d_ptr->m_animations.constEnd();
-             ++it) {
-            it.key()->addLayerRepaint(it->second);
+        for (auto const& entry : d_ptr->m_animations) {
+            entry.window->addLayerRepaint(entry.layerRect);
         }
     }
 }
@@ -861,187 +918,193 @@ static float fixOvershoot(float f, const AniData& d, short int dir, float s = 1.
 
 void AnimationEffect::updateLayerRepaints()
 {
-    d_ptr->m_needSceneRepaint = false;
-    for (auto entry = d_ptr->m_animations.constBegin(); entry != d_ptr->m_animations.constEnd();
-         ++entry) {
-        if (!entry->second.isNull()) {
-            continue;
+    auto const now = clock();
+
+    for (auto& entry : d_ptr->m_animations) {
+        // Windows that need a scene repaint keep a null layer rect and are updated every time.
+        if (entry.layerRect.isNull()) {
+            updateLayerRect(entry, now);
         }
+    }
 
-        float f[2] = {1.0, 1.0};
-        float t[2] = {0.0, 0.0};
-        bool createRegion = false;
-        QList<QRect> rects;
-        QRect* layerRect = const_cast<QRect*>(&(entry->second));
+    d_ptr->m_needSceneRepaint = d_ptr->needsSceneRepaint();
+}
 
-        for (auto anim = entry->first.constBegin(); anim != entry->first.constEnd(); ++anim) {
-            if (anim->startTime > clock()) {
-                continue;
-            }
-            switch (anim->attribute) {
-            case Opacity:
-            case Brightness:
-            case Saturation:
-            case CrossFadePrevious:
-            case Shader:
-            case ShaderUniform:
-                createRegion = true;
-                break;
-            case Rotation:
-                createRegion = false;
-                *layerRect = QRect(QPoint(0, 0), effects->virtualScreenSize());
-                goto region_creation; // sic! no need to do anything else
-            case Generic:
-                // we don't know whether this will change visual stacking order
-                // sic! no need to do anything else
-                d_ptr->m_needSceneRepaint = true;
-                return;
-            case Translation:
-            case Position: {
-                createRegion = true;
-                QRect r(entry.key()->frameGeometry());
-                int x[2] = {0, 0};
-                int y[2] = {0, 0};
-                if (anim->attribute == Translation) {
-                    x[0] = anim->from[0];
-                    x[1] = anim->to[0];
-                    y[0] = anim->from[1];
-                    y[1] = anim->to[1];
-                } else {
-                    if (anim->from[0] >= 0.0 && anim->to[0] >= 0.0) {
-                        x[0] = anim->from[0] - xCoord(r, metaData(SourceAnchor, anim->meta));
-                        x[1] = anim->to[0] - xCoord(r, metaData(TargetAnchor, anim->meta));
-                    }
-                    if (anim->from[1] >= 0.0 && anim->to[1] >= 0.0) {
-                        y[0] = anim->from[1] - yCoord(r, metaData(SourceAnchor, anim->meta));
-                        y[1] = anim->to[1] - yCoord(r, metaData(TargetAnchor, anim->meta));
-                    }
-                }
-                r = entry.key()->expandedGeometry();
-                rects << r.translated(x[0], y[0]) << r.translated(x[1], y[1]);
-                break;
-            }
-            case Clip:
-                createRegion = true;
-                break;
-            case Size:
-            case Scale: {
-                createRegion = true;
-                const QSize sz = entry.key()->frameGeometry().size();
-                float fx = qMax(fixOvershoot(anim->from[0], *anim, 1),
-                                fixOvershoot(anim->to[0], *anim, 2));
-                //                     float fx = qMax(interpolated(*anim,0), anim->to[0]);
-                if (fx >= 0.0) {
-                    if (anim->attribute == Size)
-                        fx /= sz.width();
-                    f[0] *= fx;
-                    t[0] += geometryCompensation(anim->meta & AnimationEffect::Horizontal, fx)
-                        * sz.width();
+void AnimationEffect::updateLayerRect(AniEntry& entry, qint64 now)
+{
+    entry.needsSceneRepaint = false;
+
+    float f[2] = {1.0, 1.0};
+    float t[2] = {0.0, 0.0};
+    bool createRegion = false;
+    QList<QRect> rects;
+
+    for (auto anim = entry.animations.cbegin(); anim != entry.animations.cend(); ++anim) {
+        if (anim->startTime > now) {
+            continue;
+        }
+        switch (anim->attribute) {
+        case Opacity:
+        case Brightness:
+        case Saturation:
+        case CrossFadePrevious:
+        case Shader:
+        case ShaderUniform:
+            createRegion = true;
+            break;
+        case Rotation:
+            entry.layerRect = QRect(QPoint(0, 0), effects->virtualScreenSize());
+            return; // sic! no need to do anything else
+        case Generic:
+            // we don't know whether this will change visual stacking order
+            // sic! no need to do anything else
+            entry.needsSceneRepaint = true;
+            return;
+        case Translation:
+        case Position: {
+            createRegion = true;
+            QRect r(entry.window->frameGeometry());
+            int x[2] = {0, 0};
+            int y[2] = {0, 0};
+            if (anim->attribute == Translation) {
+                x[0] = anim->from[0];
+                x[1] = anim->to[0];
+                y[0] = anim->from[1];
+                y[1] = anim->to[1];
+            } else {
+                if (anim->from[0] >= 0.0 && anim->to[0] >= 0.0) {
+                    x[0] = anim->from[0] - xCoord(r, metaData(SourceAnchor, anim->meta));
+                    x[1] = anim->to[0] - xCoord(r, metaData(TargetAnchor, anim->meta));
                 }
-                //                     float fy = qMax(interpolated(*anim,1), anim->to[1]);
-                float fy = qMax(fixOvershoot(anim->from[1], *anim, 1),
-                                fixOvershoot(anim->to[1], *anim, 2));
-                if (fy >= 0.0) {
-                    if (anim->attribute == Size)
-                        fy /= sz.height();
-                    if (!anim->isOneDimensional()) {
-                        f[1] *= fy;
-                        t[1] += geometryCompensation(anim->meta & AnimationEffect::Vertical, fy)
-                            * sz.height();
-                    } else if (((anim->meta & AnimationEffect::Vertical) >> 1)
-                               != (anim->meta & AnimationEffect::Horizontal)) {
-                        f[1] *= fx;
-                        t[1] += geometryCompensation(anim->meta & AnimationEffect::Vertical, fx)
-                            * sz.height();
-                    }
+                if (anim->from[1] >= 0.0 && anim->to[1] >= 0.0) {
+                    y[0] = anim->from[1] - yCoord(r, metaData(SourceAnchor, anim->meta));
+                    y[1] = anim->to[1] - yCoord(r, metaData(TargetAnchor, anim->meta));
                 }
-                break;
-            }
             }
+            r = entry.window->expandedGeometry();
+            rects << r.translated(x[0], y[0]) << r.translated(x[1], y[1]);
+            break;
         }
-    region_creation:
-        if (createRegion) {
-            auto const geo = entry.key()->expandedGeometry();
-            if (rects.isEmpty()) {
-                rects << geo;
+        case Clip:
+            createRegion = true;
+            break;
+        case Size:
+        case Scale: {
+            createRegion = true;
+            const QSize sz = entry.window->frameGeometry().size();
+            float fx = qMax(fixOvershoot(anim->from[0], *anim, 1),
+                            fixOvershoot(anim->to[0], *anim, 2));
+            //                     float fx = qMax(interpolated(*anim,0), anim->to[0]);
+            if (fx >= 0.0) {
+                if (anim->attribute == Size)
+                    fx /= sz.width();
+                f[0] *= fx;
+                t[0] += geometryCompensation(anim->meta & AnimationEffect::Horizontal, fx)
+                    * sz.width();
+            }
+            //                     float fy = qMax(interpolated(*anim,1), anim->to[1]);
+            float fy = qMax(fixOvershoot(anim->from[1], *anim, 1),
+                            fixOvershoot(anim->to[1], *anim, 2));
+            if (fy >= 0.0) {
+                if (anim->attribute == Size)
+                    fy /= sz.height();
+                if (!anim->isOneDimensional()) {
+                    f[1] *= fy;
+                    t[1] += geometryCompensation(anim->meta & AnimationEffect::Vertical, fy)
+                        * sz.height();
+                } else if (((anim->meta & AnimationEffect::Vertical) >> 1)
+                           != (anim->meta & AnimationEffect::Horizontal)) {
+                    f[1] *= fx;
+                    t[1] += geometryCompensation(anim->meta & AnimationEffect::Vertical, fx)
+                        * sz.height();
+                }
             }
+            break;
+        }
+        }
+    }
+    if (createRegion) {
+        auto const geo = entry.window->expandedGeometry();
+        if (rects.isEmpty()) {
+            rects << geo;
+        }
 
-            auto r = rects.constEnd();
-            auto rEnd = r;
+        auto r = rects.constEnd();
+        auto rEnd = r;
 
-            for (r = rects.constBegin(); r != rEnd; ++r) {
-                // transform
-                const_cast<QRect*>(&(*r))->setSize(
-                    QSize(qRound(r->width() * f[0]), qRound(r->height() * f[1])));
-                const_cast<QRect*>(&(*r))->translate(t[0], t[1]);
-            }
+        for (r = rects.constBegin(); r != rEnd; ++r) {
+            // transform
+            const_cast<QRect*>(&(*r))->setSize(
+                QSize(qRound(r->width() * f[0]), qRound(r->height() * f[1])));
+            const_cast<QRect*>(&(*r))->translate(t[0], t[1]);
+        }
 
-            auto rect = rects.at(0);
-            if (rects.count() > 1) {
-                for (r = rects.constBegin() + 1; r != rEnd; ++r) // unite
-                    rect |= *r;
-                const int dx
-                    = 110 * (rect.width() - geo.width()) / 100 + 1 - rect.width() + geo.width();
-                const int dy
-                    = 110 * (rect.height() - geo.height()) / 100 + 1 - rect.height() + geo.height();
-                rect.adjust(-dx, -dy, dx, dy); // fix pot. overshoot
-            }
-            *layerRect = rect;
+        auto rect = rects.at(0);
+        if (rects.count() > 1) {
+            for (r = rects.constBegin() + 1; r != rEnd; ++r) // unite
+                rect |= *r;
+            const int dx
+                = 110 * (rect.width() - geo.width()) / 100 + 1 - rect.width() + geo.width();
+            const int dy
+                = 110 * (rect.height() - geo.height()) / 100 + 1 - rect.height() + geo.height();
+            rect.adjust(-dx, -dy, dx, dy); // fix pot. overshoot
         }
+        entry.layerRect = rect;
     }
 }
 
 void AnimationEffect::_windowExpandedGeometryChanged(como::EffectWindow* w)
 {
-    if (auto entry = d_ptr->m_animations.constFind(w); entry != d_ptr->m_animations.constEnd()) {
-        *const_cast<QRect*>(&(entry->second)) = QRect();
-        updateLayerRepaints();
-        if (!entry->second.isNull()) {
+    if (auto entry = d_ptr->find(w)) {
+        entry->layerRect = QRect();
+        updateLayerRect(*entry, clock());
+        d_ptr->m_needSceneRepaint = d_ptr->needsSceneRepaint();
+        if (!entry->layerRect.isNull()) {
             // actually got updated, ie. is in use - ensure it get's a repaint
-            w->addLayerRepaint(entry->second);
+            w->addLayerRepaint(entry->layerRect);
         }
     }
 }
 
 void AnimationEffect::_windowClosed(EffectWindow* w)
 {
-    auto it = d_ptr->m_animations.find(w);
-    if (it == d_ptr->m_animations.end()) {
+    auto entry = d_ptr->find(w);
+    if (!entry) {
         return;
     }
 
-    auto& animations = (*it).first;
-    for (auto animationIt = animations.begin(); animationIt != animations.end(); ++animationIt) {
-        if (animationIt->keepAlive) {
-            animationIt->deletedRef = EffectWindowDeletedRef(w);
+    for (auto& animation : entry->animations) {
+        if (animation.keepAlive) {
+            animation.deletedRef = EffectWindowDeletedRef(w);
         }
     }
 }
 
 void AnimationEffect::_windowDeleted(EffectWindow* w)
 {
-    d_ptr->m_animations.remove(w);
+    if (auto it = d_ptr->m_index.find(w); it != d_ptr->m_index.end()) {
+        d_ptr->remove(it->second);
+    }
 }
 
 QString AnimationEffect::debug(const QString& /*parameter*/) const
 {
-    if (d_ptr->m_animations.isEmpty()) {
+    if (d_ptr->m_animations.empty()) {
         return QStringLiteral("No window is animated");
     }
 
     QString dbg;
 
-    for (auto entry = d_ptr->m_animations.constBegin(); entry != d_ptr->m_animations.constEnd();
-         ++entry) {
+    for (auto const& entry : d_ptr->m_animations) {
         auto caption
-            = entry.key()->isDeleted() ? QStringLiteral("[Deleted]") : entry.key()->caption();
+            = entry.window->isDeleted() ? QStringLiteral("[Deleted]") : entry.window->caption();
         if (caption.isEmpty()) {
             caption = QStringLiteral("[Untitled]");
         }
         dbg += QLatin1String("Animating window: ") + caption + QLatin1Char('\n');
 
-        for (auto anim = entry->first.constBegin(); anim != entry->first.constEnd(); ++anim)
-            dbg += anim->debugInfo();
+        for (auto const& anim : entry.animations)
+            dbg += anim.debugInfo();
     }
 
     return dbg;
@@ -1049,5 +1112,11 @@ QString AnimationEffect::debug(const QString& /*parameter*/) const
 
 AnimationEffect::AniMap AnimationEffect::state() const
 {
-    return d_ptr->m_animations;
+    AniMap state;
+    for (auto const& entry : d_ptr->m_animations) {
+        state.insert(entry.window,
+                     {QList<AniData>(entry.animations.cbegin(), entry.animations.cend()),
+                      entry.layerRect});
+    }
+    return state;
 }
@@ -176,6 +176,7 @@ private:
 };
 
 class AniData;
+struct AniEntry;
 class AnimationEffectPrivate;
 
 /**
@@ -532,7 +533,7 @@ protected:
     typedef QMap<EffectWindow*, QPair<QList<AniData>, QRect>> AniMap;
 
     /**
-     * @internal
+     * @internal Snapshot of the animation state for debugging and tests.
      */
     AniMap state() const;
 
@@ -552,7 +553,10 @@ private:
     QRect clipRect(const QRect& windowRect, const AniData&) const;
     float interpolated(const AniData&, int i = 0) const;
     float progress(const AniData&) const;
+    static void updateFrameValues(AniData& a, qint64 now);
+    static void updateFrameValues(AniData& a);
     void updateLayerRepaints();
+    static void updateLayerRect(AniEntry& entry, qint64 now);
     void validate(Attribute a, uint& meta, FPx2* from, FPx2* to, const EffectWindow* w) const;
 
 private Q_SLOTS:
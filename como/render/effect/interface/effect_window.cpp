@@ -53,6 +53,22 @@ void EffectWindow::setMinimized(bool min)
     }
 }
 
+void EffectWindow::setData(int role, const QVariant& data)
+{
+    m_data.set_variant(role, data);
+    notifyDataChanged(role);
+}
+
+QVariant EffectWindow::data(int role) const
+{
+    return m_data.variant(role);
+}
+
+void EffectWindow::notifyDataChanged(int role)
+{
+    Q_EMIT effects->windowDataChanged(this, role);
+}
+
 bool EffectWindow::isOnCurrentActivity() const
 {
     return isOnActivity(effects->currentActivity());
@@ -7,6 +7,7 @@
 
 #include <como/render/effect/interface/effect_screen.h>
 #include <como/render/effect/interface/types.h>
+#include <como/render/effect/interface/window_data.h>
 #include <como/win/subspace.h>
 #include <como_export.h>
 
@@ -672,10 +673,38 @@ public:
      * Can be used to by effects to store arbitrary data in the EffectWindow.
      *
      * Invoking this method will emit the signal EffectsHandler::windowDataChanged.
+     * Prefer the typed slots in C++ code.
      * @see EffectsHandler::windowDataChanged
      */
-    Q_SCRIPTABLE virtual void setData(int role, const QVariant& data) = 0;
-    Q_SCRIPTABLE virtual QVariant data(int role) const = 0;
+    Q_SCRIPTABLE void setData(int role, const QVariant& data);
+    Q_SCRIPTABLE QVariant data(int role) const;
+
+    /**
+     * Returns the data stored in @p slot or null if the slot is not set.
+     */
+    template<typename T>
+    T const* data(effect::window_data_slot<T> slot) const
+    {
+        return m_data.get(slot);
+    }
+
+    /**
+     * Stores @p value in @p slot. Invoking this method will emit the signal
+     * EffectsHandler::windowDataChanged with the role of the slot.
+     */
+    template<typename T>
+    void setData(effect::window_data_slot<T> slot, std::type_identity_t<T> value)
+    {
+        m_data.set(slot, std::move(value));
+        notifyDataChanged(slot.role);
+    }
+
+    template<typename T>
+    void resetData(effect::window_data_slot<T> slot)
+    {
+        m_data.reset(slot.role);
+        notifyDataChanged(slot.role);
+    }
 
     /**
      * @brief References the previous window pixmap to prevent discarding.
@@ -867,8 +896,11 @@ protected:
     virtual void unrefVisible(EffectWindowVisibleRef const* holder) = 0;
 
 private:
+    void notifyDataChanged(int role);
+
     class Private;
     QScopedPointer<Private> d;
+    effect::window_data_store m_data;
 };
 
 }
@@ -12,6 +12,7 @@
 
 #include <como/base/logging.h>
 #include <como/render/gl/interface/framebuffer.h>
+#include <como/render/gl/interface/render_target_pool.h>
 #include <como/render/gl/interface/shader.h>
 #include <como/render/gl/interface/shader_manager.h>
 #include <como/render/gl/interface/texture.h>
@@ -27,9 +28,10 @@ struct OffscreenData {
         QObject::disconnect(windowDamagedConnection);
     }
 
-    QScopedPointer<GLTexture> texture;
-    QScopedPointer<GLFramebuffer> renderTarget;
+    std::unique_ptr<GLRenderTarget> target;
     bool isDirty = true;
+    // Damage relative to the buffer geometry that is not yet rendered into the target.
+    QRegion damage;
     GLShader* shader = nullptr;
     QMetaObject::Connection windowExpandedGeometryChangedConnection;
     QMetaObject::Connection windowDamagedConnection;
@@ -52,6 +54,9 @@ public:
     bool live = true;
 };
 
+// Partial renders with more damaged rects are done on their bounding rect.
+static constexpr int s_maxDamageRects = 8;
+
 OffscreenEffect::OffscreenEffect(QObject* parent)
     : Effect(parent)
     , d(new OffscreenEffectPrivate)
@@ -76,12 +81,14 @@ void OffscreenEffect::setLive(bool live)
 
 static void allocateOffscreenData(EffectWindow* window, OffscreenData* offscreenData)
 {
-    const QRect geometry = window->expandedGeometry();
-    offscreenData->texture.reset(new GLTexture(GL_RGBA8, geometry.size()));
-    offscreenData->texture->setFilter(GL_LINEAR);
-    offscreenData->texture->setWrapMode(GL_CLAMP_TO_EDGE);
-    offscreenData->renderTarget.reset(new GLFramebuffer(offscreenData->texture.data()));
+    auto const size = window->expandedGeometry().size();
+
+    // Resize steps of animations mostly stay in the size class of the current texture.
+    if (!offscreenData->target || !offscreenData->target->resize(size)) {
+        offscreenData->target = GLRenderTargetPool::instance()->acquire(size);
+    }
     offscreenData->isDirty = true;
+    offscreenData->damage = {};
 }
 
 void OffscreenEffect::redirect(EffectWindow* window)
@@ -133,12 +140,39 @@ void OffscreenEffectPrivate::maybeRender(EffectWindow& window,
                                          effect::render_data* render_data,
                                          OffscreenData* offscreenData)
 {
-    if (!offscreenData->isDirty) {
+    if (!offscreenData->target) {
+        return;
+    }
+    if (!offscreenData->isDirty && offscreenData->damage.isEmpty()) {
         return;
     }
 
     auto const geometry = window.expandedGeometry();
-    assert(geometry.size() == offscreenData->renderTarget->size());
+    assert(geometry.size() == offscreenData->target->size());
+
+    // Damaged parts of the target. Everything is rendered again when the target was (re)allocated.
+    auto region = QRegion(QRect({}, geometry.size()));
+    if (!offscreenData->isDirty) {
+        auto const offset = window.bufferGeometry().topLeft() - geometry.topLeft();
+
+        QRegion damage;
+        for (auto const& rect : offscreenData->damage) {
+            // Includes the texels sampled around the damage on fractional scales.
+            damage += rect.translated(offset).adjusted(-1, -1, 1, 1);
+        }
+        region &= damage;
+
+        if (region.rectCount() > s_maxDamageRects) {
+            region = region.boundingRect();
+        }
+    }
+
+    offscreenData->isDirty = false;
+    offscreenData->damage = {};
+
+    if (region.isEmpty()) {
+        return;
+    }
 
     QMatrix4x4 projection;
     projection.ortho(QRect({0, 0}, geometry.size()));
@@ -148,23 +182,34 @@ void OffscreenEffectPrivate::maybeRender(EffectWindow& window,
 
     std::stack<render::framebuffer*> temp_render_targets;
 
+    auto fbo = offscreenData->target->framebuffer();
     effect::render_data render{
         .targets = render_data ? render_data->targets : temp_render_targets,
         .view = view,
         .projection = projection,
-        .viewport = {{}, geometry.size()},
+        .viewport = fbo->viewport(),
     };
 
-    render::push_framebuffer(render, offscreenData->renderTarget.data());
+    render::push_framebuffer(render, fbo);
+
+    // Only the damaged parts are cleared. The scene clips the window to the paint region.
+    auto const paintRegion = region.translated(geometry.topLeft());
 
     glClearColor(0.0, 0.0, 0.0, 0.0);
-    glClear(GL_COLOR_BUFFER_BIT);
+    for (auto const& rect : effect::map_to_viewport(render, paintRegion)) {
+        glScissor(rect.x(), rect.y(), rect.width(), rect.height());
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    auto const vp = fbo->viewport();
+    glScissor(vp.x(), vp.y(), vp.width(), vp.height());
+
+    auto const full = region.rectCount() == 1 && region.boundingRect().size() == geometry.size();
 
     effect::window_paint_data data{
         window,
         {
             .mask = Effect::PAINT_WINDOW_TRANSFORMED | Effect::PAINT_WINDOW_TRANSLUCENT,
-            .region = infiniteRegion(),
+            .region = full ? infiniteRegion() : paintRegion,
             .opacity = 1.,
         },
         render,
@@ -173,7 +218,6 @@ void OffscreenEffectPrivate::maybeRender(EffectWindow& window,
     effects->drawWindow(data);
 
     render::pop_framebuffer(data.render);
-    offscreenData->isDirty = false;
 }
 
 void OffscreenEffectPrivate::paint(GLTexture* texture,
@@ -232,7 +276,7 @@ void OffscreenEffectPrivate::paint(GLTexture* texture,
 void OffscreenEffect::drawWindow(effect::window_paint_data& data)
 {
     auto offscreenData = d->windows.value(&data.window);
-    if (!offscreenData) {
+    if (!offscreenData || !offscreenData->target) {
         effects->drawWindow(data);
         return;
     }
@@ -242,18 +286,20 @@ void OffscreenEffect::drawWindow(effect::window_paint_data& data)
 
     QRectF visibleRect = expandedGeometry;
     visibleRect.moveTopLeft(expandedGeometry.topLeft() - frameGeometry.topLeft());
+    auto const texScale = offscreenData->target->textureCoordScale();
     WindowQuad quad(WindowQuadContents);
     quad[0] = WindowVertex(visibleRect.topLeft(), QPointF(0, 0));
-    quad[1] = WindowVertex(visibleRect.topRight(), QPointF(1, 0));
-    quad[2] = WindowVertex(visibleRect.bottomRight(), QPointF(1, 1));
-    quad[3] = WindowVertex(visibleRect.bottomLeft(), QPointF(0, 1));
+    quad[1] = WindowVertex(visibleRect.topRight(), QPointF(texScale.width(), 0));
+    quad[2] = WindowVertex(visibleRect.bottomRight(),
+                           QPointF(texScale.width(), texScale.height()));
+    quad[3] = WindowVertex(visibleRect.bottomLeft(), QPointF(0, texScale.height()));
 
     WindowQuadList quads;
     quads.append(quad);
     apply(data, quads);
 
     d->maybeRender(data.window, &data.render, offscreenData);
-    d->paint(offscreenData->texture.data(), data, quads, offscreenData->shader);
+    d->paint(offscreenData->target->texture(), data, quads, offscreenData->shader);
 }
 
 void OffscreenEffect::handleWindowGeometryChanged(EffectWindow* window)
@@ -261,18 +307,27 @@ void OffscreenEffect::handleWindowGeometryChanged(EffectWindow* window)
     auto offscreenData = d->windows.value(window);
     if (offscreenData) {
         const QRect geometry = window->expandedGeometry();
-        if (offscreenData->texture->size() != geometry.size()) {
+        if (!offscreenData->target || offscreenData->target->size() != geometry.size()) {
             effects->makeOpenGLContextCurrent();
             allocateOffscreenData(window, offscreenData);
         }
     }
 }
 
-void OffscreenEffect::handleWindowDamaged(EffectWindow* window)
+void OffscreenEffect::handleWindowDamaged(EffectWindow* window, QRegion const& damage)
 {
-    if (auto offscreenData = d->windows.value(window)) {
+    auto offscreenData = d->windows.value(window);
+    if (!offscreenData) {
+        return;
+    }
+
+    // Some windows do not report the extents of their damage.
+    if (damage.isEmpty()) {
         offscreenData->isDirty = true;
+        return;
     }
+
+    offscreenData->damage += damage;
 }
 
 void OffscreenEffect::setShader(EffectWindow const& window, GLShader* shader)
@@ -72,7 +72,7 @@ protected:
 
 private Q_SLOTS:
     void handleWindowGeometryChanged(EffectWindow* window);
-    void handleWindowDamaged(EffectWindow* window);
+    void handleWindowDamaged(EffectWindow* window, QRegion const& damage);
     void handleWindowDeleted(EffectWindow* window);
 
 private:
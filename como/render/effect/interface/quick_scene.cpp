@@ -14,12 +14,17 @@
 #include <QQmlIncubator>
 #include <QQuickItem>
 #include <QQuickWindow>
+#include <QTimer>
+#include <chrono>
 
 namespace como
 {
 
 static QHash<QQuickWindow*, QuickSceneView*> s_views;
 
+// Views of a stopped effect are rendered at most this often.
+static constexpr std::chrono::milliseconds s_backgroundUpdateInterval{500};
+
 class QuickSceneViewIncubator : public QQmlIncubator
 {
 public:
@@ -61,6 +66,13 @@ private:
 class QuickSceneEffectPrivate : QObject
 {
 public:
+    QuickSceneEffectPrivate()
+    {
+        backgroundUpdateTimer.setSingleShot(true);
+        QObject::connect(
+            &backgroundUpdateTimer, &QTimer::timeout, this, [this] { updateInBackground(); });
+    }
+
     void set_mouse_implicit_grab(QuickSceneView* view);
     bool isItemOnScreen(QQuickItem* item, EffectScreen const* screen) const;
 
@@ -85,13 +97,32 @@ public:
         }
     }
 
+    void scheduleBackgroundUpdate()
+    {
+        if (!backgroundUpdateTimer.isActive()) {
+            backgroundUpdateTimer.start(s_backgroundUpdateInterval);
+        }
+    }
+
+    void updateInBackground()
+    {
+        for (auto const& [screen, view] : views) {
+            if (view->isDirty()) {
+                view->update();
+                view->resetDirty();
+            }
+        }
+    }
+
     QUrl source;
     std::map<EffectScreen const*, std::unique_ptr<QQmlContext>> contexts;
     std::map<EffectScreen const*, std::unique_ptr<QQmlIncubator>> incubators;
     std::map<EffectScreen const*, std::unique_ptr<QuickSceneView>> views;
     QuickSceneView* mouseImplicitGrab{nullptr};
     bool running = false;
+    bool persistentViews = false;
     EffectScreen const* paintedScreen{nullptr};
+    QTimer backgroundUpdateTimer;
 
 private:
     QQmlComponent* delegate;
@@ -185,7 +216,12 @@ void QuickSceneView::resetDirty()
 void QuickSceneView::scheduleRepaint()
 {
     markDirty();
-    effects->addRepaint(geometry());
+
+    if (m_effect->isRunning()) {
+        effects->addRepaint(geometry());
+    } else {
+        QuickSceneEffectPrivate::get(m_effect)->scheduleBackgroundUpdate();
+    }
 }
 
 QuickSceneView* QuickSceneView::findView(QQuickItem* item)
@@ -275,6 +311,28 @@ void QuickSceneEffect::setRunning(bool running)
     }
 }
 
+bool QuickSceneEffect::persistentViews() const
+{
+    return d->persistentViews;
+}
+
+void QuickSceneEffect::setPersistentViews(bool persistent)
+{
+    d->persistentViews = persistent;
+
+    if (!persistent && !d->running) {
+        destroyViews();
+    }
+}
+
+void QuickSceneEffect::warmUp()
+{
+    if (d->running || !loadDelegate()) {
+        return;
+    }
+    createViews();
+}
+
 QUrl QuickSceneEffect::source() const
 {
     return d->source;
@@ -287,6 +345,7 @@ void QuickSceneEffect::setSource(const QUrl& url)
         return;
     }
     if (d->source != url) {
+        destroyViews();
         d->source = url;
         if (d->get_delegate()) {
             d->set_delegate(nullptr);
@@ -306,6 +365,7 @@ void QuickSceneEffect::setDelegate(QQmlComponent* delegate)
         return;
     }
     if (d->get_delegate() != delegate) {
+        destroyViews();
         d->source = QUrl();
         d->set_delegate(delegate);
         Q_EMIT delegateChanged();
@@ -331,7 +391,7 @@ QuickSceneView* QuickSceneEffect::activeView() const
     auto const it = std::find_if(d->views.begin(), d->views.end(), [](auto const& view) {
         return view.second->window()->activeFocusItem();
     });
-    return it == d->views.end() ? d->views[effects->activeScreen()].get() : it->second.get();
+    return it == d->views.end() ? viewForScreen(effects->activeScreen()) : it->second.get();
 }
 
 como::QuickSceneView* QuickSceneEffect::getView(Qt::Edge edge)
@@ -452,7 +512,7 @@ void QuickSceneEffect::postPaintScreen()
 
 bool QuickSceneEffect::isActive() const
 {
-    return !d->views.empty() && !effects->isScreenLocked();
+    return d->running && !d->views.empty() && !effects->isScreenLocked();
 }
 
 QVariantMap QuickSceneEffect::initialProperties(EffectScreen const* /*screen*/)
@@ -474,6 +534,10 @@ void QuickSceneEffect::handleScreenRemoved(EffectScreen const* screen)
 
 void QuickSceneEffect::addScreen(EffectScreen const* screen)
 {
+    if (d->incubators.contains(screen)) {
+        return;
+    }
+
     auto properties = initialProperties(screen);
     properties["width"] = screen->geometry().width();
     properties["height"] = screen->geometry().height();
@@ -485,8 +549,10 @@ void QuickSceneEffect::addScreen(EffectScreen const* screen)
                 if (view->contentItem()) {
                     view->contentItem()->setFocus(false);
                 }
-                connect(view.get(), &QuickSceneView::repaintNeeded, this, [screen]() {
-                    effects->addRepaint(screen->geometry());
+                connect(view.get(), &QuickSceneView::repaintNeeded, this, [this, screen]() {
+                    if (d->running) {
+                        effects->addRepaint(screen->geometry());
+                    }
                 });
                 connect(view.get(),
                         &QuickSceneView::renderRequested,
@@ -524,16 +590,12 @@ void QuickSceneEffect::addScreen(EffectScreen const* screen)
     d->get_delegate()->create(*incubator, context);
 }
 
-void QuickSceneEffect::startInternal()
+bool QuickSceneEffect::loadDelegate()
 {
-    if (effects->activeFullScreenEffect()) {
-        return;
-    }
-
     if (!d->get_delegate()) {
         if (Q_UNLIKELY(d->source.isEmpty())) {
             qWarning() << "QuickSceneEffect.source is empty. Did you forget to call setSource()?";
-            return;
+            return false;
         }
 
         d->set_delegate(new QQmlComponent(effects->qmlEngine(), this));
@@ -543,51 +605,92 @@ void QuickSceneEffect::startInternal()
         if (delegate->isError()) {
             qWarning().nospace() << "Failed to load " << d->source << ": " << delegate->errors();
             d->set_delegate(nullptr);
-            return;
+            return false;
         }
         Q_EMIT delegateChanged();
     }
 
-    if (!d->get_delegate()->isReady()) {
+    return d->get_delegate()->isReady();
+}
+
+void QuickSceneEffect::createViews()
+{
+    auto const screens = effects->screens();
+    for (auto screen : screens) {
+        addScreen(screen);
+    }
+
+    connect(effects,
+            &EffectsHandler::screenAdded,
+            this,
+            &QuickSceneEffect::handleScreenAdded,
+            Qt::UniqueConnection);
+    connect(effects,
+            &EffectsHandler::screenRemoved,
+            this,
+            &QuickSceneEffect::handleScreenRemoved,
+            Qt::UniqueConnection);
+}
+
+void QuickSceneEffect::destroyViews()
+{
+    disconnect(effects, &EffectsHandler::screenAdded, this, &QuickSceneEffect::handleScreenAdded);
+    disconnect(
+        effects, &EffectsHandler::screenRemoved, this, &QuickSceneEffect::handleScreenRemoved);
+
+    d->backgroundUpdateTimer.stop();
+    d->incubators.clear();
+    d->views.clear();
+    d->contexts.clear();
+}
+
+void QuickSceneEffect::startInternal()
+{
+    if (effects->activeFullScreenEffect()) {
+        return;
+    }
+
+    if (!loadDelegate()) {
         return;
     }
 
     effects->setActiveFullScreenEffect(this);
     d->running = true;
+    d->backgroundUpdateTimer.stop();
 
     // Install an event filter to monitor cursor shape changes.
     qApp->installEventFilter(this);
 
-    auto const screens = effects->screens();
-    for (auto screen : screens) {
-        addScreen(screen);
+    // Views created ahead of time are shown right away.
+    createViews();
+    for (auto const& [screen, view] : d->views) {
+        view->scheduleRepaint();
     }
 
     // Ensure one view has an active focus item
     activateView(activeView());
 
-    connect(effects, &EffectsHandler::screenAdded, this, &QuickSceneEffect::handleScreenAdded);
-    connect(effects, &EffectsHandler::screenRemoved, this, &QuickSceneEffect::handleScreenRemoved);
-
     effects->grabKeyboard(this);
     effects->startMouseInterception(this, Qt::ArrowCursor);
+
+    Q_EMIT runningChanged();
 }
 
 void QuickSceneEffect::stopInternal()
 {
-    disconnect(effects, &EffectsHandler::screenAdded, this, &QuickSceneEffect::handleScreenAdded);
-    disconnect(
-        effects, &EffectsHandler::screenRemoved, this, &QuickSceneEffect::handleScreenRemoved);
+    if (!d->persistentViews) {
+        destroyViews();
+    }
 
-    d->incubators.clear();
-    d->views.clear();
-    d->contexts.clear();
+    d->set_mouse_implicit_grab(nullptr);
     d->running = false;
     qApp->removeEventFilter(this);
     effects->ungrabKeyboard();
     effects->stopMouseInterception(this);
     effects->setActiveFullScreenEffect(nullptr);
     effects->addRepaintFull();
+
+    Q_EMIT runningChanged();
 }
 
 void QuickSceneEffect::windowInputMouseEvent(QEvent* event)
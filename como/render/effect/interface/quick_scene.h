@@ -75,6 +75,7 @@ private:
 class COMO_EXPORT QuickSceneEffect : public Effect
 {
     Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
     Q_PROPERTY(QuickSceneView* activeView READ activeView NOTIFY activeViewChanged)
     Q_PROPERTY(QQmlComponent* delegate READ delegate WRITE setDelegate NOTIFY delegateChanged)
 
@@ -92,6 +93,30 @@ public:
      */
     void setRunning(bool running);
 
+    /**
+     * Returns @c true if the scene views are kept after the effect stops.
+     */
+    bool persistentViews() const;
+
+    /**
+     * Keeps the scene views alive while the effect is not running if @a persistent is @c true.
+     *
+     * Kept views and their delegates continue to follow changes of the windows and are rendered
+     * at low priority in the background. Starting the effect again shows them in the next frame
+     * instead of waiting for the QML scene to be created. The QML scene must react to changes of
+     * the running property in that case instead of only setting up its state on completion.
+     */
+    void setPersistentViews(bool persistent);
+
+    /**
+     * Creates the scene views without starting the effect.
+     *
+     * Call this on a trigger that likely precedes the activation, for example the begin of a
+     * gesture. The views are incubated asynchronously and are reused when the effect starts.
+     * Unless the views are persistent they are destroyed when the effect stops.
+     */
+    void warmUp();
+
     QuickSceneView* activeView() const;
 
     /**
@@ -157,6 +182,7 @@ public:
     Q_INVOKABLE void checkItemDroppedOutOfScreen(const QPointF& globalPos, QQuickItem* item);
 
 Q_SIGNALS:
+    void runningChanged();
     void itemDraggedOutOfScreen(QQuickItem* item, QList<EffectScreen const*> screens);
     void
     itemDroppedOutOfScreen(QPointF const& globalPos, QQuickItem* item, EffectScreen const* screen);
@@ -177,6 +203,9 @@ private:
     void handleScreenRemoved(EffectScreen const* screen);
 
     void addScreen(EffectScreen const* screen);
+    bool loadDelegate();
+    void createViews();
+    void destroyViews();
     void startInternal();
     void stopInternal();
 
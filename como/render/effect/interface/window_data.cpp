@@ -0,0 +1,110 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "window_data.h"
+
+#include <como/base/logging.h>
+
+#include <atomic>
+#include <cassert>
+
+namespace como::effect
+{
+
+// Built-in slots use the indices of their roles. Registered slots follow after them.
+constexpr int builtin_slot_count{LanczosCacheRole + 1};
+
+int register_window_data_role()
+{
+    static std::atomic<int> next_role{window_data_registered_role_start};
+    return next_role++;
+}
+
+int window_data_store::index(int role)
+{
+    if (role > 0 && role < builtin_slot_count) {
+        return role;
+    }
+    if (role >= window_data_registered_role_start) {
+        return role - window_data_registered_role_start + builtin_slot_count;
+    }
+    return -1;
+}
+
+window_data_value_base const* window_data_store::find(int role) const
+{
+    auto const idx = index(role);
+    if (idx < 0 || idx >= static_cast<int>(m_values.size())) {
+        return nullptr;
+    }
+    return m_values[idx].get();
+}
+
+void window_data_store::assign(int role, std::unique_ptr<window_data_value_base> value)
+{
+    auto const idx = index(role);
+    assert(idx >= 0);
+
+    if (idx >= static_cast<int>(m_values.size())) {
+        m_values.resize(idx + 1);
+    }
+    m_values[idx] = std::move(value);
+}
+
+void window_data_store::reset(int role)
+{
+    auto const idx = index(role);
+    if (idx < 0) {
+        m_variants.remove(role);
+        return;
+    }
+    if (idx < static_cast<int>(m_values.size())) {
+        m_values[idx].reset();
+    }
+}
+
+QVariant window_data_store::variant(int role) const
+{
+    if (index(role) < 0) {
+        return m_variants.value(role);
+    }
+
+    auto value = find(role);
+    return value ? value->variant() : QVariant();
+}
+
+void window_data_store::set_variant(int role, QVariant const& data)
+{
+    if (data.isNull()) {
+        reset(role);
+        return;
+    }
+
+    switch (role) {
+    case WindowAddedGrabRole:
+    case WindowClosedGrabRole:
+    case WindowMinimizedGrabRole:
+    case WindowUnminimizedGrabRole:
+        set(window_data_slot<void const*>{role}, static_cast<void const*>(data.value<void*>()));
+        return;
+    case WindowForceBlurRole:
+    case WindowForceBackgroundContrastRole:
+        set(window_data_slot<bool>{role}, data.toBool());
+        return;
+    case LanczosCacheRole:
+        qCWarning(KWIN_CORE) << "The Lanczos cache can only be set through its typed slot";
+        return;
+    default:
+        break;
+    }
+
+    if (index(role) < 0) {
+        m_variants.insert(role, data);
+    } else {
+        qCWarning(KWIN_CORE) << "Registered window data slot" << role << "has no QVariant access";
+    }
+}
+
+}
@@ -0,0 +1,141 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/render/effect/interface/types.h>
+#include <como_export.h>
+
+#include <QHash>
+#include <QVariant>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace como
+{
+
+class GLTexture;
+
+namespace effect
+{
+
+/**
+ * Typed slot of per-window effect data.
+ *
+ * Slots have fixed indices, so reading the data of a window neither hashes nor converts from
+ * QVariant. The built-in slots use the index of their DataRole. Through that scripts can still
+ * access them with the QVariant based EffectWindow::data() and EffectWindow::setData() calls.
+ */
+template<typename T>
+struct window_data_slot {
+    int role;
+};
+
+/**
+ * Roles of slots registered with register_window_data_slot() start here. They are not accessible
+ * through the QVariant API.
+ */
+constexpr int window_data_registered_role_start{0x10000};
+
+COMO_EXPORT int register_window_data_role();
+
+/**
+ * Registers a new slot that an effect can use to store data of type @a T with windows.
+ */
+template<typename T>
+window_data_slot<T> register_window_data_slot()
+{
+    return {register_window_data_role()};
+}
+
+namespace window_data
+{
+
+// The value of grab slots is the grabbing effect.
+constexpr window_data_slot<void const*> added_grab{WindowAddedGrabRole};
+constexpr window_data_slot<void const*> closed_grab{WindowClosedGrabRole};
+constexpr window_data_slot<void const*> minimized_grab{WindowMinimizedGrabRole};
+constexpr window_data_slot<void const*> unminimized_grab{WindowUnminimizedGrabRole};
+
+constexpr window_data_slot<bool> force_blur{WindowForceBlurRole};
+constexpr window_data_slot<bool> force_background_contrast{WindowForceBackgroundContrastRole};
+
+// The texture is deleted together with the window or when the slot is reset.
+constexpr window_data_slot<std::unique_ptr<GLTexture>> lanczos_cache{LanczosCacheRole};
+
+}
+
+class window_data_value_base
+{
+public:
+    virtual ~window_data_value_base() = default;
+    virtual QVariant variant() const = 0;
+};
+
+template<typename T>
+class window_data_value : public window_data_value_base
+{
+public:
+    explicit window_data_value(T value)
+        : value{std::move(value)}
+    {
+    }
+
+    QVariant variant() const override
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return QVariant(value);
+        } else if constexpr (std::is_pointer_v<T>) {
+            return QVariant::fromValue(const_cast<void*>(static_cast<void const*>(value)));
+        } else if constexpr (requires { value.get(); }) {
+            return QVariant::fromValue(static_cast<void*>(value.get()));
+        } else {
+            return {};
+        }
+    }
+
+    T value;
+};
+
+/**
+ * Storage of the effect data of one window.
+ */
+class COMO_EXPORT window_data_store
+{
+public:
+    template<typename T>
+    T const* get(window_data_slot<T> slot) const
+    {
+        auto value = find(slot.role);
+        return value ? &static_cast<window_data_value<T> const*>(value)->value : nullptr;
+    }
+
+    template<typename T>
+    void set(window_data_slot<T> slot, std::type_identity_t<T> value)
+    {
+        assign(slot.role, std::make_unique<window_data_value<T>>(std::move(value)));
+    }
+
+    void reset(int role);
+
+    /**
+     * QVariant access for scripts. Built-in slots are converted from and to their type. Other
+     * roles are stored as QVariant.
+     */
+    QVariant variant(int role) const;
+    void set_variant(int role, QVariant const& data);
+
+private:
+    static int index(int role);
+    window_data_value_base const* find(int role) const;
+    void assign(int role, std::unique_ptr<window_data_value_base> value);
+
+    std::vector<std::unique_ptr<window_data_value_base>> m_values;
+    QHash<int, QVariant> m_variants;
+};
+
+}
+}
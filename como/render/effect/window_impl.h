@@ -59,14 +59,7 @@ public:
             *window.ref_win);
     }
 
-    ~effects_window_impl() override
-    {
-        QVariant cachedTextureVariant = data(LanczosCacheRole);
-        if (cachedTextureVariant.isValid()) {
-            auto cachedTexture = static_cast<GLTexture*>(cachedTextureVariant.value<void*>());
-            delete cachedTexture;
-        }
-    }
+    ~effects_window_impl() override = default;
 
     void addRepaint(QRect const& rect) override
     {
@@ -270,7 +263,7 @@ public:
     QRect expandedGeometry() const override
     {
         return std::visit(
-            overload{[](auto&& ref_win) { return expanded_geometry_recursion(ref_win); }},
+            overload{[](auto&& ref_win) { return expanded_geometry_with_annexed(ref_win); }},
             *window.ref_win);
     }
 
@@ -872,20 +865,6 @@ public:
         effects->setElevatedWindow(this, elevate);
     }
 
-    void setData(int role, const QVariant& data) override
-    {
-        if (!data.isNull())
-            dataMap[role] = data;
-        else
-            dataMap.remove(role);
-        Q_EMIT effects->windowDataChanged(this, role);
-    }
-
-    QVariant data(int role) const override
-    {
-        return dataMap.value(role);
-    }
-
     Window& window;
 
 private:
@@ -903,18 +882,15 @@ private:
     }
 
     template<typename Win>
-    static QRect expanded_geometry_recursion(Win* window)
+    static QRect expanded_geometry_with_annexed(Win* window)
     {
-        QRect geo;
-        for (auto child : window->transient->children) {
-            if (child->transient->annexed) {
-                geo |= expanded_geometry_recursion(child);
-            }
+        auto geo = win::visible_rect(window);
+        for (auto child : window->transient->annexed_descendants()) {
+            geo |= win::visible_rect(child);
         }
-        return geo |= win::visible_rect(window);
+        return geo;
     }
 
-    QHash<int, QVariant> dataMap;
     bool managed = false;
     bool waylandClient{false};
     bool x11Client{false};
@@ -12,13 +12,34 @@ SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <QPluginLoader>
 #include <QStringList>
+#include <QtConcurrentMap>
 
 namespace como::render
 {
 
-plugin_effect_loader::plugin_effect_loader(KSharedConfig::Ptr config)
+namespace
+{
+
+void preload_library(KPluginMetaData const& info)
+{
+    if (info.isStaticPlugin()) {
+        return;
+    }
+
+    // The library stays loaded after the loader goes out of scope. Creating the factory later on
+    // reuses it.
+    QPluginLoader loader(info.fileName());
+    if (!loader.load()) {
+        qCDebug(KWIN_CORE) << "Could not preload" << info.pluginId() << loader.errorString();
+    }
+}
+
+}
+
+plugin_effect_loader::plugin_effect_loader(KSharedConfig::Ptr config, base::plugin_index& plugins)
     : basic_effect_loader(config)
     , m_pluginSubDirectory(QStringLiteral("kwin/effects/plugins"))
+    , plugins{plugins}
 {
 }
 
@@ -34,14 +55,7 @@ bool plugin_effect_loader::hasEffect(const QString& name) const
 
 KPluginMetaData plugin_effect_loader::findEffect(const QString& name) const
 {
-    const auto plugins
-        = KPluginMetaData::findPlugins(m_pluginSubDirectory, [name](const KPluginMetaData& data) {
-              return data.pluginId().compare(name, Qt::CaseInsensitive) == 0;
-          });
-    if (plugins.isEmpty()) {
-        return KPluginMetaData();
-    }
-    return plugins.first();
+    return plugins.find_plugin(m_pluginSubDirectory, name);
 }
 
 bool plugin_effect_loader::isEffectSupported(const QString& name) const
@@ -149,18 +163,26 @@ bool plugin_effect_loader::loadEffect(const KPluginMetaData& info, load_effect_f
 
 void plugin_effect_loader::queryAndLoadAll()
 {
-    auto const effects = findAllEffects();
-    for (auto const& effect : effects) {
+    std::vector<std::pair<KPluginMetaData, load_effect_flags>> effects;
+    for (auto const& effect : findAllEffects()) {
         auto const load_flags = readConfig(effect.pluginId(), effect.isEnabledByDefault());
         if (flags(load_flags & load_effect_flags::load)) {
-            loadEffect(effect, load_flags);
+            effects.push_back({effect, load_flags});
         }
     }
+
+    // Loading the libraries and resolving their symbols is independent of the compositor state.
+    // Do it in parallel before creating the effects on the main thread with the GL context.
+    QtConcurrent::blockingMap(effects, [](auto const& effect) { preload_library(effect.first); });
+
+    for (auto const& [effect, load_flags] : effects) {
+        loadEffect(effect, load_flags);
+    }
 }
 
-QVector<KPluginMetaData> plugin_effect_loader::findAllEffects() const
+QList<KPluginMetaData> plugin_effect_loader::findAllEffects() const
 {
-    return KPluginMetaData::findPlugins(m_pluginSubDirectory);
+    return plugins.plugins(m_pluginSubDirectory);
 }
 
 void plugin_effect_loader::setPluginSubDirectory(const QString& directory)
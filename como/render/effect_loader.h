@@ -9,6 +9,8 @@ SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "como_export.h"
 
+#include <como/base/plugin_index.h>
+
 #include <KPluginMetaData>
 #include <memory>
 #include <vector>
@@ -25,7 +27,7 @@ namespace render
 class COMO_EXPORT plugin_effect_loader : public basic_effect_loader
 {
 public:
-    explicit plugin_effect_loader(KSharedConfig::Ptr config);
+    plugin_effect_loader(KSharedConfig::Ptr config, base::plugin_index& plugins);
     ~plugin_effect_loader() override;
 
     bool hasEffect(const QString& name) const override;
@@ -40,11 +42,12 @@ public:
     void setPluginSubDirectory(const QString& directory);
 
 private:
-    QVector<KPluginMetaData> findAllEffects() const;
+    QList<KPluginMetaData> findAllEffects() const;
     KPluginMetaData findEffect(const QString& name) const;
     EffectPluginFactory* factory(const KPluginMetaData& info) const;
     QStringList m_loadedEffects;
     QString m_pluginSubDirectory;
+    base::plugin_index& plugins;
 };
 
 class COMO_EXPORT effect_loader : public basic_effect_loader
@@ -54,7 +57,8 @@ public:
     effect_loader(Platform& platform)
         : basic_effect_loader(platform.base.config.main)
     {
-        add_loader(std::make_unique<plugin_effect_loader>(platform.base.config.main));
+        add_loader(std::make_unique<plugin_effect_loader>(platform.base.config.main,
+                                                          platform.base.plugins));
     }
 
     ~effect_loader() override;
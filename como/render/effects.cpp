@@ -21,6 +21,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <como/render/gl/interface/framebuffer.h>
 #include <como/render/gl/interface/platform.h>
+#include <como/render/gl/interface/utils.h>
 
 #include <KDecoration2/DecorationSettings>
 
@@ -503,6 +504,17 @@ QStringList effects_handler_wrap::activeEffects() const
     return ret;
 }
 
+int effects_handler_wrap::loaded_effect_count() const
+{
+    return loaded_effects.size();
+}
+
+int effects_handler_wrap::active_effect_count() const
+{
+    // Effects active in the current or last painting pass.
+    return m_activeEffects.size();
+}
+
 Wrapland::Server::Display* effects_handler_wrap::waylandDisplay() const
 {
     return nullptr;
@@ -591,6 +603,8 @@ QImage effects_handler_wrap::blit_from_framebuffer(effect::render_data& data,
         return {};
     }
 
+    flush_deferred_draws();
+
     auto const screen_geometry = effect::map_to_viewport(data, geometry);
     auto const nativeSize = screen_geometry.size() * scale;
     QImage image(nativeSize, QImage::Format_ARGB32);
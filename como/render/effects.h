@@ -146,6 +146,8 @@ public:
 
     QList<EffectWindow*> elevatedWindows() const;
     QStringList activeEffects() const;
+    int loaded_effect_count() const;
+    int active_effect_count() const;
 
     Wrapland::Server::Display* waylandDisplay() const override;
 
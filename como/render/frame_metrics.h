@@ -0,0 +1,151 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/debug/perf/metrics.h>
+#include <como/render/gl/interface/texture.h>
+
+#include <QString>
+#include <chrono>
+#include <optional>
+
+namespace como::render
+{
+
+/**
+ * Performance metrics of painting and presenting frames on an output.
+ */
+struct frame_metrics {
+    explicit frame_metrics(QString const& output)
+        : frame_metrics(debug::metrics_registry::instance(), {{QStringLiteral("output"), output}})
+    {
+    }
+
+    ~frame_metrics()
+    {
+        // Outputs come and go, do not keep the series of removed ones.
+        registry.remove(labels);
+    }
+
+    frame_metrics(frame_metrics const&) = delete;
+    frame_metrics& operator=(frame_metrics const&) = delete;
+
+    /**
+     * Marks the begin of painting a frame.
+     */
+    void paint_begin()
+    {
+        uploaded_at_begin = GLTexture::uploadedBytes();
+    }
+
+    /**
+     * Records a painted frame. @a submitted is true if a buffer was submitted for presentation.
+     */
+    void paint_end(std::chrono::nanoseconds duration, bool submitted)
+    {
+        paint.observe(duration);
+        texture_upload.add(GLTexture::uploadedBytes() - uploaded_at_begin);
+
+        if (submitted) {
+            submit_time = std::chrono::steady_clock::now().time_since_epoch();
+        }
+    }
+
+    /**
+     * Records that the submitted buffer is presented or released for the next frame.
+     */
+    void swap_complete()
+    {
+        if (!submit_time) {
+            return;
+        }
+        swap_pending.observe(std::chrono::steady_clock::now().time_since_epoch() - *submit_time);
+    }
+
+    /**
+     * Records the presentation of a frame at @a when with a refresh cycle of @a refresh.
+     */
+    void presented(std::chrono::nanoseconds when, std::chrono::nanoseconds refresh)
+    {
+        frames.add();
+
+        // The targeted vblank is the first one after submitting the buffer.
+        if (submit_time && refresh.count() > 0 && when - *submit_time > refresh) {
+            missed_frames.add();
+        }
+        submit_time.reset();
+    }
+
+    void set_idle(bool idle)
+    {
+        auto const now = std::chrono::steady_clock::now();
+
+        if (idle && !idle_since) {
+            idle_since = now;
+        } else if (!idle && idle_since) {
+            idle_time.add(std::chrono::duration<double>(now - *idle_since).count());
+            idle_since.reset();
+        }
+    }
+
+    debug::metric_counter& frames;
+    debug::metric_counter& missed_frames;
+    debug::metric_histogram& paint;
+    debug::metric_histogram& render;
+    debug::metric_histogram& swap_pending;
+    debug::metric_counter& idle_time;
+    debug::metric_counter& texture_upload;
+    debug::metric_gauge& loaded_effects;
+    debug::metric_gauge& active_effects;
+
+private:
+    frame_metrics(debug::metrics_registry& registry, debug::metric_labels const& labels)
+        : frames{registry.counter(QStringLiteral("como_frames_presented_total"),
+                                  QStringLiteral("Frames presented on the output."),
+                                  labels)}
+        , missed_frames{registry.counter(
+              QStringLiteral("como_frames_missed_total"),
+              QStringLiteral("Frames presented later than one refresh cycle after submission."),
+              labels)}
+        , paint{registry.histogram(QStringLiteral("como_paint_duration_seconds"),
+                                   QStringLiteral("CPU time for painting a frame."),
+                                   debug::metric_histogram::frame_bounds(),
+                                   labels)}
+        , render{registry.histogram(QStringLiteral("como_render_duration_seconds"),
+                                    QStringLiteral("GPU time for rendering a frame."),
+                                    debug::metric_histogram::frame_bounds(),
+                                    labels)}
+        , swap_pending{registry.histogram(
+              QStringLiteral("como_swap_pending_seconds"),
+              QStringLiteral("Time from submitting a buffer until the next frame can be painted."),
+              debug::metric_histogram::frame_bounds(),
+              labels)}
+        , idle_time{registry.counter(QStringLiteral("como_idle_seconds_total"),
+                                     QStringLiteral("Time the output had nothing to paint."),
+                                     labels)}
+        , texture_upload{registry.counter(
+              QStringLiteral("como_texture_upload_bytes_total"),
+              QStringLiteral("Bytes uploaded from client memory into textures while painting."),
+              labels)}
+        , loaded_effects{registry.gauge(QStringLiteral("como_effects_loaded"),
+                                        QStringLiteral("Number of loaded effects."))}
+        , active_effects{
+              registry.gauge(QStringLiteral("como_effects_active"),
+                             QStringLiteral("Number of effects active in the last painted frame."))}
+        , registry{registry}
+        , labels{labels}
+    {
+    }
+
+    debug::metrics_registry& registry;
+    debug::metric_labels labels;
+
+    quint64 uploaded_at_begin{0};
+    std::optional<std::chrono::nanoseconds> submit_time;
+    std::optional<std::chrono::steady_clock::time_point> idle_since;
+};
+
+}
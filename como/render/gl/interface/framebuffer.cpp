@@ -114,6 +114,7 @@ void GLFramebuffer::bind()
         return;
     }
 
+    flush_deferred_draws();
     glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
     glViewport(mViewport.x(), mViewport.y(), mViewport.width(), mViewport.height());
 
@@ -44,6 +44,11 @@ public:
     QRect viewport() const;
     QSize size() const override;
 
+    GLuint handle() const
+    {
+        return mFramebuffer;
+    }
+
     bool valid() const
     {
         return mValid;
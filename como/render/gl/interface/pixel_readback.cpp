@@ -0,0 +1,113 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "pixel_readback.h"
+
+#include <como/base/logging.h>
+#include <como/render/gl/interface/platform.h>
+#include <como/render/gl/interface/utils.h>
+
+namespace como
+{
+
+GLPixelReadback::GLPixelReadback(QRect const& rect)
+    : m_size{rect.size()}
+{
+    glGenBuffers(1, &m_buffer);
+    if (!m_buffer) {
+        qCWarning(KWIN_CORE) << "Could not create pixel buffer for readback";
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, stride() * m_size.height(), nullptr, GL_STREAM_READ);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    // With a pixel pack buffer bound the data pointer is an offset into the buffer and the call
+    // returns without waiting on the GPU.
+    glReadPixels(rect.x(),
+                 rect.y(),
+                 rect.width(),
+                 rect.height(),
+                 GL_BGRA,
+                 GL_UNSIGNED_INT_8_8_8_8_REV,
+                 nullptr);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+GLPixelReadback::~GLPixelReadback()
+{
+    if (m_fence) {
+        glDeleteSync(m_fence);
+    }
+    if (m_buffer) {
+        unmap();
+        glDeleteBuffers(1, &m_buffer);
+    }
+}
+
+bool GLPixelReadback::supported()
+{
+    // Packing into BGRA is not available on GLES without extensions.
+    if (GLPlatform::instance()->isGLES()) {
+        return false;
+    }
+    return hasGLVersion(3, 2) || hasGLExtension(QByteArrayLiteral("GL_ARB_sync"));
+}
+
+bool GLPixelReadback::is_ready()
+{
+    if (!m_fence) {
+        // Without a fence we can only map and let the driver wait.
+        return true;
+    }
+
+    auto const status = glClientWaitSync(m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+
+    glDeleteSync(m_fence);
+    m_fence = nullptr;
+    return true;
+}
+
+uchar const* GLPixelReadback::map()
+{
+    if (!m_buffer) {
+        return nullptr;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+    auto data
+        = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, stride() * m_size.height(), GL_MAP_READ_BIT);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!data) {
+        qCWarning(KWIN_CORE) << "Could not map pixel buffer:" << formatGLError(glGetError());
+        return nullptr;
+    }
+
+    m_mapped = true;
+    return static_cast<uchar const*>(data);
+}
+
+void GLPixelReadback::unmap()
+{
+    if (!m_mapped) {
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_mapped = false;
+}
+
+}
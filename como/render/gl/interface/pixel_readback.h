@@ -0,0 +1,78 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como_export.h>
+#include <epoxy/gl.h>
+
+#include <QRect>
+#include <QSize>
+
+namespace como
+{
+
+/**
+ * Reads back pixels of the currently bound framebuffer into a pixel buffer object without waiting
+ * for the GPU to finish rendering.
+ *
+ * The GL implementation converts the pixels to the memory layout of QImage::Format_ARGB32 while
+ * packing them, so no conversion on the CPU is needed. Rows are stored in GL order, i.e. the
+ * bottom row of the read back rectangle comes first.
+ *
+ * Poll is_ready() and map the buffer once the readback has finished. The mapped memory can be
+ * accessed from any thread until unmap() is called, which must happen with the GL context current.
+ */
+class COMO_EXPORT GLPixelReadback
+{
+public:
+    /**
+     * Starts reading back @a rect in device coordinates of the currently bound framebuffer.
+     */
+    explicit GLPixelReadback(QRect const& rect);
+    ~GLPixelReadback();
+
+    GLPixelReadback(GLPixelReadback const&) = delete;
+    GLPixelReadback& operator=(GLPixelReadback const&) = delete;
+
+    /**
+     * Whether pixel buffer objects, fence syncs and BGRA packing are available.
+     */
+    static bool supported();
+
+    bool valid() const
+    {
+        return m_buffer != 0;
+    }
+
+    QSize size() const
+    {
+        return m_size;
+    }
+
+    int stride() const
+    {
+        return m_size.width() * 4;
+    }
+
+    /**
+     * Whether the GPU has finished writing the pixels to the buffer. Does not block.
+     */
+    bool is_ready();
+
+    /**
+     * Maps the buffer for reading. Returns nullptr on failure.
+     */
+    uchar const* map();
+    void unmap();
+
+private:
+    QSize m_size;
+    GLuint m_buffer{0};
+    GLsync m_fence{nullptr};
+    bool m_mapped{false};
+};
+
+}
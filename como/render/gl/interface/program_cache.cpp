@@ -0,0 +1,186 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "program_cache.h"
+
+#include <como/base/logging.h>
+#include <como/render/gl/interface/platform.h>
+#include <como/render/gl/interface/utils.h>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <cstring>
+
+namespace como
+{
+
+namespace
+{
+
+constexpr uint32_t binary_magic{0x31425043};
+
+struct binary_header {
+    uint32_t magic;
+    uint32_t format;
+};
+
+bool binaries_supported()
+{
+    if (GLPlatform::instance()->isGLES()) {
+        if (!hasGLVersion(3, 0)
+            && !hasGLExtension(QByteArrayLiteral("GL_OES_get_program_binary"))) {
+            return false;
+        }
+    } else if (!hasGLVersion(4, 1)
+               && !hasGLExtension(QByteArrayLiteral("GL_ARB_get_program_binary"))) {
+        return false;
+    }
+
+    // Drivers may support the API without supporting any binary format.
+    GLint formats{0};
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+}
+
+GLProgramCache::GLProgramCache(QString const& directory)
+    : m_directory{directory}
+{
+}
+
+std::unique_ptr<GLProgramCache> GLProgramCache::create()
+{
+    if (qEnvironmentVariableIsSet("KWIN_GL_PROGRAM_CACHE")
+        && !qEnvironmentVariableIntValue("KWIN_GL_PROGRAM_CACHE")) {
+        return {};
+    }
+    if (!binaries_supported()) {
+        qCDebug(KWIN_CORE) << "GL program binaries not supported, not caching programs";
+        return {};
+    }
+
+    auto const location = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (location.isEmpty()) {
+        return {};
+    }
+
+    auto gl = GLPlatform::instance();
+    QCryptographicHash driver(QCryptographicHash::Sha1);
+    driver.addData(gl->glVendorString());
+    driver.addData(gl->glRendererString());
+    driver.addData(gl->glVersionString());
+    driver.addData(gl->glShadingLanguageVersionString());
+
+    auto const directory = location + QStringLiteral("/como/gl-programs/")
+        + QString::fromLatin1(driver.result().toHex());
+    if (!QDir().mkpath(directory)) {
+        qCWarning(KWIN_CORE) << "Could not create GL program cache directory" << directory;
+        return {};
+    }
+
+    return std::make_unique<GLProgramCache>(directory);
+}
+
+QByteArray GLProgramCache::key(QByteArray const& vertexSource,
+                               QByteArray const& fragmentSource,
+                               QByteArray const& bindings)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(vertexSource);
+    hash.addData(QByteArrayView("\0", 1));
+    hash.addData(fragmentSource);
+    hash.addData(QByteArrayView("\0", 1));
+    hash.addData(bindings);
+    return hash.result().toHex();
+}
+
+QString GLProgramCache::filePath(QByteArray const& key) const
+{
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(key) + QStringLiteral(".bin");
+}
+
+bool GLProgramCache::load(GLuint program, QByteArray const& key)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    auto const data = file.readAll();
+    file.close();
+
+    binary_header header;
+    if (data.size() <= static_cast<qsizetype>(sizeof(header))) {
+        file.remove();
+        return false;
+    }
+
+    std::memcpy(&header, data.constData(), sizeof(header));
+    if (header.magic != binary_magic) {
+        file.remove();
+        return false;
+    }
+
+    glProgramBinary(
+        program, header.format, data.constData() + sizeof(header), data.size() - sizeof(header));
+
+    GLint status{0};
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        qCDebug(KWIN_CORE) << "Cached GL program binary rejected by the driver:" << key;
+        m_stats.rejected++;
+        file.remove();
+        return false;
+    }
+
+    m_stats.hits++;
+    m_stats.load_time += std::chrono::nanoseconds(timer.nsecsElapsed());
+    return true;
+}
+
+void GLProgramCache::prepare(GLuint program) const
+{
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void GLProgramCache::store(GLuint program,
+                           QByteArray const& key,
+                           std::chrono::nanoseconds compileTime)
+{
+    m_stats.misses++;
+    m_stats.compile_time += compileTime;
+
+    GLint length{0};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    QByteArray data(sizeof(binary_header) + length, Qt::Uninitialized);
+    GLenum format{0};
+    glGetProgramBinary(program, length, &length, &format, data.data() + sizeof(binary_header));
+    if (length <= 0) {
+        return;
+    }
+
+    binary_header const header{binary_magic, format};
+    std::memcpy(data.data(), &header, sizeof(header));
+    data.resize(sizeof(header) + length);
+
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(KWIN_CORE) << "Could not store GL program binary" << file.fileName();
+    }
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como_export.h>
+#include <epoxy/gl.h>
+
+#include <QByteArray>
+#include <QString>
+#include <chrono>
+#include <memory>
+
+namespace como
+{
+
+struct GLProgramCacheStats {
+    // Programs loaded from a cached binary.
+    int hits{0};
+    // Programs that had to be compiled.
+    int misses{0};
+    // Cached binaries the driver did not accept.
+    int rejected{0};
+
+    // Time spent compiling and linking on misses.
+    std::chrono::nanoseconds compile_time{0};
+    // Time spent loading binaries on hits.
+    std::chrono::nanoseconds load_time{0};
+
+    /**
+     * Estimated compile time saved through hits, based on the average compile time of misses.
+     */
+    std::chrono::nanoseconds saved_time() const
+    {
+        if (!misses) {
+            return {};
+        }
+        return compile_time / misses * hits - load_time;
+    }
+};
+
+/**
+ * On-disk cache of linked GL program binaries.
+ *
+ * Binaries are stored per driver, identified by the GL vendor, renderer and version strings, and
+ * keyed by a hash of the program sources. A binary the driver rejects, for example after a driver
+ * update without a version change, is removed and the program compiled again.
+ */
+class COMO_EXPORT GLProgramCache
+{
+public:
+    explicit GLProgramCache(QString const& directory);
+
+    /**
+     * Creates a cache in the user's cache location for the current driver. Returns null if program
+     * binaries are not supported or the cache is disabled with KWIN_GL_PROGRAM_CACHE=0.
+     */
+    static std::unique_ptr<GLProgramCache> create();
+
+    /**
+     * Key for a program with the given sources. The @a bindings must identify the attribute and
+     * fragment data locations that are bound before linking.
+     */
+    static QByteArray key(QByteArray const& vertexSource,
+                          QByteArray const& fragmentSource,
+                          QByteArray const& bindings);
+
+    /**
+     * Loads the binary for @a key into @a program. Returns true if the program is linked
+     * afterwards.
+     */
+    bool load(GLuint program, QByteArray const& key);
+
+    /**
+     * Must be called before linking a program that is stored afterwards.
+     */
+    void prepare(GLuint program) const;
+
+    /**
+     * Stores the binary of the linked @a program for @a key and accounts @a compileTime to it.
+     */
+    void store(GLuint program, QByteArray const& key, std::chrono::nanoseconds compileTime);
+
+    GLProgramCacheStats const& stats() const
+    {
+        return m_stats;
+    }
+
+private:
+    QString filePath(QByteArray const& key) const;
+
+    QString m_directory;
+    GLProgramCacheStats m_stats;
+};
+
+}
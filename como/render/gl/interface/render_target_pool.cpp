@@ -0,0 +1,245 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "render_target_pool.h"
+
+#include "framebuffer.h"
+#include "texture.h"
+
+#include <como/base/logging.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace como
+{
+
+namespace
+{
+
+uint64_t bytesPerPixel(GLenum internalFormat)
+{
+    switch (internalFormat) {
+    case GL_RGBA16F:
+    case GL_RGBA16:
+        return 8;
+    case GL_RGBA32F:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+int sizeClassDimension(int value)
+{
+    // Steps of an eighth of the enclosing power of two, so a texture is at most about a quarter
+    // larger than requested.
+    auto const power = std::bit_ceil(static_cast<unsigned>(value));
+    auto const step = std::max(32, static_cast<int>(power / 8));
+    return (value + step - 1) / step * step;
+}
+
+uint64_t defaultBudget()
+{
+    bool ok{false};
+    auto const mib = qEnvironmentVariableIntValue("KWIN_GL_RENDER_TARGET_BUDGET", &ok);
+    return static_cast<uint64_t>(ok && mib >= 0 ? mib : 64) * 1024 * 1024;
+}
+
+}
+
+struct GLRenderTarget::Entry {
+    std::unique_ptr<GLTexture> texture;
+    std::unique_ptr<GLFramebuffer> framebuffer;
+    GLRenderTargetPool::Fit fit;
+    uint64_t bytes;
+};
+
+GLRenderTarget::GLRenderTarget(std::unique_ptr<Entry> entry, QSize const& size)
+    : m_entry{std::move(entry)}
+    , m_size{size}
+{
+    updateFramebuffer();
+}
+
+GLRenderTarget::~GLRenderTarget()
+{
+    m_viewportFramebuffer.reset();
+
+    if (auto pool = GLRenderTargetPool::s_pool) {
+        pool->release(std::move(m_entry));
+    }
+}
+
+GLTexture* GLRenderTarget::texture() const
+{
+    return m_entry->texture.get();
+}
+
+GLFramebuffer* GLRenderTarget::framebuffer() const
+{
+    return m_viewportFramebuffer ? m_viewportFramebuffer.get() : m_entry->framebuffer.get();
+}
+
+QSize GLRenderTarget::size() const
+{
+    return m_size;
+}
+
+QSizeF GLRenderTarget::textureCoordScale() const
+{
+    auto const textureSize = m_entry->texture->size();
+    return {m_size.width() / static_cast<qreal>(textureSize.width()),
+            m_size.height() / static_cast<qreal>(textureSize.height())};
+}
+
+bool GLRenderTarget::resize(QSize const& size)
+{
+    if (size == m_size) {
+        return true;
+    }
+    if (m_entry->fit == GLRenderTargetPool::Fit::Exact
+        || GLRenderTargetPool::sizeClass(size) != m_entry->texture->size()) {
+        return false;
+    }
+
+    m_size = size;
+    updateFramebuffer();
+    return true;
+}
+
+void GLRenderTarget::updateFramebuffer()
+{
+    auto const textureSize = m_entry->texture->size();
+    if (m_size == textureSize) {
+        m_viewportFramebuffer.reset();
+        return;
+    }
+
+    // Renders into the part of the texture at the top in OpenGL coordinates. That is where the
+    // texture's y-flipping matrix maps the scaled normalized coordinates to.
+    auto const viewport = QRect(0, textureSize.height() - m_size.height(), m_size.width(),
+                                m_size.height());
+    m_viewportFramebuffer = std::make_unique<GLFramebuffer>(
+        m_entry->framebuffer->handle(), m_size, viewport);
+}
+
+GLRenderTargetPool* GLRenderTargetPool::s_pool = nullptr;
+
+GLRenderTargetPool* GLRenderTargetPool::instance()
+{
+    if (!s_pool) {
+        s_pool = new GLRenderTargetPool();
+    }
+    return s_pool;
+}
+
+void GLRenderTargetPool::cleanup()
+{
+    delete s_pool;
+    s_pool = nullptr;
+}
+
+GLRenderTargetPool::GLRenderTargetPool()
+    : m_budget{defaultBudget()}
+{
+}
+
+GLRenderTargetPool::~GLRenderTargetPool() = default;
+
+std::unique_ptr<GLRenderTarget>
+GLRenderTargetPool::acquire(QSize const& size, GLenum internalFormat, Fit fit)
+{
+    if (size.isEmpty()) {
+        return nullptr;
+    }
+
+    auto const textureSize = fit == Fit::Exact ? size : sizeClass(size);
+    m_stats.acquired++;
+
+    // Prefer the most recently released texture, which is the likeliest to be resident.
+    auto it = std::find_if(m_unused.rbegin(), m_unused.rend(), [&](auto const& entry) {
+        return entry->fit == fit && entry->texture->size() == textureSize
+            && entry->texture->internalFormat() == internalFormat;
+    });
+
+    std::unique_ptr<GLRenderTarget::Entry> entry;
+
+    if (it != m_unused.rend()) {
+        entry = std::move(*it);
+        m_unused.erase(std::next(it).base());
+        m_stats.pooledBytes -= entry->bytes;
+        m_stats.reused++;
+
+        entry->texture->set_content_transform(effect::transform_type::normal);
+    } else {
+        auto texture = std::make_unique<GLTexture>(internalFormat, textureSize);
+        if (texture->isNull()) {
+            qCWarning(KWIN_CORE) << "Failed to allocate render target of size" << textureSize;
+            return nullptr;
+        }
+
+        auto framebuffer = std::make_unique<GLFramebuffer>(texture.get());
+        if (!framebuffer->valid()) {
+            return nullptr;
+        }
+
+        entry = std::make_unique<GLRenderTarget::Entry>(GLRenderTarget::Entry{
+            std::move(texture),
+            std::move(framebuffer),
+            fit,
+            bytesPerPixel(internalFormat) * textureSize.width() * textureSize.height(),
+        });
+        m_stats.allocated++;
+    }
+
+    entry->texture->setFilter(GL_LINEAR);
+    entry->texture->setWrapMode(GL_CLAMP_TO_EDGE);
+    m_stats.usedBytes += entry->bytes;
+
+    return std::unique_ptr<GLRenderTarget>(new GLRenderTarget(std::move(entry), size));
+}
+
+QSize GLRenderTargetPool::sizeClass(QSize const& size)
+{
+    return {sizeClassDimension(size.width()), sizeClassDimension(size.height())};
+}
+
+uint64_t GLRenderTargetPool::budget() const
+{
+    return m_budget;
+}
+
+void GLRenderTargetPool::setBudget(uint64_t bytes)
+{
+    m_budget = bytes;
+    evict();
+}
+
+GLRenderTargetPoolStats const& GLRenderTargetPool::stats() const
+{
+    return m_stats;
+}
+
+void GLRenderTargetPool::release(std::unique_ptr<GLRenderTarget::Entry> entry)
+{
+    m_stats.usedBytes -= entry->bytes;
+    m_stats.pooledBytes += entry->bytes;
+    m_unused.push_back(std::move(entry));
+    evict();
+}
+
+void GLRenderTargetPool::evict()
+{
+    // Textures in use count against the budget too, so the pool shrinks while they are many.
+    auto it = m_unused.begin();
+    while (it != m_unused.end() && m_stats.pooledBytes + m_stats.usedBytes > m_budget) {
+        m_stats.pooledBytes -= (*it)->bytes;
+        m_stats.evicted++;
+        it = m_unused.erase(it);
+    }
+}
+
+}
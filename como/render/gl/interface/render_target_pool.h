@@ -0,0 +1,143 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como_export.h>
+#include <epoxy/gl.h>
+
+#include <QSize>
+#include <QSizeF>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace como
+{
+
+class GLFramebuffer;
+class GLRenderTargetPool;
+class GLTexture;
+
+struct GLRenderTargetPoolStats {
+    // Render targets handed out.
+    uint64_t acquired{0};
+    // Render targets handed out without allocating a texture.
+    uint64_t reused{0};
+    // Textures allocated for render targets.
+    uint64_t allocated{0};
+    // Unused textures freed to stay in budget.
+    uint64_t evicted{0};
+
+    // Estimated memory of unused textures kept in the pool.
+    uint64_t pooledBytes{0};
+    // Estimated memory of render targets currently in use.
+    uint64_t usedBytes{0};
+};
+
+/**
+ * Texture with a framebuffer rendering into it, lent from the render target pool. It is given
+ * back when destroyed.
+ *
+ * The texture may be larger than the requested size. The framebuffer then renders into the part
+ * of the texture that is sampled with normalized texture coordinates scaled by
+ * textureCoordScale().
+ */
+class COMO_EXPORT GLRenderTarget
+{
+public:
+    ~GLRenderTarget();
+
+    GLRenderTarget(GLRenderTarget const&) = delete;
+    GLRenderTarget& operator=(GLRenderTarget const&) = delete;
+
+    GLTexture* texture() const;
+    GLFramebuffer* framebuffer() const;
+
+    /**
+     * The requested size.
+     */
+    QSize size() const;
+
+    /**
+     * Scale of normalized texture coordinates to sample the requested size.
+     */
+    QSizeF textureCoordScale() const;
+
+    /**
+     * Changes the requested size without reallocating if the texture is of the size class of
+     * @a size. Returns false otherwise, in which case a new render target must be acquired.
+     */
+    bool resize(QSize const& size);
+
+private:
+    friend class GLRenderTargetPool;
+
+    struct Entry;
+    GLRenderTarget(std::unique_ptr<Entry> entry, QSize const& size);
+    void updateFramebuffer();
+
+    std::unique_ptr<Entry> m_entry;
+    std::unique_ptr<GLFramebuffer> m_viewportFramebuffer;
+    QSize m_size;
+};
+
+/**
+ * Pool of offscreen render targets shared by the scene and effects.
+ *
+ * Textures are allocated in size classes, so targets of similar sizes, for example of a window
+ * during an animation or an interactive resize, reuse the same texture. Unused textures are kept
+ * until the budget is exceeded, which is 64 MiB by default and can be changed with
+ * KWIN_GL_RENDER_TARGET_BUDGET in MiB. Must only be used with the compositing GL context current.
+ *
+ * The GL scene publishes the statistics in the metrics registry after each frame.
+ */
+class COMO_EXPORT GLRenderTargetPool
+{
+public:
+    enum class Fit {
+        // Texture of the size class. Users must sample with GLRenderTarget::textureCoordScale().
+        SizeClass,
+        // Texture of exactly the requested size.
+        Exact,
+    };
+
+    static GLRenderTargetPool* instance();
+    static void cleanup();
+
+    /**
+     * Lends a render target of @a size. Its content is undefined. Returns null if the texture
+     * could not be created.
+     */
+    std::unique_ptr<GLRenderTarget>
+    acquire(QSize const& size, GLenum internalFormat = GL_RGBA8, Fit fit = Fit::SizeClass);
+
+    /**
+     * Size of the texture allocated for a render target of @a size.
+     */
+    static QSize sizeClass(QSize const& size);
+
+    uint64_t budget() const;
+    void setBudget(uint64_t bytes);
+
+    GLRenderTargetPoolStats const& stats() const;
+
+private:
+    friend class GLRenderTarget;
+
+    GLRenderTargetPool();
+    ~GLRenderTargetPool();
+
+    void release(std::unique_ptr<GLRenderTarget::Entry> entry);
+    void evict();
+
+    std::vector<std::unique_ptr<GLRenderTarget::Entry>> m_unused;
+    uint64_t m_budget;
+    GLRenderTargetPoolStats m_stats;
+
+    static GLRenderTargetPool* s_pool;
+};
+
+}
@@ -8,13 +8,16 @@
 #include "shader_manager.h"
 
 #include "platform.h"
+#include "program_cache.h"
 
 #include <como/base/logging.h>
 #include <como/render/effect/interface/paint_data.h>
 #include <como/render/effect/interface/types.h>
 #include <como/render/gl/interface/shader.h>
+#include <como/render/gl/interface/utils.h>
 #include <como/render/gl/interface/vertex_buffer.h>
 
+#include <QElapsedTimer>
 #include <QFile>
 
 namespace como
@@ -37,6 +40,7 @@ void ShaderManager::cleanup()
 }
 
 ShaderManager::ShaderManager()
+    : m_programCache{GLProgramCache::create()}
 {
 }
 
@@ -45,6 +49,16 @@ ShaderManager::~ShaderManager()
     while (!m_boundShaders.empty()) {
         popShader();
     }
+
+    if (m_programCache) {
+        auto const& stats = m_programCache->stats();
+        qCDebug(KWIN_CORE) << "GL program cache hits:" << stats.hits << "misses:" << stats.misses
+                           << "rejected:" << stats.rejected << "saved:"
+                           << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  stats.saved_time())
+                                  .count()
+                           << "ms";
+    }
 }
 
 QByteArray ShaderManager::generateVertexSource(ShaderTraits traits) const
@@ -187,15 +201,7 @@ std::unique_ptr<GLShader> ShaderManager::generateCustomShader(ShaderTraits trait
     qCDebug(KWIN_CORE) << "**************";
 #endif
 
-    std::unique_ptr<GLShader> shader{new GLShader(GLShader::ExplicitLinking)};
-    shader->load(vertex, fragment);
-
-    shader->bindAttributeLocation("position", VA_Position);
-    shader->bindAttributeLocation("texcoord", VA_TexCoord);
-    shader->bindFragDataLocation("fragColor", 0);
-
-    shader->link();
-    return shader;
+    return createShader(vertex, fragment, "position", "texcoord");
 }
 
 static QString resolveShaderFilePath(const QString& filePath)
@@ -284,6 +290,8 @@ GLShader* ShaderManager::pushShader(ShaderTraits traits)
 
 void ShaderManager::pushShader(GLShader* shader)
 {
+    flush_deferred_draws();
+
     // only bind shader if it is not already bound
     if (shader != getBoundShader()) {
         shader->bind();
@@ -314,21 +322,68 @@ void ShaderManager::bindFragDataLocations(GLShader* shader)
     shader->bindFragDataLocation("fragColor", 0);
 }
 
-void ShaderManager::bindAttributeLocations(GLShader* shader) const
+std::unique_ptr<GLShader> ShaderManager::createShader(const QByteArray& vertexSource,
+                                                      const QByteArray& fragmentSource,
+                                                      const char* positionName,
+                                                      const char* texcoordName)
 {
-    shader->bindAttributeLocation("vertex", VA_Position);
-    shader->bindAttributeLocation("texCoord", VA_TexCoord);
+    std::unique_ptr<GLShader> shader{new GLShader(GLShader::ExplicitLinking)};
+
+    QByteArray key;
+    if (m_programCache) {
+        key = GLProgramCache::key(
+            vertexSource, fragmentSource, QByteArray(positionName) + ' ' + texcoordName);
+        if (m_programCache->load(shader->mProgram, key)) {
+            shader->mValid = true;
+            return shader;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    shader->load(vertexSource, fragmentSource);
+    shader->bindAttributeLocation(positionName, VA_Position);
+    shader->bindAttributeLocation(texcoordName, VA_TexCoord);
+    bindFragDataLocations(shader.get());
+
+    if (m_programCache) {
+        m_programCache->prepare(shader->mProgram);
+    }
+    if (shader->link() && m_programCache) {
+        m_programCache->store(
+            shader->mProgram, key, std::chrono::nanoseconds(timer.nsecsElapsed()));
+    }
+
+    return shader;
 }
 
 std::unique_ptr<GLShader> ShaderManager::loadShaderFromCode(const QByteArray& vertexSource,
                                                             const QByteArray& fragmentSource)
 {
-    std::unique_ptr<GLShader> shader{new GLShader(GLShader::ExplicitLinking)};
-    shader->load(vertexSource, fragmentSource);
-    bindAttributeLocations(shader.get());
-    bindFragDataLocations(shader.get());
-    shader->link();
-    return shader;
+    return createShader(vertexSource, fragmentSource, "vertex", "texCoord");
+}
+
+void ShaderManager::prewarm()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (auto traits : {ShaderTraits(ShaderTrait::MapTexture),
+                        ShaderTrait::MapTexture | ShaderTrait::Modulate,
+                        ShaderTrait::MapTexture | ShaderTrait::AdjustSaturation,
+                        ShaderTrait::MapTexture | ShaderTrait::Modulate
+                            | ShaderTrait::AdjustSaturation,
+                        ShaderTraits(ShaderTrait::UniformColor)}) {
+        shader(traits);
+    }
+
+    qCDebug(KWIN_CORE) << "Prewarmed shaders in" << timer.elapsed() << "ms";
+}
+
+GLProgramCacheStats const* ShaderManager::programCacheStats() const
+{
+    return m_programCache ? &m_programCache->stats() : nullptr;
 }
 
 }
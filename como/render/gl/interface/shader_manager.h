@@ -20,7 +20,9 @@
 namespace como
 {
 
+class GLProgramCache;
 class GLShader;
+struct GLProgramCacheStats;
 
 enum class ShaderTrait {
     MapTexture = (1 << 0),
@@ -141,6 +143,17 @@ public:
                                                      const QString& vertexFile = QString(),
                                                      const QString& fragmentFile = QString());
 
+    /**
+     * Creates the shaders for the trait combinations the scene uses when painting windows, so
+     * they are not compiled or loaded when the first window is painted.
+     */
+    void prewarm();
+
+    /**
+     * Statistics of the on-disk program binary cache, or null if programs are not cached.
+     */
+    GLProgramCacheStats const* programCacheStats() const;
+
     /**
      * @return a pointer to the ShaderManager instance
      */
@@ -156,7 +169,15 @@ private:
     ~ShaderManager();
 
     void bindFragDataLocations(GLShader* shader);
-    void bindAttributeLocations(GLShader* shader) const;
+
+    /**
+     * Creates a linked shader with @a positionName and @a texcoordName bound to the vertex
+     * attribute locations. The program is loaded from the program cache if possible.
+     */
+    std::unique_ptr<GLShader> createShader(const QByteArray& vertexSource,
+                                           const QByteArray& fragmentSource,
+                                           const char* positionName,
+                                           const char* texcoordName);
 
     QByteArray generateVertexSource(ShaderTraits traits) const;
     QByteArray generateFragmentSource(ShaderTraits traits) const;
@@ -164,6 +185,7 @@ private:
 
     std::stack<GLShader*> m_boundShaders;
     std::map<ShaderTraits, std::unique_ptr<GLShader>> m_shaderHash;
+    std::unique_ptr<GLProgramCache> m_programCache;
     static ShaderManager* s_shaderManager;
 };
 
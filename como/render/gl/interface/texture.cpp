@@ -41,6 +41,7 @@ bool GLTexturePrivate::s_supportsTextureSwizzle = false;
 bool GLTexturePrivate::s_supportsTextureFormatRG = false;
 bool GLTexturePrivate::s_supportsTexture16Bit = false;
 uint GLTexturePrivate::s_textureObjectCounter = 0;
+quint64 GLTexturePrivate::s_uploadedBytes = 0;
 uint GLTexturePrivate::s_fbo = 0;
 
 // Table of GL formats/types associated with different values of QImage::Format.
@@ -165,6 +166,7 @@ GLTexture::GLTexture(const QImage& image, GLenum target)
                          type,
                          im.constBits());
         }
+        GLTexturePrivate::s_uploadedBytes += im.sizeInBytes();
     } else {
         d_ptr->m_internalFormat = GL_RGBA8;
 
@@ -179,6 +181,7 @@ GLTexture::GLTexture(const QImage& image, GLenum target)
                          GL_BGRA_EXT,
                          GL_UNSIGNED_BYTE,
                          im.constBits());
+            GLTexturePrivate::s_uploadedBytes += im.sizeInBytes();
         } else {
             const QImage im = image.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
             glTexImage2D(d_ptr->m_target,
@@ -190,6 +193,7 @@ GLTexture::GLTexture(const QImage& image, GLenum target)
                          GL_RGBA,
                          GL_UNSIGNED_BYTE,
                          im.constBits());
+            GLTexturePrivate::s_uploadedBytes += im.sizeInBytes();
         }
     }
 
@@ -431,6 +435,7 @@ void GLTexture::update(const QImage& image, const QPoint& offset, const QRect& s
 
     glTexSubImage2D(
         d_ptr->m_target, 0, offset.x(), offset.y(), width, height, glFormat, type, im.constBits());
+    GLTexturePrivate::s_uploadedBytes += static_cast<quint64>(width) * height * (im.depth() / 8);
 
     unbind();
 
@@ -815,6 +820,11 @@ bool GLTexture::supportsFormatRG()
     return GLTexturePrivate::s_supportsTextureFormatRG;
 }
 
+quint64 GLTexture::uploadedBytes()
+{
+    return GLTexturePrivate::s_uploadedBytes;
+}
+
 QImage GLTexture::toImage() const
 {
     if (target() != GL_TEXTURE_2D) {
@@ -147,6 +147,11 @@ public:
      */
     static bool supportsFormatRG();
 
+    /**
+     * Returns the total number of bytes uploaded from client memory into textures.
+     */
+    static quint64 uploadedBytes();
+
 protected:
     std::unique_ptr<GLTexturePrivate> d_ptr;
     GLTexture(std::unique_ptr<GLTexturePrivate> impl);
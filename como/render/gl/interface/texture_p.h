@@ -75,6 +75,7 @@ public:
     static bool s_supportsTexture16Bit;
     static GLuint s_fbo;
     static uint s_textureObjectCounter;
+    static quint64 s_uploadedBytes;
 
 private:
     friend void como::cleanupGL();
@@ -16,6 +16,7 @@
 #include <como/render/effect/interface/paint_data.h>
 #include <como/render/effect/interface/types.h>
 #include <como/render/gl/interface/framebuffer.h>
+#include <como/render/gl/interface/render_target_pool.h>
 #include <como/render/gl/interface/shader_manager.h>
 #include <como/render/gl/interface/vertex_buffer.h>
 
@@ -24,6 +25,8 @@ namespace como
 // Variables
 // List of all supported GL extensions
 static QList<QByteArray> glExtensions;
+// Submits draws deferred by the scene
+static std::function<void()> deferred_draws_flush;
 
 // Functions
 
@@ -136,6 +139,7 @@ void initGL(const std::function<resolveFuncPtr(const char*)>& resolveFunction)
 
 void cleanupGL()
 {
+    GLRenderTargetPool::cleanup();
     ShaderManager::cleanup();
     GLTexturePrivate::cleanup();
     GLFramebuffer::cleanup();
@@ -160,6 +164,18 @@ QList<QByteArray> openGLExtensions()
     return glExtensions;
 }
 
+void set_deferred_draws_flush(std::function<void()> flush)
+{
+    deferred_draws_flush = std::move(flush);
+}
+
+void flush_deferred_draws()
+{
+    if (deferred_draws_flush) {
+        deferred_draws_flush();
+    }
+}
+
 QString formatGLError(GLenum err)
 {
     switch (err) {
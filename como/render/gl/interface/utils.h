@@ -12,6 +12,7 @@
 #include <QByteArray>
 #include <QList>
 #include <epoxy/gl.h>
+#include <functional>
 
 namespace como
 {
@@ -35,4 +36,10 @@ bool COMO_EXPORT checkGLError(const char* txt);
 
 QList<QByteArray> COMO_EXPORT openGLExtensions();
 
+// The compositing scene may defer window draws to submit them in batches. Anything that binds a
+// shader or a render target or reads back from it must call flush_deferred_draws() first, so the
+// deferred draws land in the right target and in the order they were issued in.
+void COMO_EXPORT set_deferred_draws_flush(std::function<void()> flush);
+void COMO_EXPORT flush_deferred_draws();
+
 }
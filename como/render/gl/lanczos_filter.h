@@ -101,8 +101,8 @@ public:
             scissor = data.paint.region;
         }
 
-        auto cachedTexture
-            = static_cast<GLTexture*>(eff_win.data(LanczosCacheRole).template value<void*>());
+        auto cache_slot = eff_win.data(effect::window_data::lanczos_cache);
+        auto cachedTexture = cache_slot ? cache_slot->get() : nullptr;
 
         if (cachedTexture) {
             if (cachedTexture->width() == tw && cachedTexture->height() == th) {
@@ -130,9 +130,8 @@ public:
                 return;
             } else {
                 // offscreen texture not matching - delete
-                delete cachedTexture;
                 cachedTexture = nullptr;
-                eff_win.setData(LanczosCacheRole, QVariant());
+                eff_win.resetData(effect::window_data::lanczos_cache);
             }
         }
 
@@ -300,7 +299,7 @@ public:
         glDisable(GL_BLEND);
 
         cache->unbind();
-        eff_win.setData(LanczosCacheRole, QVariant::fromValue(static_cast<void*>(cache)));
+        eff_win.setData(effect::window_data::lanczos_cache, std::unique_ptr<GLTexture>(cache));
 
         // Delete the offscreen surface after 5 seconds
         m_timer.start(5000, this);
@@ -404,10 +403,8 @@ private:
 
     void discardCacheTexture(EffectWindow* w)
     {
-        QVariant cachedTextureVariant = w->data(LanczosCacheRole);
-        if (cachedTextureVariant.isValid()) {
-            delete static_cast<GLTexture*>(cachedTextureVariant.value<void*>());
-            w->setData(LanczosCacheRole, QVariant());
+        if (w->data(effect::window_data::lanczos_cache)) {
+            w->resetData(effect::window_data::lanczos_cache);
         }
     }
 
@@ -0,0 +1,69 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/debug/perf/metrics.h>
+#include <como/render/gl/interface/render_target_pool.h>
+
+namespace como::render::gl
+{
+
+/**
+ * Statistics of the current render target pool. The pool is part of the render library, which
+ * cannot link the debug library, so the scene publishes its statistics after painting. They start
+ * again from zero when the pool is recreated with the GL context.
+ */
+struct render_target_pool_metrics {
+    static render_target_pool_metrics& instance()
+    {
+        static render_target_pool_metrics metrics(debug::metrics_registry::instance());
+        return metrics;
+    }
+
+    void update(GLRenderTargetPoolStats const& stats)
+    {
+        acquired.set(stats.acquired);
+        reused.set(stats.reused);
+        allocated.set(stats.allocated);
+        evicted.set(stats.evicted);
+        pooled_bytes.set(stats.pooledBytes);
+        used_bytes.set(stats.usedBytes);
+    }
+
+    debug::metric_gauge& acquired;
+    debug::metric_gauge& reused;
+    debug::metric_gauge& allocated;
+    debug::metric_gauge& evicted;
+    debug::metric_gauge& pooled_bytes;
+    debug::metric_gauge& used_bytes;
+
+private:
+    explicit render_target_pool_metrics(debug::metrics_registry& registry)
+        : acquired{targets(registry, QStringLiteral("acquired"))}
+        , reused{targets(registry, QStringLiteral("reused"))}
+        , allocated{targets(registry, QStringLiteral("allocated"))}
+        , evicted{targets(registry, QStringLiteral("evicted"))}
+        , pooled_bytes{bytes(registry, QStringLiteral("pooled"))}
+        , used_bytes{bytes(registry, QStringLiteral("used"))}
+    {
+    }
+
+    static debug::metric_gauge& targets(debug::metrics_registry& registry, QString const& event)
+    {
+        return registry.gauge(QStringLiteral("como_gl_render_targets"),
+                              QStringLiteral("Render target events of the current pool."),
+                              {{QStringLiteral("event"), event}});
+    }
+
+    static debug::metric_gauge& bytes(debug::metrics_registry& registry, QString const& state)
+    {
+        return registry.gauge(QStringLiteral("como_gl_render_target_bytes"),
+                              QStringLiteral("Estimated memory of render target textures."),
+                              {{QStringLiteral("state"), state}});
+    }
+};
+
+}
@@ -10,7 +10,9 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include "buffer.h"
 #include "deco_renderer.h"
 #include "lanczos_filter.h"
+#include "render_target_pool_metrics.h"
 #include "window.h"
+#include "window_batch.h"
 
 #include <como/base/logging.h>
 #include <como/base/options.h>
@@ -80,11 +82,17 @@ public:
             glBindVertexArray(vao);
         }
 
+        set_deferred_draws_flush([this] { batch.flush(); });
+
+        // Avoid compiling the window shaders while painting the first frame.
+        ShaderManager::instance()->prewarm();
+
         qCDebug(KWIN_CORE) << "OpenGL 2 compositing successfully initialized";
     }
 
     ~scene() override
     {
+        set_deferred_draws_flush({});
         makeOpenGLContextCurrent();
 
         // Need to reset early, otherwise the GL context is gone.
@@ -134,6 +142,7 @@ public:
         assert(render.targets.size() == 1);
 
         GLVertexBuffer::streamingBuffer()->endOfFrame();
+        render_target_pool_metrics::instance().update(GLRenderTargetPool::instance()->stats());
         m_backend->endRenderingFrameForScreen(output, valid, update);
 
         this->clearStackingOrder();
@@ -153,6 +162,14 @@ public:
         }
     }
 
+    void finalPaintScreen(paint_type mask, effect::screen_paint_data& data) override
+    {
+        abstract_type::finalPaintScreen(mask, data);
+
+        // Effects may read back from the render target once the scene has painted.
+        batch.flush();
+    }
+
     std::unique_ptr<render::shadow<window_t>> createShadow(window_t* win) override
     {
         return std::make_unique<shadow<window_t, type>>(win, *this);
@@ -273,6 +290,9 @@ public:
 
     std::unordered_map<uint32_t, gl_window_t*> windows;
 
+    /// Draws of untransformed windows with default state, submitted together.
+    window_batch batch;
+
 protected:
     std::unique_ptr<window_t> createWindow(typename window_t::ref_t ref_win) override
     {
@@ -10,6 +10,7 @@
 #include "buffer.h"
 #include "deco_renderer.h"
 #include "shadow.h"
+#include "window_batch.h"
 
 #include <como/render/window.h>
 #include <como/win/deco/client_impl.h>
@@ -82,6 +83,11 @@ public:
             return;
         }
 
+        if (is_batchable(mask, data)) {
+            add_to_batch(data);
+            return;
+        }
+
         auto shader = data.shader;
         if (!shader) {
             ShaderTraits traits = ShaderTrait::MapTexture;
@@ -106,38 +112,7 @@ public:
         shader->setUniform(GLShader::ModelViewProjectionMatrix, effect::get_mvp(data) * pos_matrix);
         shader->setUniform(GLShader::Saturation, data.paint.saturation);
 
-        std::vector<WindowQuadList> quads;
-        quads.resize(ContentLeaf + 1);
-        int last_content_id = this->id();
-
-        // TODO: remove again once we are sure that content ids never repeat.
-        auto content_ids = std::vector<int>{last_content_id};
-
-        // Split the quads into separate lists for each type
-        for (auto const& quad : std::as_const(data.quads)) {
-            switch (quad.type()) {
-            case WindowQuadShadow:
-                quads[ShadowLeaf].append(quad);
-                continue;
-
-            case WindowQuadDecoration:
-                quads[DecorationLeaf].append(quad);
-                continue;
-
-            case WindowQuadContents:
-                if (last_content_id != quad.id()) {
-                    assert(!contains(content_ids, quad.id()));
-                    // Content quads build chains in the list so an id never repeats itself.
-                    quads.resize(quads.size() + 1);
-                    last_content_id = quad.id();
-                }
-                quads.back().append(quad);
-                continue;
-
-            default:
-                continue;
-            }
-        }
+        auto quads = split_quads(data);
 
         bool has_previous_content = false;
         if (data.cross_fade_progress != 1.0) {
@@ -271,6 +246,94 @@ public:
     }
 
 private:
+    /**
+     * Splits the quads into separate lists for each leaf. Quads of annexed children follow the
+     * window's own content quads in additional lists.
+     */
+    std::vector<WindowQuadList> split_quads(effect::window_paint_data const& data) const
+    {
+        std::vector<WindowQuadList> quads;
+        quads.resize(ContentLeaf + 1);
+        int last_content_id = this->id();
+
+        // TODO: remove again once we are sure that content ids never repeat.
+        auto content_ids = std::vector<int>{last_content_id};
+
+        for (auto const& quad : std::as_const(data.quads)) {
+            switch (quad.type()) {
+            case WindowQuadShadow:
+                quads[ShadowLeaf].append(quad);
+                continue;
+
+            case WindowQuadDecoration:
+                quads[DecorationLeaf].append(quad);
+                continue;
+
+            case WindowQuadContents:
+                if (last_content_id != quad.id()) {
+                    assert(!contains(content_ids, quad.id()));
+                    // Content quads build chains in the list so an id never repeats itself.
+                    quads.resize(quads.size() + 1);
+                    last_content_id = quad.id();
+                }
+                quads.back().append(quad);
+                continue;
+
+            default:
+                continue;
+            }
+        }
+
+        return quads;
+    }
+
+    /**
+     * Windows painted without transformation and with default shader state only need a texture
+     * and an offset per leaf. These are collected by the scene and drawn together.
+     */
+    bool is_batchable(paint_type mask, effect::window_paint_data const& data) const
+    {
+        if (data.shader) {
+            return false;
+        }
+        if (flags(mask
+                  & (paint_type::window_transformed | paint_type::screen_transformed
+                     | paint_type::window_lanczos))) {
+            return false;
+        }
+        return data.paint.opacity == 1.0 && data.paint.brightness == 1.0
+            && data.paint.saturation == 1.0 && data.cross_fade_progress == 1.0;
+    }
+
+    void add_to_batch(effect::window_paint_data const& data)
+    {
+        auto quads = split_quads(data);
+
+        std::vector<LeafNode> nodes;
+        setupLeafNodes(nodes, quads, false, data);
+
+        auto const win_pos = std::visit(overload{[](auto&& ref_win) { return ref_win->geo.pos(); }},
+                                        *this->ref_win);
+
+        std::vector<window_batch::leaf> leaves;
+        leaves.reserve(quads.size());
+
+        for (size_t i = 0; i < quads.size(); i++) {
+            if (quads[i].isEmpty() || !nodes[i].texture) {
+                continue;
+            }
+            leaves.push_back({
+                .texture = nodes[i].texture,
+                .quads = std::move(quads[i]),
+                .coordinate_type = nodes[i].coordinateType,
+                .offset = win_pos,
+                .has_alpha = nodes[i].hasAlpha,
+            });
+        }
+
+        scene.batch.add(effect::get_mvp(data), data.render.targets.top(), std::move(leaves));
+    }
+
     GLTexture* getDecorationTexture() const
     {
         return std::visit(
@@ -0,0 +1,222 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/base/logging.h>
+#include <como/debug/perf/metrics.h>
+#include <como/render/effect/interface/window_quad.h>
+#include <como/render/gl/interface/shader.h>
+#include <como/render/gl/interface/shader_manager.h>
+#include <como/render/gl/interface/texture.h>
+#include <como/render/gl/interface/vertex_buffer.h>
+#include <como/render/interface/framebuffer.h>
+
+#include <QMatrix4x4>
+#include <QPoint>
+#include <QVector2D>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace como::render::gl
+{
+
+/**
+ * Performance metrics of batched window painting.
+ */
+struct window_batch_metrics {
+    static window_batch_metrics& instance()
+    {
+        static window_batch_metrics metrics(debug::metrics_registry::instance());
+        return metrics;
+    }
+
+    debug::metric_counter& windows;
+    debug::metric_counter& leaves;
+    debug::metric_counter& draw_calls;
+    debug::metric_counter& flushes;
+
+private:
+    explicit window_batch_metrics(debug::metrics_registry& registry)
+        : windows{registry.counter(QStringLiteral("como_gl_batch_windows_total"),
+                                   QStringLiteral("Windows added to a batch."))}
+        , leaves{registry.counter(QStringLiteral("como_gl_batch_leaves_total"),
+                                  QStringLiteral("Window leaves drawn in batches."))}
+        , draw_calls{registry.counter(QStringLiteral("como_gl_batch_draw_calls_total"),
+                                      QStringLiteral("Draw calls issued for batches."))}
+        , flushes{registry.counter(QStringLiteral("como_gl_batch_flushes_total"),
+                                   QStringLiteral("Batches submitted with one vertex upload."))}
+    {
+    }
+};
+
+/**
+ * Collects the leaves of windows that are painted without transformation and with default shader
+ * state. On flush all collected leaves are uploaded with a single vertex buffer mapping and drawn
+ * with one shader setup. Consecutive leaves sharing a texture are merged into one draw call.
+ *
+ * The scene registers flush() as deferred draws flush, such that the batch is submitted before
+ * anybody else binds a shader or a render target.
+ */
+class window_batch
+{
+public:
+    struct leaf {
+        GLTexture* texture;
+        WindowQuadList quads;
+        TextureCoordinateType coordinate_type;
+        // Offset of the window in the render target, quads are window-local.
+        QPoint offset;
+        bool has_alpha;
+    };
+
+    /**
+     * Whether the window with @p mvp painting into @p target can be added without flushing first.
+     */
+    bool accepts(QMatrix4x4 const& mvp, render::framebuffer* target) const
+    {
+        return leaves.empty() || (this->target == target && this->mvp == mvp);
+    }
+
+    void add(QMatrix4x4 const& mvp, render::framebuffer* target, std::vector<leaf>&& win_leaves)
+    {
+        if (!accepts(mvp, target)) {
+            flush();
+        }
+
+        this->mvp = mvp;
+        this->target = target;
+
+        leaves.reserve(leaves.size() + win_leaves.size());
+        std::move(win_leaves.begin(), win_leaves.end(), std::back_inserter(leaves));
+        metrics.windows.add();
+    }
+
+    void flush()
+    {
+        if (leaves.empty()) {
+            return;
+        }
+
+        // Move out first. Binding the shader below calls back into flush().
+        auto const batch = std::move(leaves);
+        leaves.clear();
+
+        auto const indexed_quads = GLVertexBuffer::supportsIndexedQuads();
+        auto const primitive_type = indexed_quads ? GL_QUADS : GL_TRIANGLES;
+        auto const vertices_per_quad = indexed_quads ? 4 : 6;
+
+        size_t quad_count{0};
+        for (auto const& leaf : batch) {
+            quad_count += leaf.quads.size();
+        }
+
+        ShaderBinder binder(ShaderTrait::MapTexture);
+        binder.shader()->setUniform(GLShader::ModelViewProjectionMatrix, mvp);
+
+        auto vbo = GLVertexBuffer::streamingBuffer();
+        vbo->reset();
+
+        constexpr std::array layout{
+            GLVertexAttrib{
+                .attributeIndex = VA_Position,
+                .componentCount = 2,
+                .type = GL_FLOAT,
+                .relativeOffset = offsetof(GLVertex2D, position),
+            },
+            GLVertexAttrib{
+                .attributeIndex = VA_TexCoord,
+                .componentCount = 2,
+                .type = GL_FLOAT,
+                .relativeOffset = offsetof(GLVertex2D, texcoord),
+            },
+        };
+        vbo->setAttribLayout(std::span(layout), sizeof(GLVertex2D));
+
+        auto map = vbo->map<GLVertex2D>(vertices_per_quad * quad_count);
+        if (!map) {
+            qCWarning(KWIN_CORE) << "Could not map vertices to perform batched paint";
+            return;
+        }
+
+        std::vector<int> first_vertices;
+        first_vertices.reserve(batch.size());
+
+        for (size_t i = 0, v = 0; i < batch.size(); i++) {
+            auto const& leaf = batch[i];
+            auto const count = leaf.quads.size() * vertices_per_quad;
+            auto vertices = (*map).subspan(v, count);
+
+            leaf.quads.makeInterleavedArrays(
+                primitive_type, vertices, leaf.texture->matrix(leaf.coordinate_type));
+
+            if (!leaf.offset.isNull()) {
+                QVector2D const offset(leaf.offset);
+                for (auto& vertex : vertices) {
+                    vertex.position += offset;
+                }
+            }
+
+            first_vertices.push_back(v);
+            v += count;
+        }
+
+        vbo->unmap();
+        vbo->bindArrays();
+
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        bool blending{false};
+
+        for (size_t i = 0; i < batch.size();) {
+            auto const& leaf = batch[i];
+            auto const first = first_vertices[i];
+            int count = leaf.quads.size() * vertices_per_quad;
+
+            // Merge following leaves that can be drawn with the same state.
+            for (i++; i < batch.size(); i++) {
+                if (batch[i].texture != leaf.texture || batch[i].has_alpha != leaf.has_alpha) {
+                    break;
+                }
+                count += batch[i].quads.size() * vertices_per_quad;
+            }
+
+            if (leaf.has_alpha != blending) {
+                if (leaf.has_alpha) {
+                    glEnable(GL_BLEND);
+                } else {
+                    glDisable(GL_BLEND);
+                }
+                blending = leaf.has_alpha;
+            }
+
+            leaf.texture->setFilter(GL_LINEAR);
+            leaf.texture->setWrapMode(GL_CLAMP_TO_EDGE);
+            leaf.texture->bind();
+
+            vbo->draw(primitive_type, first, count);
+            metrics.draw_calls.add();
+        }
+
+        vbo->unbindArrays();
+
+        if (blending) {
+            glDisable(GL_BLEND);
+        }
+
+        metrics.leaves.add(batch.size());
+        metrics.flushes.add();
+    }
+
+private:
+    window_batch_metrics& metrics{window_batch_metrics::instance()};
+    std::vector<leaf> leaves;
+    QMatrix4x4 mvp;
+    render::framebuffer* target{nullptr};
+};
+
+}
@@ -8,6 +8,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include "color_correct_dbus_interface.h"
 #include "color_correct_settings.h"
 #include "night_color_data.h"
+#include "night_color_ramps.h"
 #include "suncalc.h"
 
 #include <como/base/logging.h>
@@ -24,6 +25,8 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include <QDBusReply>
 #include <QObject>
 #include <QTimer>
+#include <algorithm>
+#include <map>
 #include <memory>
 
 namespace como::render::post
@@ -321,6 +324,9 @@ private:
     {
         cancel_all_timers();
 
+        // Outputs might have been added, removed or reset their gamma ramps in the meantime.
+        committed_ramps.clear();
+
         update_transition_timings(true);
         update_target_temperature();
 
@@ -360,9 +366,9 @@ private:
         auto const targetTemp = current_target_temp();
 
         if (data.temperature.current < targetTemp) {
-            nextTemp = qMin(data.temperature.current + TEMPERATURE_STEP, targetTemp);
+            nextTemp = qMin(data.temperature.current + quick_adjust_step, targetTemp);
         } else {
-            nextTemp = qMax(data.temperature.current - TEMPERATURE_STEP, targetTemp);
+            nextTemp = qMax(data.temperature.current - quick_adjust_step, targetTemp);
         }
         commit_gamma_ramps(nextTemp);
 
@@ -452,11 +458,12 @@ private:
             QObject::connect(
                 quick_adjust_timer, &QTimer::timeout, qobject.get(), [this] { quick_adjust(); });
 
-            int interval = QUICK_ADJUST_DURATION / (tempDiff / TEMPERATURE_STEP);
-            if (interval == 0) {
-                interval = 1;
-            }
-            quick_adjust_timer->start(interval);
+            // Steps faster than the outputs present frames are not visible. Instead the steps
+            // become larger.
+            auto const steps = std::max(
+                1, std::min(tempDiff / TEMPERATURE_STEP, QUICK_ADJUST_DURATION / frame_interval()));
+            quick_adjust_step = (tempDiff + steps - 1) / steps;
+            quick_adjust_timer->start(QUICK_ADJUST_DURATION / steps);
         } else {
             reset_slow_update_start_timer();
         }
@@ -499,13 +506,24 @@ private:
             // timeout
             int interval
                 = availTime * TEMPERATURE_STEP / qAbs(targetTemp - data.temperature.current);
-            if (interval == 0) {
-                interval = 1;
-            }
-            slow_update_timer->start(interval);
+            slow_update_timer->start(std::max(interval, frame_interval()));
         }
     }
 
+    /**
+     * Shortest time in ms between two frames on any output.
+     */
+    int frame_interval() const
+    {
+        int max_refresh{0};
+        for (auto output : base.outputs) {
+            max_refresh = std::max(max_refresh, output->refresh_rate());
+        }
+
+        // Refresh rates are in mHz.
+        return max_refresh > 0 ? std::max(1, 1000 * 1000 / max_refresh) : 1;
+    }
+
     int current_target_temp() const
     {
         if (!data.running) {
@@ -689,45 +707,21 @@ private:
                 continue;
             }
 
-            gamma_ramp ramp(rampsize);
-
-            /*
-             * The gamma calculation below is based on the Redshift app:
-             * https://github.com/jonls/redshift
-             */
-            uint16_t* red = ramp.red();
-            uint16_t* green = ramp.green();
-            uint16_t* blue = ramp.blue();
-
-            // linear default state
-            for (int i = 0; i < rampsize; i++) {
-                uint16_t value = static_cast<double>(i) / rampsize * (UINT16_MAX + 1);
-                red[i] = value;
-                green[i] = value;
-                blue[i] = value;
-            }
+            auto const& ramp = ramps.get(temperature, rampsize);
 
-            // approximate white point
-            float whitePoint[3];
-            float alpha = (temperature % 100) / 100.;
-            int bbCIndex = ((temperature - 1000) / 100) * 3;
-            whitePoint[0]
-                = (1. - alpha) * blackbody_color[bbCIndex] + alpha * blackbody_color[bbCIndex + 3];
-            whitePoint[1] = (1. - alpha) * blackbody_color[bbCIndex + 1]
-                + alpha * blackbody_color[bbCIndex + 4];
-            whitePoint[2] = (1. - alpha) * blackbody_color[bbCIndex + 2]
-                + alpha * blackbody_color[bbCIndex + 5];
-
-            for (int i = 0; i < rampsize; i++) {
-                red[i] = qreal(red[i]) / (UINT16_MAX + 1) * whitePoint[0] * (UINT16_MAX + 1);
-                green[i] = qreal(green[i]) / (UINT16_MAX + 1) * whitePoint[1] * (UINT16_MAX + 1);
-                blue[i] = qreal(blue[i]) / (UINT16_MAX + 1) * whitePoint[2] * (UINT16_MAX + 1);
+            if (auto it = committed_ramps.find(output);
+                it != committed_ramps.end() && it->second == ramp) {
+                // The quantized ramp of the output does not change with this temperature step.
+                set_current_temperature(temperature);
+                continue;
             }
 
             if (output->set_gamma_ramp(ramp)) {
+                committed_ramps.insert_or_assign(output, ramp);
                 set_current_temperature(temperature);
                 data.failed_commit_attempts = 0;
             } else {
+                committed_ramps.erase(output);
                 data.failed_commit_attempts++;
                 if (data.failed_commit_attempts < 10) {
                     qCWarning(KWIN_CORE).nospace()
@@ -793,6 +787,14 @@ private:
     QTimer* slow_update_timer{nullptr};
     QTimer* quick_adjust_timer{nullptr};
 
+    // Temperature change per quick adjust step. Steps are at most as frequent as frames.
+    int quick_adjust_step{TEMPERATURE_STEP};
+
+    night_color_ramps ramps;
+
+    // Last ramps set on the outputs.
+    std::map<typename Base::output_t const*, gamma_ramp> committed_ramps;
+
     Base& base;
 };
 
@@ -0,0 +1,89 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "constants.h"
+
+#include <como/utils/gamma_ramp.h>
+
+#include <QtGlobal>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace como::render::post
+{
+
+/**
+ * Creates the gamma ramp of @a size entries for a color @a temperature.
+ *
+ * The gamma calculation is based on the Redshift app: https://github.com/jonls/redshift
+ */
+inline gamma_ramp create_night_color_ramp(int temperature, uint32_t size)
+{
+    gamma_ramp ramp(size);
+
+    uint16_t* red = ramp.red();
+    uint16_t* green = ramp.green();
+    uint16_t* blue = ramp.blue();
+
+    // approximate white point
+    float whitePoint[3];
+    float alpha = (temperature % 100) / 100.;
+    int bbCIndex = ((temperature - 1000) / 100) * 3;
+    whitePoint[0]
+        = (1. - alpha) * blackbody_color[bbCIndex] + alpha * blackbody_color[bbCIndex + 3];
+    whitePoint[1]
+        = (1. - alpha) * blackbody_color[bbCIndex + 1] + alpha * blackbody_color[bbCIndex + 4];
+    whitePoint[2]
+        = (1. - alpha) * blackbody_color[bbCIndex + 2] + alpha * blackbody_color[bbCIndex + 5];
+
+    // Scale the linear default state in separate loops per channel without dependencies between
+    // the entries, so the compiler can vectorize them.
+    auto scale = [size](uint16_t* channel, float white) {
+        for (uint32_t i = 0; i < size; i++) {
+            uint16_t const value = static_cast<double>(i) / size * (UINT16_MAX + 1);
+            channel[i] = qreal(value) / (UINT16_MAX + 1) * white * (UINT16_MAX + 1);
+        }
+    };
+
+    scale(red, whitePoint[0]);
+    scale(green, whitePoint[1]);
+    scale(blue, whitePoint[2]);
+
+    return ramp;
+}
+
+/**
+ * Gamma ramps by color temperature and ramp size.
+ *
+ * Transitions step repeatedly through the same temperatures, so the ramps are created once and
+ * reused for all outputs with the same ramp size.
+ */
+class night_color_ramps
+{
+public:
+    gamma_ramp const& get(int temperature, uint32_t size)
+    {
+        auto const key = std::make_pair(size, temperature);
+        if (auto it = ramps.find(key); it != ramps.end()) {
+            return it->second;
+        }
+
+        if (ramps.size() >= max_count) {
+            ramps.clear();
+        }
+        return ramps.insert({key, create_night_color_ramp(temperature, size)}).first->second;
+    }
+
+    // More than the temperature steps between the minimum and the default day temperature.
+    static constexpr size_t max_count{256};
+
+private:
+    std::map<std::pair<uint32_t, int>, gamma_ramp> ramps;
+};
+
+}
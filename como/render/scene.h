@@ -319,7 +319,7 @@ public:
     }
 
     // called after all effects had their paintScreen() called
-    void finalPaintScreen(paint_type mask, effect::screen_paint_data& data)
+    virtual void finalPaintScreen(paint_type mask, effect::screen_paint_data& data)
     {
         if (flags(
                 mask
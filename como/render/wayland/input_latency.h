@@ -0,0 +1,218 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/base/wayland/input_latency.h>
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+namespace como::render::wayland
+{
+
+/**
+ * Histogram of durations with buckets sized for frame timings.
+ */
+struct latency_histogram {
+    // Upper bounds of the buckets in microseconds. A last bucket holds everything above.
+    static constexpr std::array<int64_t, 12> bounds_us{
+        500, 1000, 2000, 4000, 6000, 8000, 12000, 16700, 25000, 33400, 50000, 100000};
+
+    void add(std::chrono::nanoseconds duration)
+    {
+        if (duration < std::chrono::nanoseconds::zero()) {
+            duration = std::chrono::nanoseconds::zero();
+        }
+
+        auto const us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        size_t bucket{0};
+        while (bucket < bounds_us.size() && us > bounds_us[bucket]) {
+            bucket++;
+        }
+
+        counts[bucket]++;
+        count++;
+        sum += duration;
+        max = std::max(max, duration);
+    }
+
+    /**
+     * Upper bound of the bucket that holds the duration at @a fraction of all recorded ones. For
+     * durations above the last bound it is the maximum.
+     */
+    std::chrono::microseconds percentile(double fraction) const
+    {
+        if (!count) {
+            return {};
+        }
+
+        auto const rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * count)));
+        uint64_t cumulative{0};
+        for (size_t i = 0; i < bounds_us.size(); i++) {
+            cumulative += counts[i];
+            if (cumulative >= rank) {
+                return std::chrono::microseconds(bounds_us[i]);
+            }
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(max);
+    }
+
+    QJsonObject to_json() const
+    {
+        QJsonArray buckets;
+        for (size_t i = 0; i < counts.size(); i++) {
+            QJsonObject bucket;
+            if (i < bounds_us.size()) {
+                bucket[QStringLiteral("le_us")] = static_cast<qint64>(bounds_us[i]);
+            }
+            bucket[QStringLiteral("count")] = static_cast<qint64>(counts[i]);
+            buckets.append(bucket);
+        }
+
+        auto const to_us = [](auto duration) {
+            return static_cast<qint64>(
+                std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+        };
+
+        QJsonObject json;
+        json[QStringLiteral("count")] = static_cast<qint64>(count);
+        json[QStringLiteral("mean_us")] = count ? to_us(sum / count) : 0;
+        json[QStringLiteral("max_us")] = to_us(max);
+        json[QStringLiteral("p50_us")] = to_us(percentile(0.5));
+        json[QStringLiteral("p90_us")] = to_us(percentile(0.9));
+        json[QStringLiteral("p99_us")] = to_us(percentile(0.99));
+        json[QStringLiteral("buckets")] = buckets;
+        return json;
+    }
+
+    std::array<uint64_t, bounds_us.size() + 1> counts{};
+    uint64_t count{0};
+    std::chrono::nanoseconds sum{0};
+    std::chrono::nanoseconds max{0};
+};
+
+/**
+ * Input-to-photon latency of an output broken down into its stages.
+ */
+struct input_latency_stats {
+    void record(base::wayland::input_latency_mark const& input,
+                std::chrono::nanoseconds paint_begin,
+                std::chrono::nanoseconds paint_end,
+                std::chrono::nanoseconds presented)
+    {
+        queue.add(input.process_begin - input.event);
+        processing.add(input.process_end - input.process_begin);
+        wait.add(paint_begin - input.process_end);
+        paint.add(paint_end - paint_begin);
+        scanout.add(presented - paint_end);
+        total.add(presented - input.event);
+    }
+
+    QJsonObject to_json() const
+    {
+        QJsonObject json;
+        json[QStringLiteral("queue")] = queue.to_json();
+        json[QStringLiteral("processing")] = processing.to_json();
+        json[QStringLiteral("wait")] = wait.to_json();
+        json[QStringLiteral("paint")] = paint.to_json();
+        json[QStringLiteral("scanout")] = scanout.to_json();
+        json[QStringLiteral("total")] = total.to_json();
+        return json;
+    }
+
+    // From the kernel timestamp until the compositor starts processing the event.
+    latency_histogram queue;
+    // Spies, filters and sending the event to clients.
+    latency_histogram processing;
+    // From the end of processing until the output starts painting.
+    latency_histogram wait;
+    // Painting until the buffer is submitted.
+    latency_histogram paint;
+    // From buffer submission until presentation.
+    latency_histogram scanout;
+    latency_histogram total;
+};
+
+/**
+ * Input that is part of a frame not yet presented.
+ */
+struct input_latency_frame {
+    base::wayland::input_latency_mark input;
+    std::chrono::nanoseconds paint_begin;
+    std::chrono::nanoseconds paint_end;
+};
+
+/**
+ * Matches the inputs recorded by the tracker to the frames of an output that show them.
+ */
+class input_latency_matcher
+{
+public:
+    /**
+     * A frame painted from @a paint_begin to @a paint_end was submitted. It shows all inputs
+     * recorded until now.
+     */
+    void submitted(base::wayland::input_latency_tracker const& tracker,
+                   std::chrono::nanoseconds paint_begin,
+                   std::chrono::nanoseconds paint_end)
+    {
+        auto input = tracker.earliest_since(input_id);
+        input_id = tracker.last_id();
+
+        // A previous frame that was not presented got replaced. Its input is shown with this one.
+        if (pending && (!input || pending->input.event < input->event)) {
+            input = pending->input;
+        }
+        if (input) {
+            pending = {*input, paint_begin, paint_end};
+        }
+    }
+
+    /**
+     * The submitted frame was presented at @a when. Records the latency of its earliest input
+     * into @a stats, if it shows any new input.
+     */
+    void presented(std::chrono::nanoseconds when, input_latency_stats& stats)
+    {
+        if (!pending) {
+            return;
+        }
+
+        stats.record(pending->input, pending->paint_begin, pending->paint_end, when);
+        pending.reset();
+    }
+
+private:
+    // Last input shown in a submitted frame and the submitted frame awaiting presentation.
+    uint64_t input_id{0};
+    std::optional<input_latency_frame> pending;
+};
+
+template<typename Outputs>
+QJsonObject input_latency_report(Outputs const& outputs)
+{
+    QJsonObject report;
+    for (auto output : outputs) {
+        report[output->name()] = output->render->input_latency.to_json();
+    }
+    return report;
+}
+
+template<typename Outputs>
+void input_latency_reset(Outputs const& outputs)
+{
+    for (auto output : outputs) {
+        output->render->input_latency = {};
+    }
+}
+
+}
@@ -6,11 +6,13 @@
 #pragma once
 
 #include "duration_record.h"
+#include "input_latency.h"
 #include "presentation.h"
 
 #include <como/base/logging.h>
 #include <como/base/seat/session.h>
 #include <como/debug/perf/ftrace.h>
+#include <como/render/frame_metrics.h>
 #include <como/render/gl/scene.h>
 #include <como/render/gl/timer_query.h>
 #include <como/win/remnant.h>
@@ -56,6 +58,7 @@ public:
     output(Base& base, Platform& platform)
         : platform{platform}
         , base{base}
+        , metrics{base.name()}
         , index{++platform.output_index}
     {
     }
@@ -102,6 +105,7 @@ public:
                                                     }
                                                     render_time_debug = timer.time();
                                                     render_durations.update(timer.time());
+                                                    metrics.render.observe(timer.time());
                                                     return true;
                                                 }),
                                  last_timer_queries.end());
@@ -185,6 +189,10 @@ public:
         QElapsedTimer test_timer;
         test_timer.start();
 
+        if (!swap_pending && !platform.is_locked()) {
+            Q_EMIT base.qobject->about_to_paint();
+        }
+
         if (!prepare_run(repaints, windows)) {
             return;
         }
@@ -196,9 +204,20 @@ public:
         auto now_ns = std::chrono::steady_clock::now().time_since_epoch();
         auto now = std::chrono::duration_cast<std::chrono::milliseconds>(now_ns);
 
+        auto const& input_tracker = platform.base.input_latency;
+
         // Start the actual painting process.
+        metrics.paint_begin();
         auto const duration
             = std::chrono::nanoseconds(platform.scene->paint_output(&base, repaints, windows, now));
+        metrics.paint_end(duration, swap_pending);
+        metrics.loaded_effects.set(platform.effects->loaded_effect_count());
+        metrics.active_effects.set(platform.effects->active_effect_count());
+
+        if (swap_pending) {
+            input_latency_frames.submitted(
+                input_tracker, now_ns, std::chrono::steady_clock::now().time_since_epoch());
+        }
 
 #if SWAP_TIME_DEBUG
         qDebug().noquote() << "RUN gap:" << to_ms(now_ns - swap_ref_time)
@@ -254,6 +273,14 @@ public:
     {
         platform.presentation->presented(this, data);
         last_presentation = data;
+        base.startup.finish();
+        metrics.presented(data.when, data.refresh.count() > 0 ? data.refresh : refresh_length());
+
+        auto when = data.when;
+        if (!when.count()) {
+            when = std::chrono::steady_clock::now().time_since_epoch();
+        }
+        input_latency_frames.presented(when, input_latency);
     }
 
     void frame()
@@ -266,6 +293,7 @@ public:
             return;
         }
         swap_pending = false;
+        metrics.swap_complete();
 
         set_delay(last_presentation);
         delay_timer.stop();
@@ -283,6 +311,9 @@ public:
     QBasicTimer frame_timer;
     std::vector<render::gl::timer_query> last_timer_queries;
 
+    input_latency_stats input_latency;
+    frame_metrics metrics;
+
 private:
     template<typename Win>
     bool prepare_repaint(Win* win)
@@ -371,10 +402,9 @@ private:
                                    win = win::lead_of_annexed_transient(win);
                                }
 
-                               auto const texture = win->render->effect->data(LanczosCacheRole);
-                               if (texture.isValid()) {
-                                   delete static_cast<GLTexture*>(texture.template value<void*>());
-                                   win->render->effect->setData(LanczosCacheRole, QVariant());
+                               auto& eff_win = *win->render->effect;
+                               if (eff_win.data(effect::window_data::lanczos_cache)) {
+                                   eff_win.resetData(effect::window_data::lanczos_cache);
                                }
                            }
                        }},
@@ -393,6 +423,7 @@ private:
 
         if (repaints_region.isEmpty() && !has_window_repaints) {
             idle = true;
+            metrics.set_idle(true);
             platform.check_idle();
 
             // This means the next time we composite it is done without timer delay.
@@ -406,6 +437,7 @@ private:
         }
 
         idle = false;
+        metrics.set_idle(false);
         auto const screen_lock_filtered
             = win::wayland::screen_lock_is_locked(*platform.base.mod.space);
 
@@ -484,6 +516,8 @@ private:
     std::chrono::nanoseconds swap_ref_time{};
 
     QRegion repaints_region;
+
+    input_latency_matcher input_latency_frames;
 };
 
 }
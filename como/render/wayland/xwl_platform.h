@@ -5,9 +5,11 @@
 */
 #pragma once
 
+#include <como/debug/perf/metrics_service.h>
 #include <como/render/backend/wlroots/backend.h>
 #include <como/render/compositor.h>
 #include <como/render/dbus/compositing.h>
+#include <como/render/dbus/input_latency.h>
 #include <como/render/gl/backend.h>
 #include <como/render/gl/egl_data.h>
 #include <como/render/gl/scene.h>
@@ -54,6 +56,8 @@ public:
                 base.server->display.get());
         })}
         , dbus{std::make_unique<dbus::compositing<type>>(*this)}
+        , input_latency{std::make_unique<dbus::input_latency<type>>(*this)}
+        , metrics_service{std::make_unique<debug::metrics_service>()}
     {
         singleton_interface::get_egl_data = [this] { return egl_data; };
 
@@ -318,6 +322,8 @@ public:
 private:
     int locked{0};
     std::unique_ptr<dbus::compositing<type>> dbus;
+    std::unique_ptr<dbus::input_latency<type>> input_latency;
+    std::unique_ptr<debug::metrics_service> metrics_service;
 };
 
 }
@@ -19,6 +19,8 @@
 
 #include <functional>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace como::render
 {
@@ -331,6 +333,62 @@ protected:
     }
 
     WindowQuadList makeContentsQuads(int id, QPoint const& offset = QPoint()) const
+    {
+        auto quads = makeSurfaceQuads(id, offset);
+        if (quads.isEmpty()) {
+            return quads;
+        }
+
+        std::visit(overload{[&](auto&& ref_win) {
+                       using win_t = std::remove_reference_t<decltype(ref_win)>;
+
+                       // Descendants are skipped together with their own annexed descendants.
+                       std::vector<win_t> skipped;
+
+                       for (auto child : ref_win->transient->annexed_descendants()) {
+                           auto lead = child->transient->lead();
+                           if (contains(skipped, lead)) {
+                               skipped.push_back(child);
+                               continue;
+                           }
+                           if (child->remnant && !lead->remnant) {
+                               // When the child is a remnant but the parent not there is no
+                               // guarentee the ref_win will become one too what can cause
+                               // artficats before the child cleanup timer fires.
+                               skipped.push_back(child);
+                               continue;
+                           }
+                           auto& sw = child->render;
+                           if (!sw) {
+                               skipped.push_back(child);
+                               continue;
+                           }
+
+                           using buffer_t = buffer<type>;
+                           if (auto const buf = sw->template get_buffer<buffer_t>();
+                               !buf || !buf->isValid()) {
+                               skipped.push_back(child);
+                               continue;
+                           }
+
+                           auto child_quads = sw->makeSurfaceQuads(
+                               sw->id(), offset + child->geo.pos() - ref_win->geo.pos());
+                           if (child_quads.isEmpty()) {
+                               skipped.push_back(child);
+                               continue;
+                           }
+                           quads << child_quads;
+                       }
+                   }},
+                   *ref_win);
+
+        return quads;
+    }
+
+    /**
+     * Quads of the window's own surface without its annexed descendants.
+     */
+    WindowQuadList makeSurfaceQuads(int id, QPoint const& offset) const
     {
         QRegion contentsRegion;
         qreal textureScale{1.};
@@ -393,34 +451,6 @@ protected:
                 quads << createQuad(contentsRect, sourceRect);
             }
         }
-
-        std::visit(overload{[&](auto&& ref_win) {
-                       for (auto child : ref_win->transient->children) {
-                           if (!child->transient->annexed) {
-                               return;
-                           }
-                           if (child->remnant && !ref_win->remnant) {
-                               // When the child is a remnant but the parent not there is no
-                               // guarentee the ref_win will become one too what can cause
-                               // artficats before the child cleanup timer fires.
-                               return;
-                           }
-                           auto& sw = child->render;
-                           if (!sw) {
-                               return;
-                           }
-
-                           using buffer_t = buffer<type>;
-                           if (auto const buf = sw->template get_buffer<buffer_t>();
-                               !buf || !buf->isValid()) {
-                               return;
-                           }
-                           quads << sw->makeContentsQuads(
-                               sw->id(), offset + child->geo.pos() - ref_win->geo.pos());
-                       }
-                   }},
-                   *ref_win);
-
         return quads;
     }
 
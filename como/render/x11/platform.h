@@ -12,9 +12,11 @@
 // TODO(romangg): This header should only be included when linking against the debug library. But
 //                then we also need to comment out the calls below.
 #include <como/debug/perf/ftrace.h>
+#include <como/debug/perf/metrics_service.h>
 
 #include <como/render/backend/x11/deco_renderer.h>
 #include <como/render/dbus/compositing.h>
+#include <como/render/frame_metrics.h>
 #include <como/render/gl/backend.h>
 #include <como/render/gl/egl_data.h>
 #include <como/render/gl/scene.h>
@@ -86,6 +88,7 @@ public:
         , m_suspended(options->qobject->isUseCompositing() ? suspend_reason::none
                                                            : suspend_reason::user)
         , dbus{std::make_unique<dbus::compositing<type>>(*this)}
+        , metrics_service{std::make_unique<debug::metrics_service>()}
     {
         singleton_interface::get_egl_data = [this] { return egl_data; };
 
@@ -261,6 +264,10 @@ public:
             return;
         }
         m_bufferSwapPending = false;
+        base.startup.finish();
+        metrics.swap_complete();
+        metrics.presented(std::chrono::steady_clock::now().time_since_epoch(),
+                          std::chrono::nanoseconds(refreshLength()));
 
         // We delay the next paint shortly before next vblank. For that we assume that the swap
         // event is close to the actual vblank (TODO: it would be better to take the actual flip
@@ -462,6 +469,7 @@ public:
         auto const now_ns = std::chrono::steady_clock::now().time_since_epoch();
         auto const now = std::chrono::duration_cast<std::chrono::milliseconds>(now_ns);
 
+        metrics.paint_begin();
         for (auto output : base.outputs) {
             // TODO(romangg): Only paint windows that intersect output.
             duration += scene->paint_output(output, repaints & output->geometry(), windows, now);
@@ -469,6 +477,15 @@ public:
 
         scene->end_paint();
 
+        metrics.paint_end(std::chrono::nanoseconds(duration), true);
+        metrics.loaded_effects.set(effects->loaded_effect_count());
+        metrics.active_effects.set(effects->active_effect_count());
+        if (!scene->hasSwapEvent()) {
+            // Without swap events the frame is assumed to be presented right away.
+            metrics.presented(std::chrono::steady_clock::now().time_since_epoch(),
+                              std::chrono::nanoseconds(refreshLength()));
+        }
+
         this->update_paint_periods(duration);
         create_opengl_safepoint(opengl_safe_point::post_frame);
         this->retard_next_composition();
@@ -546,6 +563,9 @@ public:
     std::unique_ptr<render::post::night_color_manager<Base>> night_color;
     gl::egl_data* egl_data{nullptr};
 
+    // All outputs are painted at once.
+    frame_metrics metrics{QStringLiteral("X11")};
+
 private:
     int refreshRate() const
     {
@@ -655,10 +675,9 @@ private:
             assert(window->render);
             assert(window->render->effect);
 
-            auto const texture = window->render->effect->data(LanczosCacheRole);
-            if (texture.isValid()) {
-                delete static_cast<GLTexture*>(texture.template value<void*>());
-                window->render->effect->setData(LanczosCacheRole, QVariant());
+            auto& eff_win = *window->render->effect;
+            if (eff_win.data(effect::window_data::lanczos_cache)) {
+                eff_win.resetData(effect::window_data::lanczos_cache);
             }
         };
 
@@ -681,6 +700,7 @@ private:
             // If no repaint regions got added and no window has pending repaints, return and skip
             // this paint cycle.
             this->scene->idle();
+            metrics.set_idle(true);
 
             // This means the next time we composite it is done without timer delay.
             this->m_delay = 0;
@@ -689,6 +709,7 @@ private:
 
         // Clear all repaints, so that post-pass can add repaints for the next repaint
         this->repaints_region = {};
+        metrics.set_idle(false);
         return true;
     }
 
@@ -754,6 +775,7 @@ private:
     int m_framesToTestForSafety{3};
 
     std::unique_ptr<dbus::compositing<type>> dbus;
+    std::unique_ptr<debug::metrics_service> metrics_service;
 
     // 2 sec which should be enough to restart the compositor.
     constexpr static auto compositor_lost_message_delay{2000};
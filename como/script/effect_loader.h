@@ -12,12 +12,9 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include <como/render/effect/effect_load_queue.h>
 #include <como/script/quick_scene_effect.h>
 
-#include <KPackage/PackageLoader>
 #include <KPluginMetaData>
-#include <QFutureWatcher>
 #include <QQmlComponent>
 #include <QQmlEngine>
-#include <QtConcurrentRun>
 #include <string_view>
 
 namespace como::scripting
@@ -66,35 +63,18 @@ public:
 
     void clear() override
     {
-        disconnect(query_connection);
-        query_connection = QMetaObject::Connection();
         load_queue->clear();
     }
 
     void queryAndLoadAll() override
     {
-        // perform querying for the services in a thread
-        auto watcher = new QFutureWatcher<QList<KPluginMetaData>>(this);
-
-        query_connection = connect(
-            watcher,
-            &QFutureWatcher<QList<KPluginMetaData>>::finished,
-            this,
-            [this, watcher]() {
-                auto const effects = watcher->result();
-                for (auto const& effect : effects) {
-                    auto const load_flags
-                        = readConfig(effect.pluginId(), effect.isEnabledByDefault());
-                    if (flags(load_flags & render::load_effect_flags::load)) {
-                        load_queue->enqueue(qMakePair(effect, load_flags));
-                    }
-                }
-                watcher->deleteLater();
-                query_connection = QMetaObject::Connection();
-            },
-            Qt::QueuedConnection);
-
-        watcher->setFuture(QtConcurrent::run(&effect_loader::findAllEffects, this));
+        // The packages are listed from the plugin index. Only creating the effects is queued.
+        for (auto const& effect : findAllEffects()) {
+            auto const load_flags = readConfig(effect.pluginId(), effect.isEnabledByDefault());
+            if (flags(load_flags & render::load_effect_flags::load)) {
+                load_queue->enqueue(qMakePair(effect, load_flags));
+            }
+        }
     }
 
     bool loadEffect(QString const& name) override
@@ -140,22 +120,15 @@ private:
 
     QList<KPluginMetaData> findAllEffects() const
     {
-        return KPackage::PackageLoader::self()->listPackages(
-            QString::fromStdString(std::string(s_serviceType)), QStringLiteral("kwin/effects"));
+        return render.base.plugins.packages(QString::fromStdString(std::string(s_serviceType)),
+                                            QStringLiteral("kwin/effects"));
     }
 
     KPluginMetaData findEffect(QString const& name) const
     {
-        auto const plugins = KPackage::PackageLoader::self()->findPackages(
-            QString::fromStdString(std::string(s_serviceType)),
-            QStringLiteral("kwin/effects"),
-            [name](const KPluginMetaData& metadata) {
-                return metadata.pluginId().compare(name, Qt::CaseInsensitive) == 0;
-            });
-        if (!plugins.isEmpty()) {
-            return plugins.first();
-        }
-        return KPluginMetaData();
+        return render.base.plugins.find_package(QString::fromStdString(std::string(s_serviceType)),
+                                                QStringLiteral("kwin/effects"),
+                                                name);
     }
 
     bool loadJavascriptEffect(KPluginMetaData const& effect)
@@ -222,7 +195,6 @@ private:
     EffectsHandler& effects;
     Render& render;
     render::effect_load_queue<effect_loader, KPluginMetaData>* load_queue;
-    QMetaObject::Connection query_connection;
 };
 
 template<typename Render>
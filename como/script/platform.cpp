@@ -11,7 +11,6 @@
 #include <como/base/config.h>
 
 #include <KConfigGroup>
-#include <KPackage/PackageLoader>
 #include <QDBusConnection>
 #include <QFutureWatcher>
 #include <QMenu>
@@ -25,10 +24,12 @@ platform_wrap::platform_wrap(base::options& options,
                              win::options& win_opts,
                              render::options& render_opts,
                              base::config& config,
+                             base::plugin_index& plugins,
                              QQmlEngine& engine)
     : qml_engine{engine}
     , declarative_script_shared_context(new QQmlContext(&engine, this))
     , config{config}
+    , plugins{plugins}
     , options{std::make_unique<scripting::options>(options, win_opts, render_opts)}
     , m_scriptsLock(new QRecursiveMutex)
 {
@@ -73,14 +74,14 @@ LoadScriptList platform_wrap::queryScriptsToLoad()
 {
     if (is_running) {
         config.main->reparseConfiguration();
+        plugins.refresh();
     } else {
         is_running = true;
     }
 
     QMap<QString, QString> pluginStates = KConfigGroup(config.main, "Plugins").entryMap();
     const QString scriptFolder = QStringLiteral("kwin/scripts/");
-    const auto offers = KPackage::PackageLoader::self()->listPackages(QStringLiteral("KWin/Script"),
-                                                                      scriptFolder);
+    auto const offers = plugins.packages(QStringLiteral("KWin/Script"), scriptFolder);
     LoadScriptList scriptsToLoad;
 
     for (const KPluginMetaData& service : offers) {
@@ -23,6 +23,7 @@
 #include <como/script/desktop_background_item.h>
 
 #include <como/base/como_export.h>
+#include <como/base/plugin_index.h>
 #include <como/render/effect/interface/quick_scene.h>
 #include <como/script/gesture_handler.h>
 #include <como/script/quick_scene_effect.h>
@@ -61,6 +62,7 @@ public:
                   win::options& win_opts,
                   render::options& render_opts,
                   base::config& config,
+                  base::plugin_index& plugins,
                   QQmlEngine& engine);
     ~platform_wrap() override;
 
@@ -85,6 +87,7 @@ public:
     QQmlEngine& qml_engine;
     QQmlContext* declarative_script_shared_context;
     base::config& config;
+    base::plugin_index& plugins;
     std::unique_ptr<scripting::options> options;
 
 public Q_SLOTS:
@@ -119,6 +122,7 @@ public:
                         *space.options,
                         *space.base.mod.render->options,
                         space.base.config,
+                        space.base.plugins,
                         *space.qml_engine)
         , space{space}
     {
@@ -85,6 +85,8 @@ public:
         return m_table.data() + 2 * m_size;
     }
 
+    bool operator==(gamma_ramp const& other) const = default;
+
 private:
     std::vector<uint16_t> m_table;
     uint32_t m_size;
@@ -273,7 +273,7 @@ private:
 
     void initPlugin()
     {
-        const KPluginMetaData metaData = KPluginMetaData::findPluginById(s_pluginName, m_plugin);
+        auto const metaData = space.base.plugins.find_plugin(s_pluginName, m_plugin);
         if (!metaData.isValid()) {
             qCWarning(KWIN_CORE) << "Could not locate decoration plugin" << m_plugin;
             return;
@@ -10,6 +10,7 @@
 #include "geo.h"
 #include "geo_block.h"
 #include "geo_move.h"
+#include "snap_index.h"
 #include "window_area.h"
 
 namespace como::win
@@ -398,8 +399,6 @@ QPoint adjust_window_position(Space const& space,
         int deltaX(xmax);
         int deltaY(ymax); // minimum distance to other clients
 
-        int lx, ly, lrx, lry; // coords and size for the comparison client, l
-
         // border snap
         const int snapX = borderSnapZone.width() * snapAdjust; // snap trigger
         const int snapY = borderSnapZone.height() * snapAdjust;
@@ -463,95 +462,106 @@ QPoint adjust_window_position(Space const& space,
         // windows snap
         int snap = space.options->qobject->windowSnapZone() * snapAdjust;
         if (snap) {
-            for (auto win : space.windows) {
-                std::visit(overload{[&](auto&& win) {
-                               if (!win->control) {
-                                   return;
-                               }
-                               if constexpr (std::is_same_v<std::decay_t<decltype(win)>, Win*>) {
-                                   if (win == &window) {
-                                       return;
-                                   }
-                               }
-                               if (win->control->minimized) {
-                                   return;
-                               }
-                               if (!win->isShown()) {
-                                   return;
-                               }
-                               if (!on_subspace(*win, get_subspace(window))
-                                   && !on_subspace(window, get_subspace(*win))) {
-                                   // wrong subspace
-                                   return;
-                               }
-                               if (is_desktop(win) || is_splash(win) || is_applet_popup(win)) {
-                                   return;
-                               }
-
-                               lx = win->geo.pos().x();
-                               ly = win->geo.pos().y();
-                               lrx = lx + win->geo.size().width();
-                               lry = ly + win->geo.size().height();
-                           }},
-                           win);
-
-                if (!flags(guideMaximized & maximize_mode::horizontal)
-                    && (((cy <= lry) && (cy >= ly)) || ((ry >= ly) && (ry <= lry))
-                        || ((cy <= ly) && (ry >= lry)))) {
-                    if ((sOWO ? (cx < lrx) : true) && (qAbs(lrx - cx) < snap)
-                        && (qAbs(lrx - cx) < deltaX)) {
-                        deltaX = qAbs(lrx - cx);
-                        nx = lrx;
-                    }
-                    if ((sOWO ? (rx > lx) : true) && (qAbs(rx - lx) < snap)
-                        && (qAbs(rx - lx) < deltaX)) {
-                        deltaX = qAbs(rx - lx);
-                        nx = lx - cw;
-                    }
-                }
+            auto snap_to_window = [&](auto var_win) {
+                std::visit(
+                    overload{[&](auto&& win) {
+                        if (!win->control) {
+                            return;
+                        }
+                        if constexpr (std::is_same_v<std::decay_t<decltype(win)>, Win*>) {
+                            if (win == &window) {
+                                return;
+                            }
+                        }
+                        if (win->control->minimized) {
+                            return;
+                        }
+                        if (!win->isShown()) {
+                            return;
+                        }
+                        if (!on_subspace(*win, get_subspace(window))
+                            && !on_subspace(window, get_subspace(*win))) {
+                            // wrong subspace
+                            return;
+                        }
+                        if (is_desktop(win) || is_splash(win) || is_applet_popup(win)) {
+                            return;
+                        }
 
-                if (!flags(guideMaximized & maximize_mode::vertical)
-                    && (((cx <= lrx) && (cx >= lx)) || ((rx >= lx) && (rx <= lrx))
-                        || ((cx <= lx) && (rx >= lrx)))) {
-                    if ((sOWO ? (cy < lry) : true) && (qAbs(lry - cy) < snap)
-                        && (qAbs(lry - cy) < deltaY)) {
-                        deltaY = qAbs(lry - cy);
-                        ny = lry;
-                    }
-                    // if ( (qAbs( ry-ly ) < snap) && (qAbs( ry - ly ) < deltaY ))
-                    if ((sOWO ? (ry > ly) : true) && (qAbs(ry - ly) < snap)
-                        && (qAbs(ry - ly) < deltaY)) {
-                        deltaY = qAbs(ry - ly);
-                        ny = ly - ch;
-                    }
-                }
+                        // coords and size for the comparison client, l
+                        int const lx = win->geo.pos().x();
+                        int const ly = win->geo.pos().y();
+                        int const lrx = lx + win->geo.size().width();
+                        int const lry = ly + win->geo.size().height();
+
+                        if (!flags(guideMaximized & maximize_mode::horizontal)
+                            && (((cy <= lry) && (cy >= ly)) || ((ry >= ly) && (ry <= lry))
+                                || ((cy <= ly) && (ry >= lry)))) {
+                            if ((sOWO ? (cx < lrx) : true) && (qAbs(lrx - cx) < snap)
+                                && (qAbs(lrx - cx) < deltaX)) {
+                                deltaX = qAbs(lrx - cx);
+                                nx = lrx;
+                            }
+                            if ((sOWO ? (rx > lx) : true) && (qAbs(rx - lx) < snap)
+                                && (qAbs(rx - lx) < deltaX)) {
+                                deltaX = qAbs(rx - lx);
+                                nx = lx - cw;
+                            }
+                        }
 
-                // Corner snapping
-                if (!flags(guideMaximized & maximize_mode::vertical)
-                    && (nx == lrx || nx + cw == lx)) {
-                    if ((sOWO ? (ry > lry) : true) && (qAbs(lry - ry) < snap)
-                        && (qAbs(lry - ry) < deltaY)) {
-                        deltaY = qAbs(lry - ry);
-                        ny = lry - ch;
-                    }
-                    if ((sOWO ? (cy < ly) : true) && (qAbs(cy - ly) < snap)
-                        && (qAbs(cy - ly) < deltaY)) {
-                        deltaY = qAbs(cy - ly);
-                        ny = ly;
-                    }
-                }
-                if (!flags(guideMaximized & maximize_mode::horizontal)
-                    && (ny == lry || ny + ch == ly)) {
-                    if ((sOWO ? (rx > lrx) : true) && (qAbs(lrx - rx) < snap)
-                        && (qAbs(lrx - rx) < deltaX)) {
-                        deltaX = qAbs(lrx - rx);
-                        nx = lrx - cw;
-                    }
-                    if ((sOWO ? (cx < lx) : true) && (qAbs(cx - lx) < snap)
-                        && (qAbs(cx - lx) < deltaX)) {
-                        deltaX = qAbs(cx - lx);
-                        nx = lx;
-                    }
+                        if (!flags(guideMaximized & maximize_mode::vertical)
+                            && (((cx <= lrx) && (cx >= lx)) || ((rx >= lx) && (rx <= lrx))
+                                || ((cx <= lx) && (rx >= lrx)))) {
+                            if ((sOWO ? (cy < lry) : true) && (qAbs(lry - cy) < snap)
+                                && (qAbs(lry - cy) < deltaY)) {
+                                deltaY = qAbs(lry - cy);
+                                ny = lry;
+                            }
+                            // if ( (qAbs( ry-ly ) < snap) && (qAbs( ry - ly ) < deltaY ))
+                            if ((sOWO ? (ry > ly) : true) && (qAbs(ry - ly) < snap)
+                                && (qAbs(ry - ly) < deltaY)) {
+                                deltaY = qAbs(ry - ly);
+                                ny = ly - ch;
+                            }
+                        }
+
+                        // Corner snapping
+                        if (!flags(guideMaximized & maximize_mode::vertical)
+                            && (nx == lrx || nx + cw == lx)) {
+                            if ((sOWO ? (ry > lry) : true) && (qAbs(lry - ry) < snap)
+                                && (qAbs(lry - ry) < deltaY)) {
+                                deltaY = qAbs(lry - ry);
+                                ny = lry - ch;
+                            }
+                            if ((sOWO ? (cy < ly) : true) && (qAbs(cy - ly) < snap)
+                                && (qAbs(cy - ly) < deltaY)) {
+                                deltaY = qAbs(cy - ly);
+                                ny = ly;
+                            }
+                        }
+                        if (!flags(guideMaximized & maximize_mode::horizontal)
+                            && (ny == lry || ny + ch == ly)) {
+                            if ((sOWO ? (rx > lrx) : true) && (qAbs(lrx - rx) < snap)
+                                && (qAbs(lrx - rx) < deltaX)) {
+                                deltaX = qAbs(lrx - rx);
+                                nx = lrx - cw;
+                            }
+                            if ((sOWO ? (cx < lx) : true) && (qAbs(cx - lx) < snap)
+                                && (qAbs(cx - lx) < deltaX)) {
+                                deltaX = qAbs(cx - lx);
+                                nx = lx;
+                            }
+                        }
+                    }},
+                    var_win);
+            };
+
+            // Only windows with an edge in the snap zone of an edge of the window can snap.
+            if (auto index = get_snap_index(space, window)) {
+                index->for_each_near({cx, rx}, {cy, ry}, snap, snap_to_window);
+            } else {
+                for (auto win : space.windows) {
+                    snap_to_window(win);
                 }
             }
         }
@@ -689,7 +699,7 @@ QRect adjust_window_size(Space const& space, Win const& window, QRect moveResize
         if (snap) {
             deltaX = int(snap);
             deltaY = int(snap);
-            for (auto win : space.windows) {
+            auto snap_to_window = [&](auto var_win) {
                 std::visit(
                     overload{[&](auto&& win) {
                         if (!win->control || !on_subspace(*win, space.subspace_manager->current)
@@ -819,7 +829,18 @@ QRect adjust_window_size(Space const& space, Win const& window, QRect moveResize
                             break;
                         }
                     }},
-                    win);
+                    var_win);
+            };
+
+            // Snapped edges move by less than the snap zone, and compared edges of other windows
+            // are offset by one pixel.
+            if (auto index = get_snap_index(space, window)) {
+                index->for_each_near(
+                    {newcx, newrx}, {newcy, newry}, 2 * snap + 2, snap_to_window);
+            } else {
+                for (auto win : space.windows) {
+                    snap_to_window(win);
+                }
             }
         }
 
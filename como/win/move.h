@@ -13,6 +13,7 @@
 #include "net.h"
 #include "quicktile.h"
 #include "scene.h"
+#include "snap_index.h"
 #include "stacking.h"
 #include "types.h"
 #include "window_area.h"
@@ -68,6 +69,7 @@ template<typename Space>
 void unset_move_resize_window(Space& space)
 {
     space.move_resize_window = {};
+    space.move_resize_snap_index.reset();
     --space.block_focus;
 }
 
@@ -77,6 +79,7 @@ void set_move_resize_window(Space& space, Win& window)
     // Catch attempts to move a second window while still moving the first one.
     assert(!space.move_resize_window);
     space.move_resize_window = &window;
+    space.move_resize_snap_index = create_snap_index(space, window);
     ++space.block_focus;
 }
 
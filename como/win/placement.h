@@ -11,6 +11,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include "meta.h"
 #include "move.h"
 #include "net.h"
+#include "placement_grid.h"
 #include "stacking_order.h"
 #include "transient.h"
 #include "types.h"
@@ -105,18 +106,33 @@ void place_smart(Win* window, QRect const& area)
         ? subspaces_get_current_x11id(*window->space.subspace_manager)
         : get_subspace(*window);
 
-    // temp coords
-    int cxl;
-    int cxr;
-    int cyt;
-    int cyb;
-    int xl;
-    int xr;
-    int yt;
-    int yb;
+    // Frames of the windows the placed window should not overlap.
+    std::vector<placement_grid::rect> frames;
+    for (auto const& var_win : window->space.stacking.order.stack) {
+        std::visit(overload{[&](auto&& win) {
+                       if (is_irrelevant(win, window, subspace)) {
+                           return;
+                       }
 
-    // temp holder
-    int basket;
+                       auto const& frame = win->geo.update.frame;
+                       long int weight = 1;
+                       if (win->control->keep_above) {
+                           weight = 16;
+                       } else if (win->control->keep_below && !is_dock(win)) {
+                           // ignore KeepBelow windows
+                           // for placement (see X11Client::belongsToLayer() for Dock)
+                           weight = 0;
+                       }
+                       frames.push_back({frame.x(),
+                                         frame.y(),
+                                         frame.x() + frame.width(),
+                                         frame.y() + frame.height(),
+                                         weight});
+                   }},
+                   var_win);
+    }
+
+    placement_grid const grid(std::move(frames));
 
     // get the maximum allowed windows space
     int x = area.left();
@@ -140,43 +156,8 @@ void place_smart(Win* window, QRect const& area)
         } else if (x + cw > area.right()) {
             overlap = w_wrong;
         } else {
-            // initialize
-            overlap = none;
-
-            cxl = x;
-            cxr = x + cw;
-            cyt = y;
-            cyb = y + ch;
-            for (auto const& var_win : window->space.stacking.order.stack) {
-                std::visit(overload{[&](auto&& win) {
-                               if (is_irrelevant(win, window, subspace)) {
-                                   return;
-                               }
-                               auto const& frame = win->geo.update.frame;
-                               xl = frame.topLeft().x();
-                               yt = frame.topLeft().y();
-                               xr = xl + frame.size().width();
-                               yb = yt + frame.size().height();
-
-                               // if windows overlap, calc the overall overlapping
-                               if ((cxl < xr) && (cxr > xl) && (cyt < yb) && (cyb > yt)) {
-                                   xl = qMax(cxl, xl);
-                                   xr = qMin(cxr, xr);
-                                   yt = qMax(cyt, yt);
-                                   yb = qMin(cyb, yb);
-                                   if (win->control->keep_above) {
-                                       overlap += 16 * (xr - xl) * (yb - yt);
-                                   } else if (win->control->keep_below && !is_dock(win)) {
-                                       // ignore KeepBelow windows
-                                       // for placement (see X11Client::belongsToLayer() for Dock)
-                                       overlap += 0;
-                                   } else {
-                                       overlap += (xr - xl) * (yb - yt);
-                                   }
-                               }
-                           }},
-                           var_win);
-            }
+            // if windows overlap, calc the overall overlapping
+            overlap = grid.overlap(x, y, x + cw, y + ch);
         }
 
         // CT first time we get no overlap we stop.
@@ -204,35 +185,9 @@ void place_smart(Win* window, QRect const& area)
                 possible -= cw;
             }
 
-            // compare to the position of each window on the same desk
-            for (auto const& var_win : window->space.stacking.order.stack) {
-                std::visit(overload{[&](auto&& win) {
-                               if (is_irrelevant(win, window, subspace)) {
-                                   return;
-                               }
-
-                               auto const& frame = win->geo.update.frame;
-                               xl = frame.topLeft().x();
-                               yt = frame.topLeft().y();
-                               xr = xl + frame.size().width();
-                               yb = yt + frame.size().height();
-
-                               // if not enough room above or under the current tested window
-                               // determine the first non-overlapped x position
-                               if ((y < yb) && (yt < ch + y)) {
-                                   if ((xr > x) && (possible > xr)) {
-                                       possible = xr;
-                                   }
-
-                                   basket = xl - cw;
-                                   if ((basket > x) && (possible > basket)) {
-                                       possible = basket;
-                                   }
-                               }
-                           }},
-                           var_win);
-            }
-            x = possible;
+            // if not enough room above or under the windows on the same desk
+            // determine the first non-overlapped x position
+            x = grid.next_column(x, y, cw, ch, possible);
         } else if (overlap == w_wrong) {
             // Not enough x dimension (overlap was wrong on horizontal)
             x = area.left();
@@ -242,34 +197,9 @@ void place_smart(Win* window, QRect const& area)
                 possible -= ch;
             }
 
-            // test the position of each window on the desk
-            for (auto const& var_win : window->space.stacking.order.stack) {
-                std::visit(overload{[&](auto&& win) {
-                               if (is_irrelevant(win, window, subspace)) {
-                                   return;
-                               }
-
-                               auto const& frame = win->geo.update.frame;
-                               xl = frame.topLeft().x();
-                               yt = frame.topLeft().y();
-                               xr = xl + frame.size().width();
-                               yb = yt + frame.size().height();
-
-                               // if not enough room to the left or right of the current tested
-                               // window determine the first non-overlapped y position
-                               if ((yb > y) && (possible > yb)) {
-                                   possible = yb;
-                               }
-
-                               basket = yt - ch;
-                               if ((basket > y) && (possible > basket)) {
-                                   possible = basket;
-                               }
-                           }},
-                           var_win);
-            }
-
-            y = possible;
+            // if not enough room to the left or right of the windows on the desk
+            // determine the first non-overlapped y position
+            y = grid.next_row(y, ch, possible);
         }
     } while ((overlap != none) && (overlap != h_wrong) && (y < area.bottom()));
 
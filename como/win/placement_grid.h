@@ -0,0 +1,216 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace como::win
+{
+
+/**
+ * Weighted occupancy of window frames for smart placement.
+ *
+ * The edges of all rects span a compressed grid. A summed-area table over the weighted coverage of
+ * its cells gives the weighted overlap of any rect with all windows in logarithmic time. Sorted
+ * edges give the next candidate positions the same way.
+ */
+class placement_grid
+{
+public:
+    /**
+     * Rect with exclusive right and bottom edges. Its overlap is multiplied by the weight.
+     */
+    struct rect {
+        int left;
+        int top;
+        int right;
+        int bottom;
+        long int weight;
+    };
+
+    explicit placement_grid(std::vector<rect> rects)
+        : rects{std::move(rects)}
+    {
+        for (auto const& rect : this->rects) {
+            xs.push_back(rect.left);
+            xs.push_back(rect.right);
+            ys.push_back(rect.top);
+            ys.push_back(rect.bottom);
+            tops.push_back(rect.top);
+            bottoms.push_back(rect.bottom);
+        }
+
+        for (auto list : {&xs, &ys, &tops, &bottoms}) {
+            std::sort(list->begin(), list->end());
+        }
+        for (auto list : {&xs, &ys}) {
+            list->erase(std::unique(list->begin(), list->end()), list->end());
+        }
+
+        nx = xs.size();
+        ny = ys.size();
+        density.assign(nx * ny, 0);
+        sums.assign(nx * ny, 0);
+        column_sums.assign(nx * ny, 0);
+        row_sums.assign(nx * ny, 0);
+
+        // Weight differences at the corners, accumulated below to the weight of each cell.
+        for (auto const& rect : this->rects) {
+            auto const left = index(xs, rect.left);
+            auto const right = index(xs, rect.right);
+            auto const top = index(ys, rect.top);
+            auto const bottom = index(ys, rect.bottom);
+            density[at(left, top)] += rect.weight;
+            density[at(right, top)] -= rect.weight;
+            density[at(left, bottom)] -= rect.weight;
+            density[at(right, bottom)] += rect.weight;
+        }
+
+        for (size_t i = 0; i < nx; i++) {
+            for (size_t j = 1; j < ny; j++) {
+                density[at(i, j)] += density[at(i, j - 1)];
+            }
+        }
+        for (size_t i = 1; i < nx; i++) {
+            for (size_t j = 0; j < ny; j++) {
+                density[at(i, j)] += density[at(i - 1, j)];
+            }
+        }
+
+        // Integrals from the grid origin up to each grid point, of the cells left of and above it
+        // and of the cell column and row it starts.
+        for (size_t i = 0; i + 1 < nx; i++) {
+            long int const width = xs[i + 1] - xs[i];
+            for (size_t j = 0; j + 1 < ny; j++) {
+                long int const height = ys[j + 1] - ys[j];
+                auto const cell = density[at(i, j)];
+                sums[at(i + 1, j + 1)] = sums[at(i, j + 1)] + sums[at(i + 1, j)] - sums[at(i, j)]
+                    + cell * width * height;
+                column_sums[at(i, j + 1)] = column_sums[at(i, j)] + cell * height;
+                row_sums[at(i + 1, j)] = row_sums[at(i, j)] + cell * width;
+            }
+        }
+    }
+
+    /**
+     * Sum of the weighted overlaps of all rects with the rect from @a left and @a top to the
+     * exclusive @a right and @a bottom.
+     */
+    long int overlap(int left, int top, int right, int bottom) const
+    {
+        return integral(right, bottom) - integral(left, bottom) - integral(right, top)
+            + integral(left, top);
+    }
+
+    /**
+     * Lowers @a possible to the next y after @a y where a rect ends or where a rect starts right
+     * below a window of @a height at it.
+     */
+    int next_row(int y, int height, int possible) const
+    {
+        if (auto it = std::upper_bound(bottoms.begin(), bottoms.end(), y);
+            it != bottoms.end() && *it < possible) {
+            possible = *it;
+        }
+        if (auto it = std::upper_bound(tops.begin(), tops.end(), y + height);
+            it != tops.end() && *it - height < possible) {
+            possible = *it - height;
+        }
+        return possible;
+    }
+
+    /**
+     * Lowers @a possible to the next x after @a x where a rect in the row of a window of @a width
+     * and @a height at @a x and @a y ends or where such a rect starts right to the window.
+     */
+    int next_column(int x, int y, int width, int height, int possible) const
+    {
+        if (!row || row->y != y || row->height != height) {
+            row = band{y, height, {}, {}};
+            for (auto const& rect : rects) {
+                if (y < rect.bottom && rect.top < height + y) {
+                    row->lefts.push_back(rect.left);
+                    row->rights.push_back(rect.right);
+                }
+            }
+            std::sort(row->lefts.begin(), row->lefts.end());
+            std::sort(row->rights.begin(), row->rights.end());
+        }
+
+        if (auto it = std::upper_bound(row->rights.begin(), row->rights.end(), x);
+            it != row->rights.end() && *it < possible) {
+            possible = *it;
+        }
+        if (auto it = std::upper_bound(row->lefts.begin(), row->lefts.end(), x + width);
+            it != row->lefts.end() && *it - width < possible) {
+            possible = *it - width;
+        }
+        return possible;
+    }
+
+private:
+    // Rects overlapping a row of candidate positions.
+    struct band {
+        int y;
+        int height;
+        std::vector<int> lefts;
+        std::vector<int> rights;
+    };
+
+    static size_t index(std::vector<int> const& list, int value)
+    {
+        return std::lower_bound(list.begin(), list.end(), value) - list.begin();
+    }
+
+    size_t at(size_t i, size_t j) const
+    {
+        return i * ny + j;
+    }
+
+    // Weighted area of all rects from the grid origin up to @a x and @a y.
+    long int integral(int x, int y) const
+    {
+        if (nx == 0 || x <= xs.front() || y <= ys.front()) {
+            return 0;
+        }
+
+        x = std::min(x, xs.back());
+        y = std::min(y, ys.back());
+
+        auto const i = std::upper_bound(xs.begin(), xs.end(), x) - xs.begin() - 1;
+        auto const j = std::upper_bound(ys.begin(), ys.end(), y) - ys.begin() - 1;
+        long int const dx = x - xs[i];
+        long int const dy = y - ys[j];
+
+        return sums[at(i, j)] + dx * column_sums[at(i, j)] + dy * row_sums[at(i, j)]
+            + dx * dy * density[at(i, j)];
+    }
+
+    std::vector<rect> rects;
+
+    // Distinct edges of the grid.
+    std::vector<int> xs;
+    std::vector<int> ys;
+    size_t nx{0};
+    size_t ny{0};
+
+    // Weight of the cell starting at each grid point.
+    std::vector<long int> density;
+    std::vector<long int> sums;
+    std::vector<long int> column_sums;
+    std::vector<long int> row_sums;
+
+    std::vector<int> tops;
+    std::vector<int> bottoms;
+
+    mutable std::optional<band> row;
+};
+
+}
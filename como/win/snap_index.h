@@ -0,0 +1,272 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "space_qobject.h"
+#include "window_qobject.h"
+
+#include <como/utils/algorithm.h>
+
+#include <QObject>
+#include <QRect>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace como::win
+{
+
+/**
+ * Index of window frame edges for snapping a window while it is moved or resized interactively.
+ *
+ * The edges of each side are kept sorted, so finding the windows with an edge close to a position
+ * is logarithmic in the number of windows. Windows are visited in the order they were added.
+ */
+template<typename Window>
+class snap_index
+{
+public:
+    snap_index() = default;
+    snap_index(snap_index const&) = delete;
+    snap_index& operator=(snap_index const&) = delete;
+
+    ~snap_index()
+    {
+        for (auto const& con : connections) {
+            QObject::disconnect(con);
+        }
+    }
+
+    void add(Window win, QRect const& geo)
+    {
+        if (ids.contains(win)) {
+            update(win, geo);
+            return;
+        }
+
+        ids.insert({win, entries.size()});
+        entries.push_back({win, geo});
+        insert_edges(entries.size() - 1);
+    }
+
+    void update(Window win, QRect const& geo)
+    {
+        auto it = ids.find(win);
+        if (it == ids.end()) {
+            return;
+        }
+
+        auto& entry = entries[it->second];
+        if (entry.geo == geo) {
+            return;
+        }
+
+        erase_edges(it->second);
+        entry.geo = geo;
+        insert_edges(it->second);
+    }
+
+    void remove(Window win)
+    {
+        auto it = ids.find(win);
+        if (it == ids.end()) {
+            return;
+        }
+
+        // The entry stays to keep the indices of the others. Without edges it is not found anymore.
+        erase_edges(it->second);
+        ids.erase(it);
+    }
+
+    size_t size() const
+    {
+        return ids.size();
+    }
+
+    /**
+     * Calls @a visit with each window that has a vertical edge closer than @a distance to one of
+     * @a xs or a horizontal edge closer than @a distance to one of @a ys.
+     */
+    template<typename Visitor>
+    void for_each_near(std::initializer_list<int> xs,
+                       std::initializer_list<int> ys,
+                       int distance,
+                       Visitor&& visit) const
+    {
+        std::vector<size_t> found;
+
+        auto collect = [&](side at, int pos) {
+            auto const& list = edges[at];
+            auto it = std::lower_bound(
+                list.begin(), list.end(), edge{pos - distance + 1, 0}, compare_pos);
+            for (; it != list.end() && it->first < pos + distance; ++it) {
+                found.push_back(it->second);
+            }
+        };
+
+        for (auto x : xs) {
+            collect(side::left, x);
+            collect(side::right, x);
+        }
+        for (auto y : ys) {
+            collect(side::top, y);
+            collect(side::bottom, y);
+        }
+
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+
+        for (auto index : found) {
+            visit(entries[index].win);
+        }
+    }
+
+    // Kept connections for updating the index. Disconnected on destruction.
+    std::vector<QMetaObject::Connection> connections;
+
+private:
+    enum side {
+        left = 0,
+        right,
+        top,
+        bottom,
+    };
+
+    struct entry {
+        Window win;
+        QRect geo;
+    };
+
+    // Edge position and index of the entry.
+    using edge = std::pair<int, size_t>;
+
+    static bool compare_pos(edge const& lhs, edge const& rhs)
+    {
+        return lhs.first < rhs.first;
+    }
+
+    static int edge_pos(QRect const& geo, side at)
+    {
+        switch (at) {
+        case side::left:
+            return geo.x();
+        case side::right:
+            return geo.x() + geo.width();
+        case side::top:
+            return geo.y();
+        case side::bottom:
+        default:
+            return geo.y() + geo.height();
+        }
+    }
+
+    void insert_edges(size_t index)
+    {
+        for (auto at : {side::left, side::right, side::top, side::bottom}) {
+            auto& list = edges[at];
+            edge const value{edge_pos(entries[index].geo, at), index};
+            list.insert(std::upper_bound(list.begin(), list.end(), value, compare_pos), value);
+        }
+    }
+
+    void erase_edges(size_t index)
+    {
+        for (auto at : {side::left, side::right, side::top, side::bottom}) {
+            auto& list = edges[at];
+            auto const pos = edge_pos(entries[index].geo, at);
+            auto [begin, end]
+                = std::equal_range(list.begin(), list.end(), edge{pos, 0}, compare_pos);
+            auto it = std::find_if(
+                begin, end, [index](auto const& edge) { return edge.second == index; });
+            if (it != end) {
+                list.erase(it);
+            }
+        }
+    }
+
+    std::vector<entry> entries;
+    std::unordered_map<Window, size_t> ids;
+    std::array<std::vector<edge>, 4> edges;
+};
+
+/**
+ * Creates the snap index of @a space for moving or resizing @a window. The index follows geometry
+ * changes, additions and removals of the other windows until it is destroyed.
+ */
+template<typename Space, typename Win>
+auto create_snap_index(Space& space, Win const& window)
+{
+    using window_t = typename Space::window_t;
+    auto index = std::make_unique<snap_index<window_t>>();
+
+    auto add = [&window, index = index.get()](window_t var_win) {
+        std::visit(overload{[&](auto&& win) {
+                       if constexpr (std::is_same_v<std::decay_t<decltype(win)>, Win*>) {
+                           if (win == &window) {
+                               return;
+                           }
+                       }
+                       if (!win->control) {
+                           return;
+                       }
+
+                       auto qtwin = win->qobject.get();
+                       index->add(var_win, win->geo.frame);
+                       index->connections.push_back(QObject::connect(
+                           qtwin, &window_qobject::frame_geometry_changed, qtwin, [=] {
+                               index->update(var_win, win->geo.frame);
+                           }));
+                       index->connections.push_back(QObject::connect(
+                           qtwin, &QObject::destroyed, qtwin, [=] { index->remove(var_win); }));
+                   }},
+                   var_win);
+    };
+
+    for (auto win : space.windows) {
+        add(win);
+    }
+
+    auto add_by_id = [&space, add](auto id) {
+        if (auto it = space.windows_map.find(id); it != space.windows_map.end()) {
+            add(it->second);
+        }
+    };
+
+    auto qtspace = space.qobject.get();
+    for (auto signal : {&space_qobject::clientAdded,
+                        &space_qobject::wayland_window_added,
+                        &space_qobject::internalClientAdded}) {
+        index->connections.push_back(QObject::connect(qtspace, signal, qtspace, add_by_id));
+    }
+
+    return index;
+}
+
+/**
+ * Returns the snap index of @a space if @a window is the one being moved or resized.
+ */
+template<typename Space, typename Win>
+auto get_snap_index(Space const& space, Win const& window)
+    -> snap_index<typename Space::window_t> const*
+{
+    if (!space.move_resize_snap_index || !space.move_resize_window) {
+        return nullptr;
+    }
+
+    auto const is_moved = std::visit(
+        overload{[&](auto&& win) { return static_cast<void const*>(win) == &window; }},
+        *space.move_resize_window);
+    return is_moved ? space.move_resize_snap_index.get() : nullptr;
+}
+
+}
@@ -8,9 +8,72 @@
 #include "move.h"
 #include "space_areas.h"
 
+#include <como/base/output_helpers.h>
+#include <como/debug/perf/metrics.h>
+
+#include <algorithm>
+
 namespace como::win
 {
 
+/**
+ * Counts updates of the space areas that checked all windows or only affected ones.
+ */
+struct space_areas_metrics {
+    static space_areas_metrics& instance()
+    {
+        static space_areas_metrics metrics(debug::metrics_registry::instance());
+        return metrics;
+    }
+
+    void updated(bool full)
+    {
+        (full ? full_updates : incremental_updates).add();
+    }
+
+    debug::metric_counter& full_updates;
+    debug::metric_counter& incremental_updates;
+
+private:
+    explicit space_areas_metrics(debug::metrics_registry& registry)
+        : full_updates{counter(registry, QStringLiteral("full"))}
+        , incremental_updates{counter(registry, QStringLiteral("incremental"))}
+    {
+    }
+
+    static debug::metric_counter& counter(debug::metrics_registry& registry, QString const& kind)
+    {
+        return registry.counter(QStringLiteral("como_space_areas_updates_total"),
+                                QStringLiteral("Updates of work areas and struts."),
+                                {{QStringLiteral("kind"), kind}});
+    }
+};
+
+/**
+ * Strut rects that are in only one of @a old_struts and @a new_struts.
+ */
+inline strut_rects changed_strut_rects(strut_rects const& old_struts, strut_rects const& new_struts)
+{
+    auto contains = [](auto const& struts, auto const& rect) {
+        return std::any_of(struts.begin(), struts.end(), [&rect](auto const& other) {
+            return other == rect && other.area() == rect.area();
+        });
+    };
+
+    strut_rects changed;
+    for (auto const& rect : old_struts) {
+        if (!contains(new_struts, rect)) {
+            changed.push_back(rect);
+        }
+    }
+    for (auto const& rect : new_struts) {
+        if (!contains(old_struts, rect)) {
+            changed.push_back(rect);
+        }
+    }
+    return changed;
+}
+
 /**
  * Updates the current client areas according to the current clients.
  *
@@ -20,6 +83,9 @@ namespace como::win
  * which is not taken by windows like panels, the top-of-screen menu
  * etc).
  *
+ * Windows are checked against the new areas. Without force and with the same outputs and
+ * subspaces only windows on subspaces and outputs with changed screen areas or struts are checked.
+ *
  * @see clientArea()
  */
 template<typename Space>
@@ -57,38 +123,86 @@ void update_space_areas_impl(Space& space, bool force)
 
     space.update_space_area_from_windows(desktop_area, screens_geos, new_areas);
 
-    auto changed = force || space.areas.screen.empty();
+    // All windows are checked when the layout of outputs or subspaces changed.
+    auto const full = force || space.areas.screen.empty()
+        || space.areas.screen.size() != new_areas.screen.size()
+        || std::any_of(std::next(space.areas.screen.begin()),
+                       space.areas.screen.end(),
+                       [screens_count](auto const& screens) {
+                           return screens.size() != screens_count;
+                       });
+
+    auto changed = full;
 
-    for (int desktop = 1; !changed && desktop <= desktops_count; ++desktop) {
+    // Otherwise only windows are checked that are on a subspace and output with a changed screen
+    // area or that are on a subspace with changed struts on their output.
+    std::vector<std::vector<bool>> changed_screens(desktops_count + 1);
+    std::vector<strut_rects> changed_struts(desktops_count + 1);
+
+    for (int desktop = 1; !full && desktop <= desktops_count; ++desktop) {
         changed |= space.areas.work[desktop] != new_areas.work[desktop];
-        changed |= space.areas.restrictedmove[desktop] != new_areas.restrictedmove[desktop];
-        changed |= space.areas.screen[desktop].size() != new_areas.screen[desktop].size();
 
-        for (size_t screen = 0; !changed && screen < screens_count; screen++) {
-            changed |= new_areas.screen[desktop][screen] != space.areas.screen[desktop][screen];
+        changed_struts[desktop] = changed_strut_rects(space.areas.restrictedmove[desktop],
+                                                      new_areas.restrictedmove[desktop]);
+        changed |= !changed_struts[desktop].empty();
+
+        changed_screens[desktop].resize(screens_count);
+        for (size_t screen = 0; screen < screens_count; screen++) {
+            changed_screens[desktop][screen]
+                = new_areas.screen[desktop][screen] != space.areas.screen[desktop][screen];
+            changed |= changed_screens[desktop][screen];
         }
     }
 
-    if (changed) {
-        space.oldrestrictedmovearea = space.areas.restrictedmove;
-        space.areas = new_areas;
+    if (!changed) {
+        return;
+    }
+
+    space.oldrestrictedmovearea = space.areas.restrictedmove;
+    space.areas = new_areas;
 
-        if constexpr (requires(Space space) { space.update_work_area(); }) {
-            space.update_work_area();
-        }
+    if constexpr (requires(Space space) { space.update_work_area(); }) {
+        space.update_work_area();
+    }
 
-        for (auto win : space.windows) {
-            std::visit(overload{[&](auto&& win) {
-                           if (win->control) {
-                               check_workspace_position(win);
-                           }
-                       }},
-                       win);
+    auto is_affected = [&](auto win) {
+        auto output = base::get_nearest_output(outputs, pending_frame_geometry(win).center());
+        if (!output) {
+            return true;
         }
 
-        // Reset, no longer valid or needed.
-        space.oldrestrictedmovearea.clear();
+        auto const screen = base::get_output_index(outputs, *output);
+        auto const output_geo = output->geometry();
+
+        for (int desktop = 1; desktop <= desktops_count; ++desktop) {
+            if (!on_subspace(*win, desktop)) {
+                continue;
+            }
+            if (changed_screens[desktop][screen]) {
+                return true;
+            }
+            for (auto const& strut : changed_struts[desktop]) {
+                if (strut.intersects(output_geo)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    for (auto win : space.windows) {
+        std::visit(overload{[&](auto&& win) {
+                       if (win->control && (full || is_affected(win))) {
+                           check_workspace_position(win);
+                       }
+                   }},
+                   win);
     }
+
+    // Reset, no longer valid or needed.
+    space.oldrestrictedmovearea.clear();
+
+    space_areas_metrics::instance().updated(full);
 }
 
 template<typename Space>
@@ -11,6 +11,7 @@
 #include <como/utils/algorithm.h>
 
 #include <cassert>
+#include <optional>
 #include <vector>
 
 namespace como::win
@@ -94,6 +95,7 @@ public:
         for (auto const& lead : m_leads) {
             remove_all(lead->transient->children, m_window);
             if (annexed) {
+                lead->transient->discard_annexed_descendants();
                 assert(top_lead);
                 discard_shape(*top_lead);
                 add_layer_repaint(*top_lead, visible_rect(m_window, m_window->geo.frame));
@@ -141,6 +143,7 @@ public:
         window->transient->add_lead(m_window);
 
         if (window->transient->annexed) {
+            discard_annexed_descendants();
             discard_shape(*m_window);
         }
     }
@@ -152,6 +155,8 @@ public:
         window->transient->remove_lead(m_window);
 
         if (window->transient->annexed) {
+            discard_annexed_descendants();
+
             // Need to check that a top-lead exists since this might be called on destroy of a lead.
             if (auto top_lead = lead_of_annexed_transient(m_window)) {
                 discard_shape(*top_lead);
@@ -179,6 +184,41 @@ public:
         return false;
     }
 
+    /**
+     * Annexed children and recursively their annexed children in render order, each before its own
+     * annexed children. Cached until the annexed children of this or of a descendant change.
+     */
+    std::vector<Window*> const& annexed_descendants()
+    {
+        if (!m_annexed_descendants) {
+            m_annexed_descendants.emplace();
+            for (auto child : children) {
+                if (!child->transient->annexed) {
+                    continue;
+                }
+                auto const& descendants = child->transient->annexed_descendants();
+                m_annexed_descendants->push_back(child);
+                m_annexed_descendants->insert(
+                    m_annexed_descendants->end(), descendants.begin(), descendants.end());
+            }
+        }
+        return *m_annexed_descendants;
+    }
+
+    /**
+     * Must be called when the annexed children changed without adding or removing them, for
+     * example when they are restacked.
+     */
+    void discard_annexed_descendants()
+    {
+        m_annexed_descendants.reset();
+        if (annexed) {
+            for (auto lead : m_leads) {
+                lead->transient->discard_annexed_descendants();
+            }
+        }
+    }
+
     bool modal() const
     {
         return m_modal;
@@ -224,6 +264,7 @@ private:
 
     std::vector<Window*> m_leads;
     bool m_modal{false};
+    std::optional<std::vector<Window*>> m_annexed_descendants;
 
     Window* m_window;
 };
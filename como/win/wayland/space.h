@@ -13,6 +13,7 @@
 #include <como/win/kill_window.h>
 #include <como/win/screen.h>
 #include <como/win/setup.h>
+#include <como/win/snap_index.h>
 #include <como/win/stacking_order.h>
 #include <como/win/stacking_state.h>
 #include <como/win/wayland/internal_window.h>
@@ -201,6 +202,7 @@ public:
     std::optional<window_t> active_popup_client;
     std::optional<window_t> client_keys_client;
     std::optional<window_t> move_resize_window;
+    std::unique_ptr<win::snap_index<window_t>> move_resize_snap_index;
 };
 
 }
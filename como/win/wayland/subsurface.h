@@ -13,6 +13,9 @@
 
 #include <Wrapland/Server/subcompositor.h>
 #include <Wrapland/Server/surface.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace como::win::wayland
 {
@@ -27,26 +30,57 @@ void assign_subsurface_role(Win* win)
 }
 
 template<typename Win>
-void restack_subsurfaces(Win* window)
+void update_subsurfaces_stacking(Win* window)
+{
+    window->transient->discard_annexed_descendants();
+
+    // Optimize and do that only for the first window up the chain not being annexed.
+    if (!window->transient->annexed) {
+        window->space.stacking.order.update_order();
+    }
+}
+
+/**
+ * Orders the children of @a window like its subsurfaces. Returns false if they were in order
+ * already.
+ */
+template<typename Win>
+bool restack_subsurfaces(Win* window)
 {
     auto const& subsurfaces = window->surface->state().children;
     auto& children = window->transient->children;
 
+    std::unordered_map<Wrapland::Server::Surface const*, Win*> by_surface;
+    for (auto child : children) {
+        by_surface.insert({child->surface, child});
+    }
+
+    // Children of subsurfaces in their order, after all other children.
+    std::vector<Win*> stacked;
+    std::unordered_set<Win*> stacked_set;
     for (auto const& subsurface : subsurfaces) {
-        auto it = std::find_if(children.begin(), children.end(), [&subsurface](auto child) {
-            return child->surface == subsurface->surface();
-        });
-        if (it == children.end()) {
-            continue;
+        if (auto it = by_surface.find(subsurface->surface()); it != by_surface.end()) {
+            stacked.push_back(it->second);
+            stacked_set.insert(it->second);
         }
+    }
 
-        move_to_back(children, *it);
+    std::vector<Win*> restacked;
+    restacked.reserve(children.size());
+    for (auto child : children) {
+        if (!stacked_set.contains(child)) {
+            restacked.push_back(child);
+        }
     }
+    restacked.insert(restacked.end(), stacked.begin(), stacked.end());
 
-    // Optimize and do that only for the first window up the chain not being annexed.
-    if (!window->transient->annexed) {
-        window->space.stacking.order.update_order();
+    if (restacked == children) {
+        return false;
     }
+
+    children = std::move(restacked);
+    update_subsurfaces_stacking(window);
+    return true;
 }
 
 template<typename Win>
@@ -95,7 +129,10 @@ void set_subsurface_parent(Win* win, Lead* lead)
     assert(!contains(lead->transient->children, win));
 
     lead->transient->add_child(win);
-    restack_subsurfaces(lead);
+    if (!restack_subsurfaces(lead)) {
+        // The new child is in order already but must still be stacked.
+        update_subsurfaces_stacking(lead);
+    }
 
     QObject::connect(win->surface, &WS::Surface::committed, win->qobject.get(), [win] {
         if (win->surface->state().updates & Wrapland::Server::surface_change::size) {
@@ -17,6 +17,7 @@
 #include <como/win/geo_block.h>
 #include <como/win/geo_restrict.h>
 #include <como/win/maximize.h>
+#include <como/win/move.h>
 #include <como/win/placement.h>
 #include <como/win/rules/find.h>
 #include <como/win/rules/update.h>
@@ -39,8 +40,11 @@
 #include <Wrapland/Server/xdg_decoration.h>
 #include <Wrapland/Server/xdg_shell.h>
 
+#include <algorithm>
+#include <chrono>
 #include <csignal>
 #include <memory>
+#include <optional>
 #include <unistd.h>
 #include <vector>
 
@@ -279,6 +283,15 @@ public:
     /// Ask client to provide buffer adapted to new geometry @param rect (in global coordinates).
     void configure_geometry(QRect const& frame_geo)
     {
+        if (toplevel && is_resize(this) && !pending_configures.empty()) {
+            // Only one configure is outstanding during an interactive resize. Clients can not keep
+            // up with a configure per pointer motion otherwise. The latest geometry is sent once
+            // the client committed the outstanding one.
+            resize_configure.held_frame = frame_geo;
+            return;
+        }
+        resize_configure.held_frame.reset();
+
         // The window geometry relevant to clients is the frame geometry without decorations.
         auto window_geo = frame_geo;
 
@@ -299,6 +312,11 @@ public:
                                                   this);
             toplevel->configure_bounds(bounds.size());
             serial = toplevel->configure(xdg_surface_states(*this), window_geo.size());
+
+            if (is_resize(this)) {
+                resize_configure.serial = serial;
+                resize_configure.sent = std::chrono::steady_clock::now();
+            }
         }
         if (popup) {
             auto parent = this->transient->lead();
@@ -1251,6 +1269,18 @@ public:
     };
     std::vector<configure_event> pending_configures;
 
+    struct {
+        // Frame geometry to configure once the outstanding configure of an interactive resize has
+        // been committed by the client.
+        std::optional<QRect> held_frame;
+
+        uint32_t serial{0};
+        std::chrono::steady_clock::time_point sent;
+
+        // Smoothed time the client needs from a resize configure to committing a buffer for it.
+        std::chrono::microseconds response_time{0};
+    } resize_configure;
+
     void handle_commit()
     {
         if (!surface->state().buffer) {
@@ -1270,6 +1300,7 @@ public:
 
         if (toplevel || popup) {
             apply_pending_geometry();
+            update_resize_configure();
 
             // Plasma surfaces might set position late. So check again initial position being set.
             if (must_place) {
@@ -1450,6 +1481,32 @@ public:
     Space& space;
 
 private:
+    void update_resize_configure()
+    {
+        auto& resize = resize_configure;
+
+        if (resize.serial) {
+            auto const committed = std::none_of(
+                pending_configures.cbegin(), pending_configures.cend(), [&](auto const& config) {
+                    return config.serial == resize.serial;
+                });
+            if (!committed) {
+                return;
+            }
+
+            auto const sample = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - resize.sent);
+            resize.response_time = resize.response_time.count() > 0
+                ? (resize.response_time * 7 + sample) / 8
+                : sample;
+            resize.serial = 0;
+        }
+
+        if (resize.held_frame && pending_configures.empty()) {
+            configure_geometry(*resize.held_frame);
+        }
+    }
+
     void handle_shown_and_mapped()
     {
         mapped = true;
@@ -22,6 +22,7 @@
 #include <como/win/desktop_space.h>
 #include <como/win/kill_window.h>
 #include <como/win/screen_edges.h>
+#include <como/win/snap_index.h>
 #include <como/win/space_reconfigure.h>
 #include <como/win/stacking_order.h>
 #include <como/win/stacking_state.h>
@@ -325,6 +326,7 @@ public:
     std::optional<window_t> active_popup_client;
     std::optional<window_t> client_keys_client;
     std::optional<window_t> move_resize_window;
+    std::unique_ptr<win::snap_index<window_t>> move_resize_snap_index;
 
 private:
     std::unique_ptr<xcb_event_filter<type>> event_filter;
@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/debug/perf/metrics.h>
+
+#include <QByteArray>
+#include <cstddef>
+#include <map>
+#include <xcb/xcb.h>
+
+namespace como::xwl
+{
+
+/**
+ * Performance metrics of serving X11 selection requests from the cache.
+ */
+struct selection_cache_metrics {
+    static selection_cache_metrics& instance()
+    {
+        static selection_cache_metrics metrics(debug::metrics_registry::instance());
+        return metrics;
+    }
+
+    debug::metric_counter& hits;
+    debug::metric_counter& misses;
+    debug::metric_counter& served;
+
+private:
+    explicit selection_cache_metrics(debug::metrics_registry& registry)
+        : hits{requests(registry, QStringLiteral("hit"))}
+        , misses{requests(registry, QStringLiteral("miss"))}
+        , served{registry.counter(QStringLiteral("como_xwl_selection_cache_served_bytes_total"),
+                                  QStringLiteral("Bytes sent to X11 clients from the cache."))}
+    {
+    }
+
+    static debug::metric_counter& requests(debug::metrics_registry& registry,
+                                           QString const& result)
+    {
+        return registry.counter(QStringLiteral("como_xwl_selection_cache_requests_total"),
+                                QStringLiteral("X11 requests for Wayland selection data."),
+                                {{QStringLiteral("result"), result}});
+    }
+};
+
+/**
+ * Data of a Wayland source by the requested X11 target.
+ *
+ * The data offered by a source does not change, so repeated requests from X11 clients can be
+ * served without reading from the source client again. The cache lives as long as its source.
+ */
+class selection_cache
+{
+public:
+    // In bytes. Data of larger transfers is not cached.
+    static constexpr size_t max_size{4 * 1024 * 1024};
+
+    QByteArray const* get(xcb_atom_t target) const
+    {
+        auto& metrics = selection_cache_metrics::instance();
+
+        auto it = entries.find(target);
+        if (it == entries.end()) {
+            metrics.misses.add();
+            return nullptr;
+        }
+
+        metrics.hits.add();
+        metrics.served.add(it->second.size());
+        return &it->second;
+    }
+
+    void insert(xcb_atom_t target, QByteArray const& data)
+    {
+        auto const data_size = static_cast<size_t>(data.size());
+        if (entries.contains(target) || size + data_size > max_size) {
+            return;
+        }
+
+        entries.insert({target, data});
+        size += data_size;
+    }
+
+private:
+    std::map<xcb_atom_t, QByteArray> entries;
+    size_t size{0};
+};
+
+}
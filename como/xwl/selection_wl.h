@@ -67,16 +67,29 @@ void set_wl_source(Selection* sel, wl_source<server_source, typename Selection::
         QObject::connect(source->get_qobject(),
                          &q_wl_source::transfer_ready,
                          sel->data.qobject.get(),
-                         [sel](auto event, auto fd) { start_transfer_to_x11(sel, event, fd); });
+                         [sel, source](auto event, auto fd) {
+                             start_transfer_to_x11(sel, source, event, fd);
+                         });
     }
 }
 
-template<typename Selection>
-void start_transfer_to_x11(Selection* sel, xcb_selection_request_event_t* event, qint32 fd)
+template<typename Selection, typename Source>
+void start_transfer_to_x11(Selection* sel,
+                           Source* source,
+                           xcb_selection_request_event_t* event,
+                           qint32 fd)
 {
     auto transfer = new wl_to_x11_transfer(
         sel->data.atom, event, fd, sel->data.core.x11, sel->data.qobject.get());
 
+    // Dropped when the source is replaced while the transfer is still running.
+    QObject::connect(transfer,
+                     &wl_to_x11_transfer::data_read,
+                     source->get_qobject(),
+                     [source, target = event->target](auto const& data) {
+                         source->cache.insert(target, data);
+                     });
+
     QObject::connect(transfer,
                      &wl_to_x11_transfer::selection_notify,
                      sel->data.qobject.get(),
@@ -230,6 +243,22 @@ inline void send_wl_selection_targets(x11_runtime const& x11,
     send_selection_notify(x11.connection, event, true);
 }
 
+inline void send_wl_selection_data(x11_runtime const& x11,
+                                   xcb_selection_request_event_t* event,
+                                   QByteArray const& data)
+{
+    xcb_change_property(x11.connection,
+                        XCB_PROP_MODE_REPLACE,
+                        event->requestor,
+                        event->property,
+                        event->target,
+                        8,
+                        data.size(),
+                        data.constData());
+
+    send_selection_notify(x11.connection, event, true);
+}
+
 /// Returns the file descriptor to write in or -1 on error.
 template<typename Source>
 int selection_wl_start_transfer(Source&& source, xcb_selection_request_event_t* event)
@@ -280,6 +309,8 @@ bool selection_wl_handle_request(Source&& source, xcb_selection_request_event_t*
         send_wl_selection_timestamp(x11, event, source->timestamp);
     } else if (event->target == x11.atoms->delete_atom) {
         send_selection_notify(x11.connection, event, true);
+    } else if (auto data = source->cache.get(event->target)) {
+        send_wl_selection_data(x11, event, *data);
     } else {
         // try to send mime data
         if (auto fd = selection_wl_start_transfer(source, event); fd > 0) {
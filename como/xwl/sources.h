@@ -5,6 +5,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 */
 #pragma once
 
+#include "selection_cache.h"
 #include "types.h"
 
 #include <QObject>
@@ -68,6 +69,7 @@ public:
     runtime<Space> const& core;
     std::vector<std::string> offers;
     xcb_timestamp_t timestamp{XCB_CURRENT_TIME};
+    selection_cache cache;
 
 private:
     std::unique_ptr<q_wl_source> qobject;
@@ -7,13 +7,31 @@ SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <como/base/logging.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
 #include <unistd.h>
 
 namespace como::xwl
 {
 
-// in Bytes: equals 64KB
-constexpr uint32_t s_incrChunkSize = 63 * 1024;
+// In bytes. The minimum is what could always be sent, the maximum limits how long a single property
+// change blocks the X server and how much data is buffered per transfer.
+constexpr uint32_t s_minIncrChunkSize = 63 * 1024;
+constexpr uint32_t s_maxIncrChunkSize = 1024 * 1024;
+
+// Chunks buffered while the requestor has not yet picked up the property with the previous one.
+constexpr size_t s_maxPendingChunks = 2;
+
+// Size of the data sent per property change to X clients. With BIG-REQUESTS it can be larger.
+static uint32_t incr_chunk_size(xcb_connection_t* connection)
+{
+    // The maximum request length is in units of 4 bytes. Leave room for the request header.
+    auto const max_request = static_cast<uint64_t>(xcb_get_maximum_request_length(connection)) * 4;
+    auto const max_data = max_request > 1024 ? max_request - 1024 : 0;
+
+    return std::clamp<uint64_t>(max_data, s_minIncrChunkSize, s_maxIncrChunkSize);
+}
 
 transfer::transfer(xcb_atom_t selection,
                    qint32 fd,
@@ -28,6 +46,14 @@ transfer::transfer(xcb_atom_t selection,
 {
 }
 
+void transfer::set_fd_nonblocking()
+{
+    auto const flags = fcntl(fd, F_GETFL);
+    if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+        qCWarning(KWIN_CORE) << "Failed to set selection transfer fd non-blocking:" << fd;
+    }
+}
+
 void transfer::create_socket_notifier(QSocketNotifier::Type type)
 {
     delete notifier;
@@ -71,6 +97,7 @@ wl_to_x11_transfer::wl_to_x11_transfer(xcb_atom_t selection,
                                        QObject* parent)
     : transfer(selection, fd, 0, x11, parent)
     , request(request)
+    , chunk_size{incr_chunk_size(x11.connection)}
 {
 }
 
@@ -82,6 +109,14 @@ wl_to_x11_transfer::~wl_to_x11_transfer()
 
 void wl_to_x11_transfer::start_transfer_from_source()
 {
+    set_fd_nonblocking();
+
+#ifdef F_SETPIPE_SZ
+    // Let the source write a full chunk before we are woken up. Fails harmlessly for non-pipes or
+    // when the size exceeds the user's limit.
+    fcntl(get_fd(), F_SETPIPE_SZ, chunk_size);
+#endif
+
     create_socket_notifier(QSocketNotifier::Read);
     connect(socket_notifier(), &QSocketNotifier::activated, this, [this](int socket) {
         Q_UNUSED(socket);
@@ -89,24 +124,28 @@ void wl_to_x11_transfer::start_transfer_from_source()
     });
 }
 
-int wl_to_x11_transfer::flush_source_data()
+void wl_to_x11_transfer::flush_source_data()
 {
+    auto const& front = chunks.front();
     xcb_change_property(x11.connection,
                         XCB_PROP_MODE_REPLACE,
                         request->requestor,
                         request->property,
                         request->target,
                         8,
-                        chunks.front().first.size(),
-                        chunks.front().first.data());
+                        front.size,
+                        front.data.constData());
     xcb_flush(x11.connection);
 
     property_is_set = true;
     reset_timeout();
 
-    auto const rm = chunks.front();
     chunks.pop_front();
-    return rm.first.size();
+
+    if (socket_notifier()) {
+        // Space for the next chunk has been freed.
+        socket_notifier()->setEnabled(true);
+    }
 }
 
 void wl_to_x11_transfer::start_incr()
@@ -117,7 +156,7 @@ void wl_to_x11_transfer::start_incr()
     xcb_change_window_attributes(x11.connection, request->requestor, XCB_CW_EVENT_MASK, mask);
 
     // spec says to make the available space larger
-    uint32_t const chunkSpace = 1024 + s_incrChunkSize;
+    uint32_t const chunkSpace = 1024 + chunk_size;
     xcb_change_property(x11.connection,
                         XCB_PROP_MODE_REPLACE,
                         request->requestor,
@@ -138,63 +177,98 @@ void wl_to_x11_transfer::start_incr()
 
 void wl_to_x11_transfer::read_wl_source()
 {
-    if (chunks.size() == 0 || chunks.back().second == s_incrChunkSize) {
-        // append new chunk
-        auto next = std::pair<QByteArray, int>();
-        next.first.resize(s_incrChunkSize);
-        next.second = 0;
-        chunks.push_back(next);
-    }
-
-    auto const oldLen = chunks.back().second;
-    auto const avail = s_incrChunkSize - chunks.back().second;
-    Q_ASSERT(avail > 0);
+    // Read until the source would block, so a single wakeup can fill multiple chunks.
+    while (socket_notifier()) {
+        if (chunks.empty() || chunks.back().size == chunk_size) {
+            if (chunks.size() >= s_maxPendingChunks) {
+                // Back-pressure: continue reading once the requestor has taken the next chunk.
+                socket_notifier()->setEnabled(false);
+                break;
+            }
+            chunks.push_back({QByteArray(chunk_size, Qt::Uninitialized), 0});
+        }
 
-    ssize_t readLen = read(get_fd(), chunks.back().first.data() + oldLen, avail);
-    if (readLen == -1) {
-        qCWarning(KWIN_CORE) << "Error reading in Wl data.";
+        auto& chunk = chunks.back();
+        auto const readLen
+            = read(get_fd(), chunk.data.data() + chunk.size, chunk_size - chunk.size);
 
-        // TODO: cleanup X side?
-        end_transfer();
-        return;
-    }
-    chunks.back().second = oldLen + readLen;
+        if (readLen == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (chunk.size == 0) {
+                    // Never flush an empty chunk before the end, it would terminate the transfer.
+                    chunks.pop_back();
+                }
+                break;
+            }
 
-    if (readLen == 0) {
-        // at the fd end - complete transfer now
-        chunks.back().first.resize(chunks.back().second);
+            qCWarning(KWIN_CORE) << "Error reading in Wl data.";
 
-        if (get_incr()) {
-            // incremental transfer is to be completed now
-            flush_property_on_delete = true;
-            if (!property_is_set) {
-                // flush if target's property is not set at the moment
-                flush_source_data();
-            }
-            clear_socket_notifier();
-        } else {
-            // non incremental transfer is to be completed now,
-            // data can be transferred to X client via a single property set
-            flush_source_data();
-            Q_EMIT selection_notify(request, true);
+            // TODO: cleanup X side?
             end_transfer();
+            return;
         }
-    } else if (chunks.back().second == s_incrChunkSize) {
-        // first chunk full, but not yet at fd end -> go incremental
-        if (get_incr()) {
-            flush_property_on_delete = true;
-            if (!property_is_set) {
-                // flush if target's property is not set at the moment
-                flush_source_data();
-            }
-        } else {
-            // starting incremental transfer
-            start_incr();
+
+        if (readLen == 0) {
+            // at the fd end - complete transfer now
+            handle_source_end();
+            return;
+        }
+
+        chunk.size += readLen;
+        if (chunk.size == chunk_size) {
+            handle_chunk_full();
         }
     }
     reset_timeout();
 }
 
+void wl_to_x11_transfer::handle_chunk_full()
+{
+    if (!get_incr()) {
+        // first chunk full, but not yet at fd end -> go incremental
+        start_incr();
+        return;
+    }
+
+    flush_property_on_delete = true;
+    if (!property_is_set) {
+        // flush if target's property is not set at the moment
+        flush_incr();
+    }
+}
+
+void wl_to_x11_transfer::handle_source_end()
+{
+    if (!chunks.empty() && chunks.back().size == 0) {
+        chunks.pop_back();
+    }
+
+    if (get_incr()) {
+        // incremental transfer is to be completed now
+        flush_property_on_delete = true;
+        clear_socket_notifier();
+        if (!property_is_set) {
+            // flush if target's property is not set at the moment
+            flush_incr();
+        }
+        reset_timeout();
+        return;
+    }
+
+    // non incremental transfer is to be completed now,
+    // data can be transferred to X client via a single property set
+    if (chunks.empty()) {
+        chunks.push_back({});
+    }
+    Q_EMIT data_read(chunks.front().data.left(chunks.front().size));
+    flush_source_data();
+    Q_EMIT selection_notify(request, true);
+    end_transfer();
+}
+
 bool wl_to_x11_transfer::handle_property_notify(xcb_property_notify_event_t* event)
 {
     if (event->window == request->requestor) {
@@ -215,27 +289,41 @@ void wl_to_x11_transfer::handle_property_delete()
     property_is_set = false;
 
     if (flush_property_on_delete) {
-        if (!socket_notifier() && chunks.empty()) {
-            // transfer complete
+        flush_incr();
+    }
+}
 
-            uint32_t mask[] = {0};
-            xcb_change_window_attributes(
-                x11.connection, request->requestor, XCB_CW_EVENT_MASK, mask);
-
-            xcb_change_property(x11.connection,
-                                XCB_PROP_MODE_REPLACE,
-                                request->requestor,
-                                request->property,
-                                request->target,
-                                8,
-                                0,
-                                nullptr);
-            xcb_flush(x11.connection);
-            flush_property_on_delete = false;
-            end_transfer();
-        } else {
-            flush_source_data();
+void wl_to_x11_transfer::flush_incr()
+{
+    auto const source_ended = !socket_notifier();
+
+    if (chunks.empty()) {
+        if (!source_ended) {
+            // Flushed once the next chunk is full or the source ends.
+            return;
         }
+
+        // transfer complete
+        uint32_t mask[] = {0};
+        xcb_change_window_attributes(x11.connection, request->requestor, XCB_CW_EVENT_MASK, mask);
+
+        xcb_change_property(x11.connection,
+                            XCB_PROP_MODE_REPLACE,
+                            request->requestor,
+                            request->property,
+                            request->target,
+                            8,
+                            0,
+                            nullptr);
+        xcb_flush(x11.connection);
+        flush_property_on_delete = false;
+        end_transfer();
+        return;
+    }
+
+    // Partially filled chunks are only sent at the end to keep the number of round trips low.
+    if (source_ended || chunks.front().size == chunk_size) {
+        flush_source_data();
     }
 }
 
@@ -248,6 +336,8 @@ x11_to_wl_transfer::x11_to_wl_transfer(xcb_atom_t selection,
                                        QObject* parent)
     : transfer(selection, fd, timestamp, x11, parent)
 {
+    set_fd_nonblocking();
+
     // create transfer window
     window = xcb_generate_id(x11.connection);
     uint32_t const values[] = {XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY | XCB_EVENT_MASK_PROPERTY_CHANGE};
@@ -514,11 +604,23 @@ void x11_to_wl_transfer::data_source_write()
 {
     auto property = receiver->get_data();
 
-    auto len = write(get_fd(), property.constData(), property.size());
-    if (len == -1) {
-        qCWarning(KWIN_CORE) << "X11 to Wayland write error on fd:" << get_fd();
-        end_transfer();
-        return;
+    // Write until the receiving client stops reading, so a single wakeup transfers as much as
+    // possible.
+    qsizetype len{0};
+    while (len < property.size()) {
+        auto const written = write(get_fd(), property.constData() + len, property.size() - len);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            qCWarning(KWIN_CORE) << "X11 to Wayland write error on fd:" << get_fd();
+            end_transfer();
+            return;
+        }
+        len += written;
     }
 
     receiver->part_read(len);
@@ -73,6 +73,7 @@ protected:
         timed_out = false;
     }
 
+    void set_fd_nonblocking();
     void create_socket_notifier(QSocketNotifier::Type type);
     void clear_socket_notifier();
     QSocketNotifier* socket_notifier() const
@@ -96,6 +97,9 @@ private:
 
 /**
  * Represents a transfer from a Wayland native source to an X window.
+ *
+ * Data is read in batches until the source would block. While the requestor has not yet picked up
+ * the previous chunk, only a limited number of chunks is buffered before reading pauses.
  */
 class COMO_EXPORT wl_to_x11_transfer : public transfer
 {
@@ -115,18 +119,31 @@ public:
 Q_SIGNALS:
     void selection_notify(xcb_selection_request_event_t* event, bool success);
 
+    /**
+     * Emitted with all data of the source when it was sent to the requestor in a single property.
+     */
+    void data_read(QByteArray const& data);
+
 private:
+    struct chunk {
+        QByteArray data;
+        // Number of bytes read into data. Data is allocated for the full chunk size up front.
+        uint32_t size{0};
+    };
+
     void start_incr();
     void read_wl_source();
-    int flush_source_data();
+    void handle_chunk_full();
+    void handle_source_end();
+    void flush_incr();
+    void flush_source_data();
     void handle_property_delete();
 
     xcb_selection_request_event_t* request = nullptr;
+    uint32_t const chunk_size;
 
-    /* contains all received data portioned in chunks
-     * TODO(romangg): explain second std::pair component
-     */
-    std::deque<std::pair<QByteArray, int>> chunks;
+    // Contains all received data portioned in chunks. Only the last one is not yet full.
+    std::deque<chunk> chunks;
 
     bool property_is_set = false;
     bool flush_property_on_delete = false;
@@ -31,6 +31,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include <QThread>
 #include <QtConcurrentRun>
 
+#include <chrono>
 #include <iostream>
 #include <sys/socket.h>
 
@@ -82,6 +83,8 @@ private:
             return;
         }
 
+        startup_begin = space.base.startup.now();
+
         std::vector<int> fds_to_close;
         auto fds_cleanup = qScopeGuard([&fds_to_close] {
             for (auto fd : fds_to_close) {
@@ -297,16 +300,24 @@ private:
                                       space.base.x11_data.root_window,
                                       win::x11::xcb_cursor_get(space, Qt::ArrowCursor));
 
-        win::x11::init_space(space);
+        {
+            base::startup_tracer::scope trace(
+                space.base.startup, QStringLiteral("x11 space"), QStringLiteral("win"));
+            win::x11::init_space(space);
+        }
         Q_EMIT space.base.qobject->x11_reset();
 
         // Trigger possible errors, there's still a chance to abort
         base::x11::xcb::sync(space.base.x11_data.connection);
 
         data_bridge = std::make_unique<xwl::data_bridge<Space>>(core);
+
+        // Xwayland is started on demand, so commonly this happens after the first frame.
+        space.base.startup.add(QStringLiteral("xwayland"), QStringLiteral("xwl"), startup_begin);
     }
 
     int xcb_connection_fd{-1};
+    std::chrono::nanoseconds startup_begin{0};
     QProcess* xwayland_process{nullptr};
     QMetaObject::Connection xwayland_fail_notifier;
 
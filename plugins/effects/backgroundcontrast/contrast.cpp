@@ -195,8 +195,10 @@ bool ContrastEffect::shouldContrast(effect::window_paint_data const& data) const
     if (!shader || !shader->isValid()) {
         return false;
     }
-    if (effects->activeFullScreenEffect()
-        && !data.window.data(WindowForceBackgroundContrastRole).toBool()) {
+    auto const force = data.window.data(effect::window_data::force_background_contrast);
+    auto const forced = force && *force;
+
+    if (effects->activeFullScreenEffect() && !forced) {
         return false;
     }
     if (data.window.isDesktop()) {
@@ -208,7 +210,7 @@ bool ContrastEffect::shouldContrast(effect::window_paint_data const& data) const
     auto const translated = data.paint.geo.translation.x() || data.paint.geo.translation.y();
 
     if ((scaled || (translated || (data.paint.mask & PAINT_WINDOW_TRANSFORMED)))
-        && !data.window.data(WindowForceBackgroundContrastRole).toBool()) {
+        && !forced) {
         return false;
     }
 
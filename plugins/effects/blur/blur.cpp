@@ -82,7 +82,7 @@ void BlurEffect::reset()
 static bool check_render_targets_are_valid(std::vector<blur_render_target> const& targets)
 {
     return !targets.empty() && std::all_of(targets.cbegin(), targets.cend(), [](auto&& target) {
-        return target.fbo->valid();
+        return target.fbo && target.fbo->valid();
     });
 }
 
@@ -132,29 +132,31 @@ void BlurEffect::update_texture(blur_render_data& screen)
         }
     }
 
+    auto pool = GLRenderTargetPool::instance();
     auto const screen_size = screen.screen.geometry().size();
     for (int i = 0; i <= downsample_count; i++) {
-        screen.targets.emplace_back(
-            std::make_unique<GLTexture>(textureFormat, screen_size / (1 << i)));
+        screen.targets.emplace_back(pool->acquire(
+            screen_size / (1 << i), textureFormat, GLRenderTargetPool::Fit::Exact));
     }
 
     // This last set is used as a temporary helper texture
-    screen.targets.emplace_back(std::make_unique<GLTexture>(textureFormat, screen_size));
+    screen.targets.emplace_back(
+        pool->acquire(screen_size, textureFormat, GLRenderTargetPool::Fit::Exact));
 
     screen.stack = {};
 
     // Upsample
     for (int i = 1; i < downsample_count; i++) {
-        screen.stack.push(screen.targets.at(i).fbo.get());
+        screen.stack.push(screen.targets.at(i).fbo);
     }
 
     // Downsample
     for (int i = downsample_count; i > 0; i--) {
-        screen.stack.push(screen.targets.at(i).fbo.get());
+        screen.stack.push(screen.targets.at(i).fbo);
     }
 
     // Copysample (with the original sized target)
-    screen.stack.push(screen.targets.front().fbo.get());
+    screen.stack.push(screen.targets.front().fbo);
 
     // Invalidate noise texture
     noise_texture = {};
@@ -468,7 +470,10 @@ bool BlurEffect::should_blur(effect::window_paint_data const& data) const
     if (!render_targets_are_valid || !shader || !shader->isValid()) {
         return false;
     }
-    if (effects->activeFullScreenEffect() && !data.window.data(WindowForceBlurRole).toBool()) {
+    auto const force = data.window.data(effect::window_data::force_blur);
+    auto const forced = force && *force;
+
+    if (effects->activeFullScreenEffect() && !forced) {
         return false;
     }
     if (data.window.isDesktop()) {
@@ -480,7 +485,7 @@ bool BlurEffect::should_blur(effect::window_paint_data const& data) const
     auto const translated = data.paint.geo.translation.x() || data.paint.geo.translation.y();
 
     if ((scaled || (translated || (data.paint.mask & PAINT_WINDOW_TRANSFORMED)))
-        && !data.window.data(WindowForceBlurRole).toBool()) {
+        && !forced) {
         return false;
     }
 
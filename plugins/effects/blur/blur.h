@@ -11,6 +11,7 @@
 #include <como/render/effect/interface/effect_screen.h>
 #include <como/render/gl/interface/framebuffer.h>
 #include <como/render/gl/interface/platform.h>
+#include <como/render/gl/interface/render_target_pool.h>
 #include <como/render/gl/interface/texture.h>
 
 #include <QVector2D>
@@ -27,16 +28,16 @@ static const int borderSize = 5;
 class BlurShader;
 
 struct blur_render_target {
-    blur_render_target(std::unique_ptr<GLTexture> tex)
-        : texture{std::move(tex)}
-        , fbo{std::make_unique<GLFramebuffer>(texture.get())}
+    blur_render_target(std::unique_ptr<GLRenderTarget> target)
+        : target{std::move(target)}
+        , texture{this->target ? this->target->texture() : nullptr}
+        , fbo{this->target ? this->target->framebuffer() : nullptr}
     {
-        texture->setFilter(GL_LINEAR);
-        texture->setWrapMode(GL_CLAMP_TO_EDGE);
     }
 
-    std::unique_ptr<GLTexture> texture;
-    std::unique_ptr<GLFramebuffer> fbo;
+    std::unique_ptr<GLRenderTarget> target;
+    GLTexture* texture;
+    GLFramebuffer* fbo;
 };
 
 struct blur_render_data {
@@ -409,8 +409,8 @@ void CubeSlideEffect::postPaintScreen()
         if (slideRotations.empty()) {
             auto const keys = staticWindows.keys();
             for (EffectWindow* w : std::as_const(keys)) {
-                w->setData(WindowForceBlurRole, QVariant());
-                w->setData(WindowForceBackgroundContrastRole, QVariant());
+                w->resetData(effect::window_data::force_blur);
+                w->resetData(effect::window_data::force_background_contrast);
             }
             staticWindows.clear();
             lastPresentTime = std::chrono::milliseconds::zero();
@@ -562,8 +562,8 @@ void CubeSlideEffect::startAnimation()
 
     for (auto w : windows) {
         if (!shouldAnimate(w)) {
-            w->setData(WindowForceBlurRole, QVariant(true));
-            w->setData(WindowForceBackgroundContrastRole, QVariant(true));
+            w->setData(effect::window_data::force_blur, true);
+            w->setData(effect::window_data::force_background_contrast, true);
             staticWindows[w] = EffectWindowVisibleRef(w, EffectWindow::PAINT_DISABLED_BY_DESKTOP);
         }
     }
@@ -594,8 +594,8 @@ void CubeSlideEffect::slotWindowAdded(EffectWindow* w)
     }
     if (!shouldAnimate(w)) {
         staticWindows[w] = EffectWindowVisibleRef(w, EffectWindow::PAINT_DISABLED_BY_DESKTOP);
-        w->setData(WindowForceBlurRole, QVariant(true));
-        w->setData(WindowForceBackgroundContrastRole, QVariant(true));
+        w->setData(effect::window_data::force_blur, true);
+        w->setData(effect::window_data::force_background_contrast, true);
     }
 }
 
@@ -765,8 +765,8 @@ void CubeSlideEffect::slotNumberDesktopsChanged()
 
     auto const keys = staticWindows.keys();
     for (auto w : std::as_const(keys)) {
-        w->setData(WindowForceBlurRole, QVariant());
-        w->setData(WindowForceBackgroundContrastRole, QVariant());
+        w->resetData(effect::window_data::force_blur);
+        w->resetData(effect::window_data::force_background_contrast);
     }
 
     slideRotations.clear();
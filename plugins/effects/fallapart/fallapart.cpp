@@ -188,10 +188,10 @@ void FallApartEffect::slotWindowClosed(EffectWindow* c)
     if (s_blacklist.contains(c->windowClass())) {
         return;
     }
-    const void* e = c->data(WindowClosedGrabRole).value<void*>();
-    if (e && e != this)
+    auto grab = c->data(effect::window_data::closed_grab);
+    if (grab && *grab != this)
         return;
-    c->setData(WindowClosedGrabRole, QVariant::fromValue(static_cast<void*>(this)));
+    c->setData(effect::window_data::closed_grab, this);
 
     auto& animation = windows[c];
     animation.progress = 0;
@@ -212,7 +212,7 @@ void FallApartEffect::slotWindowDataChanged(EffectWindow* w, int role)
         return;
     }
 
-    if (w->data(role).value<void*>() == this) {
+    if (auto grab = w->data(effect::window_data::closed_grab); grab && *grab == this) {
         return;
     }
 
@@ -167,12 +167,12 @@ void GlideEffect::windowAdded(EffectWindow* w)
         return;
     }
 
-    const void* addGrab = w->data(WindowAddedGrabRole).value<void*>();
-    if (addGrab && addGrab != this) {
+    auto addGrab = w->data(effect::window_data::added_grab);
+    if (addGrab && *addGrab != this) {
         return;
     }
 
-    w->setData(WindowAddedGrabRole, QVariant::fromValue(static_cast<void*>(this)));
+    w->setData(effect::window_data::added_grab, this);
 
     GlideAnimation& animation = m_animations[w];
     animation.timeLine.reset();
@@ -197,12 +197,12 @@ void GlideEffect::windowClosed(EffectWindow* w)
         return;
     }
 
-    const void* closeGrab = w->data(WindowClosedGrabRole).value<void*>();
-    if (closeGrab && closeGrab != this) {
+    auto closeGrab = w->data(effect::window_data::closed_grab);
+    if (closeGrab && *closeGrab != this) {
         return;
     }
 
-    w->setData(WindowClosedGrabRole, QVariant::fromValue(static_cast<void*>(this)));
+    w->setData(effect::window_data::closed_grab, this);
 
     GlideAnimation& animation = m_animations[w];
     animation.deletedRef = EffectWindowDeletedRef(w);
@@ -226,7 +226,8 @@ void GlideEffect::windowDataChanged(EffectWindow* w, int role)
         return;
     }
 
-    if (w->data(role).value<void*>() == this) {
+    auto grab = w->data(effect::window_data_slot<void const*>{role});
+    if (grab && *grab == this) {
         return;
     }
 
@@ -14,6 +14,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include <como/render/effect/interface/effects_handler.h>
 #include <como/render/effect/interface/paint_data.h>
 #include <como/render/gl/interface/framebuffer.h>
+#include <como/render/gl/interface/render_target_pool.h>
 #include <como/render/gl/interface/shader.h>
 #include <como/render/gl/interface/shader_manager.h>
 #include <como/render/gl/interface/texture.h>
@@ -32,8 +33,6 @@ MagnifierEffect::MagnifierEffect()
     , m_targetZoom(1)
     , m_polling(false)
     , m_lastPresentTime(std::chrono::milliseconds::zero())
-    , m_texture(nullptr)
-    , m_fbo(nullptr)
 {
     MagnifierConfig::instance(effects->config());
     QAction* a;
@@ -94,9 +93,8 @@ void MagnifierEffect::prePaintScreen(effect::screen_prepaint_data& data)
         else {
             m_zoom = qMax(m_zoom * qMin(1 - diff, 0.8), m_targetZoom);
             if (m_zoom == 1.0) {
-                // m_zoom ended - delete FBO and texture
-                m_fbo.reset();
-                m_texture.reset();
+                // m_zoom ended - give back the render target
+                m_renderTarget.reset();
             }
         }
     }
@@ -117,7 +115,7 @@ void MagnifierEffect::paintScreen(effect::screen_paint_data& data)
 {
     effects->paintScreen(data);
 
-    if (m_zoom == 1.0 || !effects->isOpenGLCompositing()) {
+    if (m_zoom == 1.0 || !m_renderTarget) {
         return;
     }
 
@@ -130,10 +128,11 @@ void MagnifierEffect::paintScreen(effect::screen_paint_data& data)
                   static_cast<double>(area.width()) / m_zoom,
                   static_cast<double>(area.height()) / m_zoom);
 
-    m_fbo->blit_from_current_render_target(data.render, srcArea, QRect(QPoint(), m_fbo->size()));
+    m_renderTarget->framebuffer()->blit_from_current_render_target(
+        data.render, srcArea, QRect(QPoint(), m_renderTarget->size()));
 
     // paint magnifier
-    m_texture->bind();
+    m_renderTarget->texture()->bind();
 
     auto s = ShaderManager::instance()->pushShader(ShaderTrait::MapTexture);
     auto const size = effects->virtualScreenSize();
@@ -143,9 +142,9 @@ void MagnifierEffect::paintScreen(effect::screen_paint_data& data)
     mvp.translate(area.x(), area.y());
 
     s->setUniform(GLShader::ModelViewProjectionMatrix, mvp);
-    m_texture->render(area.size());
+    m_renderTarget->texture()->render(area.size());
     ShaderManager::instance()->popShader();
-    m_texture->unbind();
+    m_renderTarget->texture()->unbind();
 
     QVector<QVector2D> verts;
     auto vbo = GLVertexBuffer::streamingBuffer();
@@ -218,12 +217,10 @@ void MagnifierEffect::zoomIn()
         m_polling = true;
         effects->startMousePolling();
     }
-    if (effects->isOpenGLCompositing() && !m_texture) {
+    if (effects->isOpenGLCompositing() && !m_renderTarget) {
         effects->makeOpenGLContextCurrent();
-        m_texture = std::make_unique<GLTexture>(
-            GL_RGBA16F, m_magnifierSize.width(), m_magnifierSize.height());
-        m_texture->set_content_transform(effect::transform_type::normal);
-        m_fbo = std::make_unique<GLFramebuffer>(m_texture.get());
+        m_renderTarget = GLRenderTargetPool::instance()->acquire(
+            m_magnifierSize, GL_RGBA16F, GLRenderTargetPool::Fit::Exact);
     }
     effects->addRepaint(
         magnifierArea().adjusted(-FRAME_WIDTH, -FRAME_WIDTH, FRAME_WIDTH, FRAME_WIDTH));
@@ -240,8 +237,7 @@ void MagnifierEffect::zoomOut()
         }
         if (m_zoom == m_targetZoom) {
             effects->makeOpenGLContextCurrent();
-            m_fbo.reset();
-            m_texture.reset();
+            m_renderTarget.reset();
         }
     }
     effects->addRepaint(
@@ -258,12 +254,10 @@ void MagnifierEffect::toggle()
             m_polling = true;
             effects->startMousePolling();
         }
-        if (effects->isOpenGLCompositing() && !m_texture) {
+        if (effects->isOpenGLCompositing() && !m_renderTarget) {
             effects->makeOpenGLContextCurrent();
-            m_texture = std::make_unique<GLTexture>(
-                GL_RGBA16F, m_magnifierSize.width(), m_magnifierSize.height());
-            m_texture->set_content_transform(effect::transform_type::normal);
-            m_fbo = std::make_unique<GLFramebuffer>(m_texture.get());
+            m_renderTarget = GLRenderTargetPool::instance()->acquire(
+                m_magnifierSize, GL_RGBA16F, GLRenderTargetPool::Fit::Exact);
         }
     } else {
         m_targetZoom = 1;
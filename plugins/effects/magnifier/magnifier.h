@@ -14,8 +14,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 namespace como
 {
 
-class GLFramebuffer;
-class GLTexture;
+class GLRenderTarget;
 
 class MagnifierEffect : public Effect
 {
@@ -55,8 +54,7 @@ private:
     bool m_polling; // Mouse polling
     std::chrono::milliseconds m_lastPresentTime;
     QSize m_magnifierSize;
-    std::unique_ptr<GLTexture> m_texture;
-    std::unique_ptr<GLFramebuffer> m_fbo;
+    std::unique_ptr<GLRenderTarget> m_renderTarget;
 };
 
 } // namespace
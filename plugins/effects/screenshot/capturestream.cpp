@@ -0,0 +1,253 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "capturestream.h"
+#include "capturestreamframe.h"
+
+#include <QSocketNotifier>
+#include <QtConcurrentRun>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <time.h>
+
+namespace como
+{
+
+static uint32_t s_nextStreamId{1};
+
+static uint64_t monotonicTimestamp()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000ull + ts.tv_nsec / 1000;
+}
+
+CaptureStream::CaptureStream(ScreenShotFlags flags,
+                             int maxFrameRate,
+                             file_descriptor&& fileDescriptor)
+    : m_id{s_nextStreamId++}
+    , m_flags{flags}
+    , m_fileDescriptor{std::make_shared<file_descriptor>(std::move(fileDescriptor))}
+{
+    if (maxFrameRate > 0) {
+        m_frameInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1. / maxFrameRate));
+    }
+
+    auto const fd = m_fileDescriptor->fd;
+    if (auto const fd_flags = fcntl(fd, F_GETFL, 0); fd_flags != -1 && !(fd_flags & O_NONBLOCK)) {
+        fcntl(fd, F_SETFL, fd_flags | O_NONBLOCK);
+    }
+
+    m_writeNotifier = std::make_unique<QSocketNotifier>(fd, QSocketNotifier::Write);
+    m_writeNotifier->setEnabled(false);
+    connect(m_writeNotifier.get(),
+            &QSocketNotifier::activated,
+            this,
+            &CaptureStream::writePending);
+}
+
+CaptureStream::CaptureStream(EffectScreen* screen,
+                             ScreenShotFlags flags,
+                             int maxFrameRate,
+                             file_descriptor&& fileDescriptor)
+    : CaptureStream(flags, maxFrameRate, std::move(fileDescriptor))
+{
+    m_screen = screen;
+}
+
+CaptureStream::CaptureStream(EffectWindow* window,
+                             ScreenShotFlags flags,
+                             int maxFrameRate,
+                             file_descriptor&& fileDescriptor)
+    : CaptureStream(flags, maxFrameRate, std::move(fileDescriptor))
+{
+    m_window = window;
+}
+
+CaptureStream::~CaptureStream() = default;
+
+uint32_t CaptureStream::id() const
+{
+    return m_id;
+}
+
+EffectScreen* CaptureStream::screen() const
+{
+    return m_screen;
+}
+
+EffectWindow* CaptureStream::window() const
+{
+    return m_window;
+}
+
+ScreenShotFlags CaptureStream::flags() const
+{
+    return m_flags;
+}
+
+void CaptureStream::addDamage(QRegion const& region)
+{
+    m_damage += region;
+}
+
+QRegion CaptureStream::damage() const
+{
+    return m_damage;
+}
+
+bool CaptureStream::wantsFrame() const
+{
+    return !m_damage.isEmpty() && canSend();
+}
+
+bool CaptureStream::wantsCursorFrame() const
+{
+    return (m_flags & ScreenShotIncludeCursor) && canSend();
+}
+
+bool CaptureStream::canSend() const
+{
+    return !m_inFlight && std::chrono::steady_clock::now() - m_lastFrame >= m_frameInterval;
+}
+
+void CaptureStream::submit(QFuture<QImage> const& snapshot,
+                           QRect const& sourceGeometry,
+                           QRect const& snapshotRect,
+                           qreal devicePixelRatio,
+                           ScreenShotCursor const& cursor)
+{
+    capture::frame_header header;
+    header.sequence = m_sequence++;
+    header.timestamp_us = monotonicTimestamp();
+
+    if (!cursor.image.isNull()) {
+        header.cursor_flags |= capture::cursor_visible;
+        // Comparing the cache keys avoids comparing the pixels. A changed image always gets a new
+        // key, at worst an unchanged image is sent again.
+        if (auto const key = cursor.image.cacheKey(); key != m_cursorImageKey) {
+            header.cursor_flags |= capture::cursor_image_changed;
+            m_cursorImageKey = key;
+        }
+    }
+
+    // Damage in logical coordinates relative to the source.
+    QList<QRect> damage;
+    for (auto const& rect : m_damage & sourceGeometry) {
+        damage.append(rect.translated(-sourceGeometry.topLeft()));
+    }
+    m_damage = {};
+
+    m_inFlight = true;
+    m_lastFrame = std::chrono::steady_clock::now();
+    m_sourceGeometry = sourceGeometry;
+
+    auto const sourceSize = sourceGeometry.size();
+    auto const snapshotOffset = snapshotRect.topLeft() - sourceGeometry.topLeft();
+    auto const snapshotWidth = snapshotRect.width();
+
+    snapshot
+        .then(QtFuture::Launch::Async,
+              [header,
+               damage,
+               sourceSize,
+               snapshotOffset,
+               snapshotWidth,
+               devicePixelRatio,
+               cursor](QImage image) mutable {
+                  // The snapshot may be scaled differently than requested, take its real scale.
+                  auto const scale = image.isNull() || snapshotWidth <= 0
+                      ? devicePixelRatio
+                      : static_cast<qreal>(image.width()) / snapshotWidth;
+
+                  auto toDevice = [scale](QRect const& rect) {
+                      return QRectF(QPointF(rect.topLeft()) * scale, QSizeF(rect.size()) * scale)
+                          .toAlignedRect();
+                  };
+
+                  std::vector<capture::frame_rect> rects;
+                  for (auto const& rect : std::as_const(damage)) {
+                      auto const device = toDevice(rect);
+                      rects.push_back({device.x(), device.y(), device.width(), device.height()});
+                  }
+
+                  header.width = qRound(sourceSize.width() * scale);
+                  header.height = qRound(sourceSize.height() * scale);
+                  header.cursor_x = qRound(cursor.position.x() * scale);
+                  header.cursor_y = qRound(cursor.position.y() * scale);
+
+                  auto const offset = (QPointF(snapshotOffset) * scale).toPoint();
+                  return capture::encode_frame(header, image, offset, rects, cursor.image);
+              })
+        .then(this,
+              [this](std::vector<uint8_t> data) {
+                  m_pending = std::move(data);
+                  m_written = 0;
+                  writePending();
+              })
+        .onCanceled(this, [this] {
+            // The snapshot got lost. Resend everything with the next frame.
+            m_inFlight = false;
+            m_damage = m_sourceGeometry;
+        });
+}
+
+void CaptureStream::writePending()
+{
+    auto const fd = m_fileDescriptor->fd;
+
+    // Writing to a pipe without reader raises SIGPIPE. Check first if the consumer is gone.
+    pollfd pfd{fd, POLLOUT, 0};
+    if (poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLERR | POLLHUP))) {
+        m_writeNotifier->setEnabled(false);
+        Q_EMIT closed();
+        return;
+    }
+
+    while (m_written < m_pending.size()) {
+        auto const count = ::write(fd, m_pending.data() + m_written, m_pending.size() - m_written);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN) {
+                // Continue when the consumer has read from the pipe. Until then no new frames
+                // are captured and damage accumulates for the next one.
+                m_writeNotifier->setEnabled(true);
+                return;
+            }
+
+            qCWarning(KWIN_SCREENSHOT) << "Writing to capture stream failed:" << strerror(errno);
+            m_writeNotifier->setEnabled(false);
+            Q_EMIT closed();
+            return;
+        }
+        m_written += count;
+    }
+
+    m_writeNotifier->setEnabled(false);
+    m_pending = {};
+    m_written = 0;
+    m_inFlight = false;
+}
+
+void CaptureStream::submitCursor(QRect const& sourceGeometry,
+                                 qreal devicePixelRatio,
+                                 ScreenShotCursor const& cursor)
+{
+    auto const damage = std::exchange(m_damage, {});
+    submit(QtFuture::makeReadyValueFuture(QImage()),
+           sourceGeometry,
+           sourceGeometry,
+           devicePixelRatio,
+           cursor);
+    m_damage = damage;
+}
+
+}
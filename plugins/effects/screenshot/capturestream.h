@@ -0,0 +1,126 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "screenshot.h"
+
+#include <como/utils/file_descriptor.h>
+
+#include <QFuture>
+#include <QObject>
+#include <QRegion>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class QSocketNotifier;
+
+namespace como
+{
+
+/**
+ * A capture stream continuously sends frames of a screen or a window to a file descriptor, for
+ * example a pipe. Only the damaged parts of the source are sent. See capturestreamframe.h for the
+ * wire format.
+ *
+ * Frames are only captured in paint passes that happen anyway. At most one frame is in flight,
+ * from capturing it until it is fully written. Damage accumulates while a frame is in flight, for
+ * example because the consumer does not read fast enough, or the frame rate limit is reached. It
+ * is sent with the next captured frame.
+ */
+class CaptureStream : public QObject
+{
+    Q_OBJECT
+
+public:
+    CaptureStream(EffectScreen* screen,
+                  ScreenShotFlags flags,
+                  int maxFrameRate,
+                  file_descriptor&& fileDescriptor);
+    CaptureStream(EffectWindow* window,
+                  ScreenShotFlags flags,
+                  int maxFrameRate,
+                  file_descriptor&& fileDescriptor);
+    ~CaptureStream() override;
+
+    uint32_t id() const;
+    EffectScreen* screen() const;
+    EffectWindow* window() const;
+    ScreenShotFlags flags() const;
+
+    /**
+     * Adds @a region in logical global coordinates to the damage that is sent with the next
+     * frame.
+     */
+    void addDamage(QRegion const& region);
+    QRegion damage() const;
+
+    /**
+     * Whether a frame should be captured in the current paint pass.
+     */
+    bool wantsFrame() const;
+
+    /**
+     * Whether a frame with only the cursor can be sent now.
+     */
+    bool wantsCursorFrame() const;
+
+    /**
+     * Sends the damaged parts of @a snapshot once it is ready. The @a snapshot shows
+     * @a snapshotRect of the source with @a sourceGeometry, both in logical global coordinates.
+     */
+    void submit(QFuture<QImage> const& snapshot,
+                QRect const& sourceGeometry,
+                QRect const& snapshotRect,
+                qreal devicePixelRatio,
+                ScreenShotCursor const& cursor);
+
+    /**
+     * Sends a frame without damage to update the cursor metadata.
+     */
+    void submitCursor(QRect const& sourceGeometry,
+                      qreal devicePixelRatio,
+                      ScreenShotCursor const& cursor);
+
+Q_SIGNALS:
+    /**
+     * Emitted when the consumer closed the file descriptor or writing failed.
+     */
+    void closed();
+
+private:
+    CaptureStream(ScreenShotFlags flags, int maxFrameRate, file_descriptor&& fileDescriptor);
+    bool canSend() const;
+
+    /**
+     * Writes the encoded frame without blocking. If the pipe is full, writing continues once the
+     * consumer has read from it.
+     */
+    void writePending();
+
+    uint32_t m_id;
+    EffectScreen* m_screen{nullptr};
+    EffectWindow* m_window{nullptr};
+    ScreenShotFlags m_flags;
+
+    std::chrono::steady_clock::duration m_frameInterval{0};
+    std::chrono::steady_clock::time_point m_lastFrame;
+
+    std::shared_ptr<file_descriptor> m_fileDescriptor;
+    QRegion m_damage;
+    QRect m_sourceGeometry;
+    bool m_inFlight{false};
+
+    std::vector<uint8_t> m_pending;
+    size_t m_written{0};
+    std::unique_ptr<QSocketNotifier> m_writeNotifier;
+
+    uint32_t m_sequence{0};
+    qint64 m_cursorImageKey{0};
+};
+
+}
@@ -0,0 +1,225 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <unistd.h>
+#include <vector>
+
+namespace como::capture
+{
+
+/**
+ * Wire format of the frames of a capture stream. All fields are in host byte order.
+ *
+ * A frame starts with a frame_header followed by rect_count frame_rects. After that come the
+ * pixels of each rect in the same order with tightly packed rows of four bytes per pixel. If the
+ * cursor image changed since the last frame, its pixels follow at the end in
+ * QImage::Format_ARGB32_Premultiplied.
+ */
+constexpr uint32_t frame_magic{0x46534d43};
+
+enum frame_cursor_flag : uint32_t {
+    cursor_visible = 0x1,
+    cursor_image_changed = 0x2,
+};
+
+struct frame_header {
+    uint32_t magic{frame_magic};
+    uint32_t sequence{0};
+
+    // Monotonic clock time in microseconds when the frame was captured.
+    uint64_t timestamp_us{0};
+
+    // Size of the captured output or window in device pixels.
+    int32_t width{0};
+    int32_t height{0};
+
+    // A QImage::Format value with 32 bits per pixel.
+    uint32_t format{QImage::Format_ARGB32};
+    uint32_t rect_count{0};
+
+    // Position of the cursor image relative to the captured source in device pixels.
+    int32_t cursor_x{0};
+    int32_t cursor_y{0};
+    uint32_t cursor_flags{0};
+    int32_t cursor_width{0};
+    int32_t cursor_height{0};
+};
+
+struct frame_rect {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+};
+
+struct frame {
+    frame_header header;
+    std::vector<frame_rect> rects;
+
+    // Pixels of all rects one after another.
+    std::vector<uint8_t> pixels;
+    QImage cursor;
+};
+
+inline void append_bytes(std::vector<uint8_t>& data, void const* src, size_t size)
+{
+    auto const bytes = static_cast<uint8_t const*>(src);
+    data.insert(data.end(), bytes, bytes + size);
+}
+
+/**
+ * Serializes a frame. The @a rects are given in device pixels of the captured source, @a offset is
+ * the position of @a image in the source. Parts of the rects outside of @a image are clipped.
+ */
+inline std::vector<uint8_t> encode_frame(frame_header header,
+                                         QImage const& image,
+                                         QPoint const& offset,
+                                         std::vector<frame_rect> const& rects,
+                                         QImage const& cursor)
+{
+    assert(image.isNull() || image.depth() == 32);
+
+    std::vector<frame_rect> clipped;
+    size_t pixel_bytes{0};
+
+    for (auto const& rect : rects) {
+        auto const local = QRect(rect.x, rect.y, rect.width, rect.height).translated(-offset)
+            & image.rect();
+        if (local.isEmpty()) {
+            continue;
+        }
+        clipped.push_back(
+            {local.x() + offset.x(), local.y() + offset.y(), local.width(), local.height()});
+        pixel_bytes += local.width() * local.height() * 4;
+    }
+
+    QImage cursor_image;
+    if (header.cursor_flags & cursor_image_changed) {
+        cursor_image = cursor.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        header.cursor_width = cursor_image.width();
+        header.cursor_height = cursor_image.height();
+        pixel_bytes += cursor_image.width() * cursor_image.height() * 4;
+    }
+
+    header.format = image.isNull() ? QImage::Format_ARGB32 : image.format();
+    header.rect_count = clipped.size();
+
+    std::vector<uint8_t> data;
+    data.reserve(sizeof(header) + clipped.size() * sizeof(frame_rect) + pixel_bytes);
+
+    append_bytes(data, &header, sizeof(header));
+    append_bytes(data, clipped.data(), clipped.size() * sizeof(frame_rect));
+
+    for (auto const& rect : clipped) {
+        for (int y = 0; y < rect.height; ++y) {
+            auto const line = image.constScanLine(rect.y - offset.y() + y);
+            append_bytes(data, line + (rect.x - offset.x()) * 4, rect.width * 4);
+        }
+    }
+
+    for (int y = 0; y < cursor_image.height(); ++y) {
+        append_bytes(data, cursor_image.constScanLine(y), cursor_image.width() * 4);
+    }
+
+    return data;
+}
+
+inline bool read_bytes(int fd, void* dst, size_t size)
+{
+    auto bytes = static_cast<uint8_t*>(dst);
+
+    while (size > 0) {
+        auto const count = ::read(fd, bytes, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= count;
+    }
+
+    return true;
+}
+
+/**
+ * Reads the next frame from the blocking @a fd. Returns an empty optional at the end of the
+ * stream or on malformed data.
+ */
+inline std::optional<frame> read_frame(int fd)
+{
+    frame frm;
+
+    if (!read_bytes(fd, &frm.header, sizeof(frm.header)) || frm.header.magic != frame_magic) {
+        return {};
+    }
+
+    frm.rects.resize(frm.header.rect_count);
+    if (!read_bytes(fd, frm.rects.data(), frm.rects.size() * sizeof(frame_rect))) {
+        return {};
+    }
+
+    size_t pixel_bytes{0};
+    for (auto const& rect : frm.rects) {
+        pixel_bytes += rect.width * rect.height * 4;
+    }
+
+    frm.pixels.resize(pixel_bytes);
+    if (!read_bytes(fd, frm.pixels.data(), pixel_bytes)) {
+        return {};
+    }
+
+    if (frm.header.cursor_flags & cursor_image_changed) {
+        frm.cursor = QImage(frm.header.cursor_width,
+                            frm.header.cursor_height,
+                            QImage::Format_ARGB32_Premultiplied);
+        for (int y = 0; y < frm.cursor.height(); ++y) {
+            if (!read_bytes(fd, frm.cursor.scanLine(y), frm.cursor.width() * 4)) {
+                return {};
+            }
+        }
+    }
+
+    return frm;
+}
+
+/**
+ * Updates @a target with the damaged rects of @a frm. The target is reallocated when the frame
+ * size or format changed.
+ */
+inline void apply_frame(QImage& target, frame const& frm)
+{
+    auto const size = QSize(frm.header.width, frm.header.height);
+    auto const format = static_cast<QImage::Format>(frm.header.format);
+
+    if (target.size() != size || target.format() != format) {
+        target = QImage(size, format);
+        target.fill(Qt::transparent);
+    }
+
+    auto src = frm.pixels.data();
+    for (auto const& rect : frm.rects) {
+        if (!target.rect().contains(QRect(rect.x, rect.y, rect.width, rect.height))) {
+            src += rect.width * rect.height * 4;
+            continue;
+        }
+        for (int y = 0; y < rect.height; ++y) {
+            std::memcpy(target.scanLine(rect.y + y) + rect.x * 4, src, rect.width * 4);
+            src += rect.width * 4;
+        }
+    }
+}
+
+}
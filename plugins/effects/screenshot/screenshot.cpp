@@ -6,14 +6,18 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "screenshot.h"
+#include "capturestream.h"
 #include "screenshotdbusinterface2.h"
 
 #include <como/render/effect/interface/effect_window.h>
 #include <como/render/effect/interface/effects_handler.h>
 #include <como/render/gl/interface/framebuffer.h>
+#include <como/render/gl/interface/pixel_readback.h>
 #include <como/render/gl/interface/texture.h>
 
 #include <QPainter>
+#include <QtConcurrentRun>
+#include <algorithm>
 
 Q_LOGGING_CATEGORY(KWIN_SCREENSHOT, "kwin_effect_screenshot", QtWarningMsg)
 
@@ -32,6 +36,10 @@ struct ScreenShotAreaData {
     QRect area;
     QImage result;
     QList<EffectScreen*> screens;
+
+    // Snapshots of the painted screens and their source rectangles in the area.
+    QList<QFuture<QImage>> snapshots;
+    QList<QRect> sourceRects;
 };
 
 struct ScreenShotScreenData {
@@ -40,6 +48,46 @@ struct ScreenShotScreenData {
     EffectScreen* screen = nullptr;
 };
 
+struct ScreenShotReadback {
+    std::unique_ptr<GLTexture> texture;
+    std::unique_ptr<GLFramebuffer> fbo;
+    std::unique_ptr<GLPixelReadback> pixels;
+    qreal devicePixelRatio{1.};
+
+    QPromise<QImage> promise;
+
+    // Copies the mapped pixels on a worker thread. The buffer is unmapped once it finished.
+    QFuture<void> copy;
+    bool copying{false};
+};
+
+static void drawCursor(QImage& snapshot, ScreenShotCursor const& cursor)
+{
+    if (cursor.image.isNull()) {
+        return;
+    }
+
+    QPainter painter(&snapshot);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawImage(cursor.position, cursor.image);
+}
+
+/**
+ * Finishes @a promise with the image of @a snapshot after drawing @a cursor on it. The drawing
+ * happens in the thread finishing @a snapshot.
+ */
+static void
+finishScreenShot(QFuture<QImage> snapshot, QPromise<QImage>&& promise, ScreenShotCursor cursor)
+{
+    auto shared_promise = std::make_shared<QPromise<QImage>>(std::move(promise));
+
+    snapshot.then([shared_promise, cursor](QImage image) {
+        drawCursor(image, cursor);
+        shared_promise->addResult(image);
+        shared_promise->finish();
+    });
+}
+
 static void
 convertFromGLImage(QImage& img, int w, int h, QMatrix4x4 const& renderTargetTransformation)
 {
@@ -88,6 +136,15 @@ ScreenShotEffect::ScreenShotEffect()
     connect(effects, &EffectsHandler::screenAdded, this, &ScreenShotEffect::handleScreenAdded);
     connect(effects, &EffectsHandler::screenRemoved, this, &ScreenShotEffect::handleScreenRemoved);
     connect(effects, &EffectsHandler::windowClosed, this, &ScreenShotEffect::handleWindowClosed);
+    connect(effects, &EffectsHandler::mouseChanged, this, &ScreenShotEffect::handleMouseChanged);
+    connect(
+        effects, &EffectsHandler::cursorShapeChanged, this, &ScreenShotEffect::handleMouseChanged);
+
+    // Readbacks are polled after each painted frame. The timer only fires when no frame is
+    // painted for about a refresh cycle.
+    m_readbackTimer.setTimerType(Qt::CoarseTimer);
+    m_readbackTimer.setInterval(16);
+    connect(&m_readbackTimer, &QTimer::timeout, this, &ScreenShotEffect::pollReadbacks);
 }
 
 ScreenShotEffect::~ScreenShotEffect()
@@ -95,6 +152,21 @@ ScreenShotEffect::~ScreenShotEffect()
     cancelWindowScreenShots();
     cancelAreaScreenShots();
     cancelScreenScreenShots();
+
+    for (auto stream : std::vector(m_captureStreams)) {
+        removeCaptureStream(stream);
+    }
+
+    for (auto& readback : m_readbacks) {
+        if (readback->copying) {
+            readback->copy.waitForFinished();
+        }
+    }
+
+    if (!m_readbacks.empty() && effects->makeOpenGLContextCurrent()) {
+        m_readbacks.clear();
+        effects->doneOpenGLContextCurrent();
+    }
 }
 
 QFuture<QImage> ScreenShotEffect::scheduleScreenShot(EffectScreen* screen, ScreenShotFlags flags)
@@ -216,26 +288,193 @@ void ScreenShotEffect::paintScreen(effect::screen_paint_data& data)
             m_screenScreenShots.erase(m_screenScreenShots.begin() + i);
         }
     }
+
+    for (auto stream : m_captureStreams) {
+        captureStreamFrame(data, stream);
+    }
+}
+
+void ScreenShotEffect::postPaintScreen()
+{
+    effects->postPaintScreen();
+
+    // The context is still current from painting.
+    if (!m_readbacks.empty()) {
+        processReadbacks();
+    }
+}
+
+CaptureStream* ScreenShotEffect::startCaptureStream(EffectScreen* screen,
+                                                    ScreenShotFlags flags,
+                                                    int maxFrameRate,
+                                                    file_descriptor&& fileDescriptor)
+{
+    auto stream = new CaptureStream(screen, flags, maxFrameRate, std::move(fileDescriptor));
+    addCaptureStream(stream, screen->geometry());
+    return stream;
+}
+
+CaptureStream* ScreenShotEffect::startCaptureStream(EffectWindow* window,
+                                                    ScreenShotFlags flags,
+                                                    int maxFrameRate,
+                                                    file_descriptor&& fileDescriptor)
+{
+    auto stream = new CaptureStream(window, flags, maxFrameRate, std::move(fileDescriptor));
+    addCaptureStream(stream, windowCaptureGeometry(window, flags));
+    return stream;
+}
+
+bool ScreenShotEffect::stopCaptureStream(uint32_t id)
+{
+    auto it = std::find_if(m_captureStreams.begin(), m_captureStreams.end(), [id](auto stream) {
+        return stream->id() == id;
+    });
+    if (it == m_captureStreams.end()) {
+        return false;
+    }
+
+    removeCaptureStream(*it);
+    return true;
+}
+
+void ScreenShotEffect::addCaptureStream(CaptureStream* stream, QRect const& geometry)
+{
+    stream->setParent(this);
+    connect(stream, &CaptureStream::closed, this, [this, stream] { removeCaptureStream(stream); });
+
+    if (stream->flags() & ScreenShotIncludeCursor) {
+        if (m_cursorStreamCount++ == 0) {
+            effects->startMousePolling();
+        }
+    }
+
+    m_captureStreams.push_back(stream);
+
+    // The first frame must contain everything. This is the only repaint a stream requests.
+    stream->addDamage(geometry);
+    effects->addRepaint(geometry);
+}
+
+void ScreenShotEffect::removeCaptureStream(CaptureStream* stream)
+{
+    std::erase(m_captureStreams, stream);
+
+    if (stream->flags() & ScreenShotIncludeCursor) {
+        if (--m_cursorStreamCount == 0) {
+            effects->stopMousePolling();
+        }
+    }
+
+    stream->deleteLater();
+}
+
+void ScreenShotEffect::captureStreamFrame(effect::screen_paint_data& data, CaptureStream* stream)
+{
+    if (auto screen = stream->screen()) {
+        if (m_paintedScreen && m_paintedScreen != screen) {
+            return;
+        }
+
+        auto const geometry = screen->geometry();
+        stream->addDamage(data.paint.region & geometry);
+        if (!stream->wantsFrame()) {
+            return;
+        }
+
+        auto devicePixelRatio = 1.;
+        if (stream->flags() & ScreenShotNativeResolution) {
+            devicePixelRatio = screen->devicePixelRatio();
+        }
+
+        // Read back only what has changed since the last frame.
+        auto const snapshotRect = stream->damage().boundingRect() & geometry;
+
+        stream->submit(readbackScreenshot(data.render, snapshotRect, devicePixelRatio),
+                       geometry,
+                       snapshotRect,
+                       devicePixelRatio,
+                       grabPointer(stream->flags(), geometry.topLeft()));
+        return;
+    }
+
+    auto window = stream->window();
+    auto const geometry = windowCaptureGeometry(window, stream->flags());
+
+    if (m_paintedScreen && !m_paintedScreen->geometry().intersects(geometry)) {
+        return;
+    }
+
+    stream->addDamage(data.paint.region & geometry);
+    if (!stream->wantsFrame()) {
+        return;
+    }
+
+    auto const devicePixelRatio = windowDevicePixelRatio(window, stream->flags());
+    stream->submit(captureWindow(data.render, window, geometry, devicePixelRatio),
+                   geometry,
+                   geometry,
+                   devicePixelRatio,
+                   grabPointer(stream->flags(), geometry.topLeft()));
+}
+
+void ScreenShotEffect::handleMouseChanged()
+{
+    for (auto stream : m_captureStreams) {
+        if (!stream->wantsCursorFrame()) {
+            continue;
+        }
+
+        auto const geometry = stream->screen()
+            ? stream->screen()->geometry()
+            : windowCaptureGeometry(stream->window(), stream->flags());
+        auto const devicePixelRatio = stream->screen()
+            ? (stream->flags() & ScreenShotNativeResolution ? stream->screen()->devicePixelRatio()
+                                                             : 1.)
+            : windowDevicePixelRatio(stream->window(), stream->flags());
+
+        stream->submitCursor(
+            geometry, devicePixelRatio, grabPointer(stream->flags(), geometry.topLeft()));
+    }
 }
 
 void ScreenShotEffect::takeScreenShot(effect::render_data& data, ScreenShotWindowData* screenshot)
 {
     auto window = screenshot->window;
-    auto geometry = window->expandedGeometry();
-    auto devicePixelRatio = 1.;
+    auto const geometry = windowCaptureGeometry(window, screenshot->flags);
+    auto const snapshot
+        = captureWindow(data, window, geometry, windowDevicePixelRatio(window, screenshot->flags));
 
-    if (window->hasDecoration() && !(screenshot->flags & ScreenShotIncludeDecoration)) {
-        geometry = window->clientGeometry();
-    } else if (!(screenshot->flags & ScreenShotIncludeShadow)) {
-        geometry = window->frameGeometry();
+    finishScreenShot(snapshot,
+                     std::move(screenshot->promise),
+                     grabPointer(screenshot->flags, geometry.topLeft()));
+}
+
+QRect ScreenShotEffect::windowCaptureGeometry(EffectWindow* window, ScreenShotFlags flags)
+{
+    if (window->hasDecoration() && !(flags & ScreenShotIncludeDecoration)) {
+        return window->clientGeometry();
     }
+    if (!(flags & ScreenShotIncludeShadow)) {
+        return window->frameGeometry();
+    }
+    return window->expandedGeometry();
+}
 
-    if (screenshot->flags & ScreenShotNativeResolution) {
+qreal ScreenShotEffect::windowDevicePixelRatio(EffectWindow* window, ScreenShotFlags flags)
+{
+    if (flags & ScreenShotNativeResolution) {
         if (auto const screen = window->screen()) {
-            devicePixelRatio = screen->devicePixelRatio();
+            return screen->devicePixelRatio();
         }
     }
+    return 1.;
+}
 
+QFuture<QImage> ScreenShotEffect::captureWindow(effect::render_data& data,
+                                                EffectWindow* window,
+                                                QRect const& geometry,
+                                                qreal devicePixelRatio)
+{
     auto validTarget = true;
     std::unique_ptr<GLTexture> offscreenTexture;
     std::unique_ptr<GLFramebuffer> fbo;
@@ -249,13 +488,21 @@ void ScreenShotEffect::takeScreenShot(effect::render_data& data, ScreenShotWindo
     }
 
     if (!validTarget) {
-        return;
+        // Default constructed futures are canceled.
+        return {};
     }
 
-    QImage img;
+    auto const async = GLPixelReadback::supported();
+    QFuture<QImage> snapshot;
+
     if (effects->isOpenGLCompositing()) {
         QMatrix4x4 projection;
-        projection.ortho(QRect{{}, fbo->size()});
+        if (async) {
+            // Render upside down, such that the rows are read back from top to bottom.
+            projection.ortho(0, fbo->size().width(), 0, fbo->size().height(), -1, 1);
+        } else {
+            projection.ortho(QRect{{}, fbo->size()});
+        }
         render::push_framebuffer(data, fbo.get());
 
         effect::window_paint_data win_data{
@@ -277,28 +524,36 @@ void ScreenShotEffect::takeScreenShot(effect::render_data& data, ScreenShotWindo
 
         effects->drawWindow(win_data);
 
-        // copy content from framebuffer into image
-        img = QImage(offscreenTexture->size(), QImage::Format_ARGB32);
-        img.setDevicePixelRatio(devicePixelRatio);
-        glReadnPixels(0,
-                      0,
-                      img.width(),
-                      img.height(),
-                      GL_RGBA,
-                      GL_UNSIGNED_BYTE,
-                      img.sizeInBytes(),
-                      static_cast<GLvoid*>(img.bits()));
-        render::pop_framebuffer(data);
-        convertFromGLImage(img, img.width(), img.height(), projection);
-        img = img.mirrored();
-    }
-
-    if (screenshot->flags & ScreenShotIncludeCursor) {
-        grabPointerImage(img, geometry.x(), geometry.y());
+        if (async) {
+            auto readback = std::make_unique<ScreenShotReadback>();
+            readback->pixels = std::make_unique<GLPixelReadback>(QRect({}, fbo->size()));
+            readback->devicePixelRatio = devicePixelRatio;
+            render::pop_framebuffer(data);
+
+            readback->texture = std::move(offscreenTexture);
+            readback->fbo = std::move(fbo);
+            snapshot = enqueueReadback(std::move(readback));
+        } else {
+            // copy content from framebuffer into image
+            QImage img(offscreenTexture->size(), QImage::Format_ARGB32);
+            img.setDevicePixelRatio(devicePixelRatio);
+            glReadnPixels(0,
+                          0,
+                          img.width(),
+                          img.height(),
+                          GL_RGBA,
+                          GL_UNSIGNED_BYTE,
+                          img.sizeInBytes(),
+                          static_cast<GLvoid*>(img.bits()));
+            render::pop_framebuffer(data);
+            convertFromGLImage(img, img.width(), img.height(), projection);
+            snapshot = QtFuture::makeReadyValueFuture(img.mirrored());
+        }
+    } else {
+        snapshot = QtFuture::makeReadyValueFuture(QImage());
     }
 
-    screenshot->promise.addResult(img);
-    screenshot->promise.finish();
+    return snapshot;
 }
 
 bool ScreenShotEffect::takeScreenShot(effect::render_data& render_data,
@@ -306,12 +561,9 @@ bool ScreenShotEffect::takeScreenShot(effect::render_data& render_data,
 {
     if (!m_paintedScreen) {
         // On X11, all screens are painted simultaneously and there is no native HiDPI support.
-        auto snapshot = blitScreenshot(render_data, screenshot->area);
-        if (screenshot->flags & ScreenShotIncludeCursor) {
-            grabPointerImage(snapshot, screenshot->area.x(), screenshot->area.y());
-        }
-        screenshot->promise.addResult(snapshot);
-        screenshot->promise.finish();
+        finishScreenShot(readbackScreenshot(render_data, screenshot->area, 1.),
+                         std::move(screenshot->promise),
+                         grabPointer(screenshot->flags, screenshot->area.topLeft()));
         return true;
     }
 
@@ -327,26 +579,45 @@ bool ScreenShotEffect::takeScreenShot(effect::render_data& render_data,
         sourceDevicePixelRatio = m_paintedScreen->devicePixelRatio();
     }
 
-    auto const snapshot = blitScreenshot(render_data, sourceRect, sourceDevicePixelRatio);
-    QRect const nativeArea(screenshot->area.topLeft(),
-                           screenshot->area.size() * screenshot->result.devicePixelRatio());
+    screenshot->snapshots.append(
+        readbackScreenshot(render_data, sourceRect, sourceDevicePixelRatio));
+    screenshot->sourceRects.append(sourceRect);
 
-    QPainter painter(&screenshot->result);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
-    painter.setWindow(nativeArea);
-    painter.drawImage(sourceRect, snapshot);
-    painter.end();
-
-    if (screenshot->screens.isEmpty()) {
-        if (screenshot->flags & ScreenShotIncludeCursor) {
-            grabPointerImage(screenshot->result, screenshot->area.x(), screenshot->area.y());
-        }
-        screenshot->promise.addResult(screenshot->result);
-        screenshot->promise.finish();
-        return true;
+    if (!screenshot->screens.isEmpty()) {
+        return false;
     }
 
-    return false;
+    auto shared_promise = std::make_shared<QPromise<QImage>>(std::move(screenshot->promise));
+
+    // Compose the snapshots in the thread finishing the last one.
+    QtFuture::whenAll(screenshot->snapshots.begin(), screenshot->snapshots.end())
+        .then([shared_promise,
+               result = screenshot->result,
+               area = screenshot->area,
+               sourceRects = screenshot->sourceRects,
+               cursor = grabPointer(screenshot->flags, screenshot->area.topLeft())](
+                  QList<QFuture<QImage>> const& snapshots) mutable {
+            QRect const nativeArea(area.topLeft(), area.size() * result.devicePixelRatio());
+
+            QPainter painter(&result);
+            painter.setRenderHint(QPainter::SmoothPixmapTransform);
+            painter.setWindow(nativeArea);
+
+            for (int i = 0; i < snapshots.size(); ++i) {
+                if (snapshots[i].isCanceled()) {
+                    // Dropping the promise cancels the screenshot.
+                    return;
+                }
+                painter.drawImage(sourceRects[i], snapshots[i].result());
+            }
+            painter.end();
+
+            drawCursor(result, cursor);
+            shared_promise->addResult(result);
+            shared_promise->finish();
+        });
+
+    return true;
 }
 
 bool ScreenShotEffect::takeScreenShot(effect::render_data& render_data,
@@ -361,15 +632,10 @@ bool ScreenShotEffect::takeScreenShot(effect::render_data& render_data,
         devicePixelRatio = screenshot->screen->devicePixelRatio();
     }
 
-    auto snapshot = blitScreenshot(render_data, screenshot->screen->geometry(), devicePixelRatio);
-    if (screenshot->flags & ScreenShotIncludeCursor) {
-        const int xOffset = screenshot->screen->geometry().x();
-        const int yOffset = screenshot->screen->geometry().y();
-        grabPointerImage(snapshot, xOffset, yOffset);
-    }
-
-    screenshot->promise.addResult(snapshot);
-    screenshot->promise.finish();
+    auto const geometry = screenshot->screen->geometry();
+    finishScreenShot(readbackScreenshot(render_data, geometry, devicePixelRatio),
+                     std::move(screenshot->promise),
+                     grabPointer(screenshot->flags, geometry.topLeft()));
 
     return true;
 }
@@ -381,27 +647,117 @@ QImage ScreenShotEffect::blitScreenshot(effect::render_data& render_data,
     return effects->blit_from_framebuffer(render_data, geometry, devicePixelRatio);
 }
 
-void ScreenShotEffect::grabPointerImage(QImage& snapshot, int xOffset, int yOffset) const
+QFuture<QImage> ScreenShotEffect::readbackScreenshot(effect::render_data& render_data,
+                                                     QRect const& geometry,
+                                                     qreal devicePixelRatio)
 {
-    if (effects->isCursorHidden()) {
-        return;
+    if (!effects->isOpenGLCompositing() || !GLPixelReadback::supported()
+        || !GLFramebuffer::blitSupported()) {
+        return QtFuture::makeReadyValueFuture(
+            blitScreenshot(render_data, geometry, devicePixelRatio));
     }
 
-    auto const cursor = effects->cursorImage();
-    if (cursor.image.isNull()) {
+    auto const nativeSize
+        = effect::map_to_viewport(render_data, geometry).size() * devicePixelRatio;
+
+    auto readback = std::make_unique<ScreenShotReadback>();
+    readback->devicePixelRatio = devicePixelRatio;
+    readback->texture = std::make_unique<GLTexture>(GL_RGBA8, nativeSize);
+    readback->fbo = std::make_unique<GLFramebuffer>(readback->texture.get());
+
+    if (!readback->fbo->valid()
+        || !readback->fbo->blit_from_current_render_target(
+            render_data, geometry, QRect({}, geometry.size()))) {
+        return QtFuture::makeReadyValueFuture(
+            blitScreenshot(render_data, geometry, devicePixelRatio));
+    }
+
+    render::push_framebuffer(render_data, readback->fbo.get());
+    readback->pixels = std::make_unique<GLPixelReadback>(QRect({}, nativeSize));
+    render::pop_framebuffer(render_data);
+
+    return enqueueReadback(std::move(readback));
+}
+
+QFuture<QImage> ScreenShotEffect::enqueueReadback(std::unique_ptr<ScreenShotReadback> readback)
+{
+    readback->promise.start();
+    auto future = readback->promise.future();
+
+    m_readbacks.push_back(std::move(readback));
+    if (!m_readbackTimer.isActive()) {
+        m_readbackTimer.start();
+    }
+
+    return future;
+}
+
+void ScreenShotEffect::pollReadbacks()
+{
+    if (!effects->makeOpenGLContextCurrent()) {
         return;
     }
+    processReadbacks();
+}
 
-    QPainter painter(&snapshot);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
-    painter.drawImage(effects->cursorPos() - cursor.hot_spot - QPoint(xOffset, yOffset),
-                      cursor.image);
+void ScreenShotEffect::processReadbacks()
+{
+    for (auto& readback : m_readbacks) {
+        if (readback->copying || !readback->pixels->is_ready()) {
+            continue;
+        }
+
+        auto data = readback->pixels->map();
+        if (!data) {
+            // Dropping the promise cancels the screenshot.
+            readback->copy = QtFuture::makeReadyVoidFuture();
+            readback->copying = true;
+            continue;
+        }
+
+        auto const size = readback->pixels->size();
+        QImage const mapped(
+            data, size.width(), size.height(), readback->pixels->stride(), QImage::Format_ARGB32);
+
+        readback->copy = QtConcurrent::run([raw = readback.get(), mapped] {
+            auto image = mapped.copy();
+            image.setDevicePixelRatio(raw->devicePixelRatio);
+            raw->promise.addResult(std::move(image));
+            raw->promise.finish();
+        });
+        readback->copying = true;
+    }
+
+    std::erase_if(m_readbacks, [](auto const& readback) {
+        if (!readback->copying || !readback->copy.isFinished()) {
+            return false;
+        }
+        readback->pixels->unmap();
+        return true;
+    });
+
+    if (m_readbacks.empty()) {
+        m_readbackTimer.stop();
+    } else {
+        m_readbackTimer.start();
+    }
+}
+
+ScreenShotCursor ScreenShotEffect::grabPointer(ScreenShotFlags flags, QPoint const& offset) const
+{
+    if (!(flags & ScreenShotIncludeCursor) || effects->isCursorHidden()) {
+        return {};
+    }
+
+    auto const cursor = effects->cursorImage();
+    return {cursor.image, effects->cursorPos() - cursor.hot_spot - offset};
 }
 
 bool ScreenShotEffect::isActive() const
 {
     return (!m_windowScreenShots.empty() || !m_areaScreenShots.empty()
-            || !m_screenScreenShots.empty())
+            || !m_screenScreenShots.empty() || !m_captureStreams.empty()
+            || !m_readbacks.empty())
         && !effects->isScreenLocked();
 }
 
@@ -421,12 +777,24 @@ void ScreenShotEffect::handleScreenRemoved(EffectScreen* screen)
 
     std::erase_if(m_screenScreenShots,
                   [screen](const auto& screenshot) { return screenshot.screen == screen; });
+
+    for (auto stream : std::vector(m_captureStreams)) {
+        if (stream->screen() == screen) {
+            removeCaptureStream(stream);
+        }
+    }
 }
 
 void ScreenShotEffect::handleWindowClosed(EffectWindow* window)
 {
     std::erase_if(m_windowScreenShots,
                   [window](const auto& screenshot) { return screenshot.window == window; });
+
+    for (auto stream : std::vector(m_captureStreams)) {
+        if (stream->window() == window) {
+            removeCaptureStream(stream);
+        }
+    }
 }
 
 }
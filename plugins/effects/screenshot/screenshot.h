@@ -14,6 +14,8 @@
 #include <QImage>
 #include <QLoggingCategory>
 #include <QObject>
+#include <QPoint>
+#include <QTimer>
 
 Q_DECLARE_LOGGING_CATEGORY(KWIN_SCREENSHOT)
 
@@ -31,10 +33,19 @@ enum ScreenShotFlag {
 };
 Q_DECLARE_FLAGS(ScreenShotFlags, ScreenShotFlag)
 
+class CaptureStream;
 class ScreenShotDBusInterface2;
+struct file_descriptor;
 struct ScreenShotWindowData;
 struct ScreenShotAreaData;
 struct ScreenShotScreenData;
+struct ScreenShotReadback;
+
+struct ScreenShotCursor {
+    QImage image;
+    // Position of the cursor image relative to the captured source.
+    QPoint position;
+};
 
 /**
  * The ScreenShotEffect provides a convenient way to capture the contents of a given window,
@@ -72,7 +83,31 @@ public:
      */
     QFuture<QImage> scheduleScreenShot(EffectWindow* window, ScreenShotFlags flags = {});
 
+    /**
+     * Starts streaming frames of the given @a screen to @a fileDescriptor. Frames are sent at most
+     * @a maxFrameRate times per second, or on every repaint if it is zero. The stream ends when
+     * the screen is removed, the consumer closes the file descriptor or stopCaptureStream() is
+     * called.
+     */
+    CaptureStream* startCaptureStream(EffectScreen* screen,
+                                      ScreenShotFlags flags,
+                                      int maxFrameRate,
+                                      file_descriptor&& fileDescriptor);
+
+    /**
+     * Starts streaming frames of the given @a window to @a fileDescriptor. The stream ends when
+     * the window is closed, the consumer closes the file descriptor or stopCaptureStream() is
+     * called.
+     */
+    CaptureStream* startCaptureStream(EffectWindow* window,
+                                      ScreenShotFlags flags,
+                                      int maxFrameRate,
+                                      file_descriptor&& fileDescriptor);
+
+    bool stopCaptureStream(uint32_t id);
+
     void paintScreen(effect::screen_paint_data& data) override;
+    void postPaintScreen() override;
     bool isActive() const override;
     int requestedEffectChainPosition() const override;
 
@@ -82,6 +117,7 @@ private Q_SLOTS:
     void handleWindowClosed(EffectWindow* window);
     void handleScreenAdded();
     void handleScreenRemoved(EffectScreen* screen);
+    void handleMouseChanged();
 
 private:
     void takeScreenShot(effect::render_data& data, ScreenShotWindowData* screenshot);
@@ -92,15 +128,44 @@ private:
     void cancelAreaScreenShots();
     void cancelScreenScreenShots();
 
-    void grabPointerImage(QImage& snapshot, int xOffset, int yOffset) const;
+    void addCaptureStream(CaptureStream* stream, QRect const& geometry);
+    void removeCaptureStream(CaptureStream* stream);
+    void captureStreamFrame(effect::screen_paint_data& data, CaptureStream* stream);
+
+    static QRect windowCaptureGeometry(EffectWindow* window, ScreenShotFlags flags);
+    static qreal windowDevicePixelRatio(EffectWindow* window, ScreenShotFlags flags);
+    QFuture<QImage> captureWindow(effect::render_data& data,
+                                  EffectWindow* window,
+                                  QRect const& geometry,
+                                  qreal devicePixelRatio);
+
+    ScreenShotCursor grabPointer(ScreenShotFlags flags, QPoint const& offset) const;
     QImage blitScreenshot(effect::render_data& viewport,
                           const QRect& geometry,
                           qreal devicePixelRatio = 1.0) const;
 
+    /**
+     * Reads back @a geometry of the current render target. If supported the pixels are read back
+     * asynchronously and the returned future is finished on a worker thread. Otherwise the
+     * returned future is already finished.
+     */
+    QFuture<QImage> readbackScreenshot(effect::render_data& render_data,
+                                       QRect const& geometry,
+                                       qreal devicePixelRatio);
+    QFuture<QImage> enqueueReadback(std::unique_ptr<ScreenShotReadback> readback);
+    void pollReadbacks();
+    void processReadbacks();
+
     std::vector<ScreenShotWindowData> m_windowScreenShots;
     std::vector<ScreenShotAreaData> m_areaScreenShots;
     std::vector<ScreenShotScreenData> m_screenScreenShots;
 
+    std::vector<std::unique_ptr<ScreenShotReadback>> m_readbacks;
+    QTimer m_readbackTimer;
+
+    std::vector<CaptureStream*> m_captureStreams;
+    int m_cursorStreamCount{0};
+
     QScopedPointer<ScreenShotDBusInterface2> m_dbusInterface2;
     EffectScreen const* m_paintedScreen{nullptr};
 };
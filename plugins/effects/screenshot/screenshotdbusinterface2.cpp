@@ -6,6 +6,7 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "screenshotdbusinterface2.h"
+#include "capturestream.h"
 
 #include <como/desktop/kde/service_utils.h>
 #include <como/utils/file_descriptor.h>
@@ -131,6 +132,11 @@ static ScreenShotFlags screenShotFlagsFromOptions(const QVariantMap& options)
     return flags;
 }
 
+static int maxFrameRateFromOptions(const QVariantMap& options)
+{
+    return options.value(QStringLiteral("max-frame-rate"), 0u).toUInt();
+}
+
 static const QString s_dbusServiceName = QStringLiteral("org.kde.KWin.ScreenShot2");
 static const QString s_dbusInterface = QStringLiteral("org.kde.KWin.ScreenShot2");
 static const QString s_dbusObjectPath = QStringLiteral("/org/kde/KWin/ScreenShot2");
@@ -153,6 +159,9 @@ static const QString s_errorInvalidScreenMessage = QStringLiteral("Invalid scree
 static const QString s_errorFileDescriptor
     = QStringLiteral("org.kde.KWin.ScreenShot2.Error.FileDescriptor");
 static const QString s_errorFileDescriptorMessage = QStringLiteral("No valid file descriptor");
+static const QString s_errorInvalidStream
+    = QStringLiteral("org.kde.KWin.ScreenShot2.Error.InvalidStream");
+static const QString s_errorInvalidStreamMessage = QStringLiteral("Invalid stream requested");
 
 class ScreenShotSource2 : public QObject
 {
@@ -345,7 +354,7 @@ ScreenShotDBusInterface2::~ScreenShotDBusInterface2()
 
 int ScreenShotDBusInterface2::version() const
 {
-    return 4;
+    return 5;
 }
 
 bool ScreenShotDBusInterface2::checkPermissions() const
@@ -354,6 +363,13 @@ bool ScreenShotDBusInterface2::checkPermissions() const
         return false;
     }
 
+    // For tests, which call the interface from the compositor process.
+    static bool const permissionCheckDisabled
+        = qEnvironmentVariableIntValue("KWIN_SCREENSHOT_NO_PERMISSION_CHECKS") == 1;
+    if (permissionCheckDisabled) {
+        return true;
+    }
+
     const QDBusReply<uint> reply = connection().interface()->servicePid(message().service());
     if (reply.isValid()) {
         const uint pid = reply.value();
@@ -369,6 +385,22 @@ bool ScreenShotDBusInterface2::checkPermissions() const
     return true;
 }
 
+EffectWindow* ScreenShotDBusInterface2::findWindow(QString const& handle) const
+{
+    if (auto window = effects->findWindow(QUuid(handle))) {
+        return window;
+    }
+
+    bool ok;
+    const int winId = handle.toInt(&ok);
+    if (!ok) {
+        qCWarning(KWIN_SCREENSHOT) << "Invalid handle:" << handle;
+        return nullptr;
+    }
+
+    return effects->findWindow(winId);
+}
+
 QVariantMap ScreenShotDBusInterface2::CaptureActiveWindow(const QVariantMap& options,
                                                           QDBusUnixFileDescriptor pipe)
 {
@@ -404,16 +436,7 @@ QVariantMap ScreenShotDBusInterface2::CaptureWindow(const QString& handle,
         return QVariantMap();
     }
 
-    EffectWindow* window = effects->findWindow(QUuid(handle));
-    if (!window) {
-        bool ok;
-        const int winId = handle.toInt(&ok);
-        if (ok) {
-            window = effects->findWindow(winId);
-        } else {
-            qCWarning(KWIN_SCREENSHOT) << "Invalid handle:" << handle;
-        }
-    }
+    auto window = findWindow(handle);
     if (!window) {
         sendErrorReply(s_errorInvalidWindow, s_errorInvalidWindowMessage);
         return QVariantMap();
@@ -597,6 +620,81 @@ QVariantMap ScreenShotDBusInterface2::CaptureWorkspace(const QVariantMap& option
     return QVariantMap();
 }
 
+QVariantMap ScreenShotDBusInterface2::StreamScreen(const QString& name,
+                                                   const QVariantMap& options,
+                                                   QDBusUnixFileDescriptor pipe)
+{
+    if (!checkPermissions()) {
+        return QVariantMap();
+    }
+
+    auto screen = effects->findScreen(name);
+    if (!screen) {
+        sendErrorReply(s_errorInvalidScreen, s_errorInvalidScreenMessage);
+        return QVariantMap();
+    }
+
+    const int fileDescriptor = fcntl(pipe.fileDescriptor(), F_DUPFD_CLOEXEC, 0);
+    if (fileDescriptor == -1) {
+        sendErrorReply(s_errorFileDescriptor, s_errorFileDescriptorMessage);
+        return QVariantMap();
+    }
+
+    return bindStream(m_effect->startCaptureStream(screen,
+                                                   screenShotFlagsFromOptions(options),
+                                                   maxFrameRateFromOptions(options),
+                                                   file_descriptor(fileDescriptor)));
+}
+
+QVariantMap ScreenShotDBusInterface2::StreamWindow(const QString& handle,
+                                                   const QVariantMap& options,
+                                                   QDBusUnixFileDescriptor pipe)
+{
+    if (!checkPermissions()) {
+        return QVariantMap();
+    }
+
+    auto window = findWindow(handle);
+    if (!window) {
+        sendErrorReply(s_errorInvalidWindow, s_errorInvalidWindowMessage);
+        return QVariantMap();
+    }
+
+    const int fileDescriptor = fcntl(pipe.fileDescriptor(), F_DUPFD_CLOEXEC, 0);
+    if (fileDescriptor == -1) {
+        sendErrorReply(s_errorFileDescriptor, s_errorFileDescriptorMessage);
+        return QVariantMap();
+    }
+
+    return bindStream(m_effect->startCaptureStream(window,
+                                                   screenShotFlagsFromOptions(options),
+                                                   maxFrameRateFromOptions(options),
+                                                   file_descriptor(fileDescriptor)));
+}
+
+void ScreenShotDBusInterface2::StopStream(uint stream)
+{
+    if (!checkPermissions()) {
+        return;
+    }
+
+    if (m_streamOwners.value(stream) != message().service()
+        || !m_effect->stopCaptureStream(stream)) {
+        sendErrorReply(s_errorInvalidStream, s_errorInvalidStreamMessage);
+    }
+}
+
+QVariantMap ScreenShotDBusInterface2::bindStream(CaptureStream* stream)
+{
+    auto const id = stream->id();
+    m_streamOwners.insert(id, message().service());
+    connect(stream, &QObject::destroyed, this, [this, id] { m_streamOwners.remove(id); });
+
+    return QVariantMap{
+        {QStringLiteral("stream"), id},
+    };
+}
+
 void ScreenShotDBusInterface2::bind(ScreenShotSinkPipe2* sink, ScreenShotSource2* source)
 {
     connect(source, &ScreenShotSource2::cancelled, sink, [sink, source]() {
@@ -11,12 +11,14 @@
 
 #include <QDBusContext>
 #include <QDBusUnixFileDescriptor>
+#include <QHash>
 #include <QObject>
 #include <QVariantMap>
 
 namespace como
 {
 
+class CaptureStream;
 class ScreenShotEffect;
 class ScreenShotSinkPipe2;
 class ScreenShotSource2;
@@ -56,6 +58,12 @@ public Q_SLOTS:
     CaptureInteractive(uint kind, const QVariantMap& options, QDBusUnixFileDescriptor pipe);
     QVariantMap CaptureWorkspace(const QVariantMap& options, QDBusUnixFileDescriptor pipe);
 
+    QVariantMap
+    StreamScreen(const QString& name, const QVariantMap& options, QDBusUnixFileDescriptor pipe);
+    QVariantMap
+    StreamWindow(const QString& handle, const QVariantMap& options, QDBusUnixFileDescriptor pipe);
+    void StopStream(uint stream);
+
 private:
     void takeScreenShot(EffectScreen* screen, ScreenShotFlags flags, ScreenShotSinkPipe2* sink);
     void takeScreenShot(const QRect& area, ScreenShotFlags flags, ScreenShotSinkPipe2* sink);
@@ -63,8 +71,13 @@ private:
 
     void bind(ScreenShotSinkPipe2* sink, ScreenShotSource2* source);
     bool checkPermissions() const;
+    EffectWindow* findWindow(QString const& handle) const;
+    QVariantMap bindStream(CaptureStream* stream);
 
     ScreenShotEffect* m_effect;
+
+    // Services that started the capture streams by stream id.
+    QHash<uint, QString> m_streamOwners;
 };
 
 }
@@ -132,7 +132,7 @@ void SheetEffect::slotWindowAdded(EffectWindow* w)
         animation.parentY = (*parentIt)->y();
     }
 
-    w->setData(WindowAddedGrabRole, QVariant::fromValue(static_cast<void*>(this)));
+    w->setData(effect::window_data::added_grab, this);
 
     w->addRepaintFull();
 }
@@ -165,7 +165,7 @@ void SheetEffect::slotWindowClosed(EffectWindow* w)
         animation.parentY = (*parentIt)->y();
     }
 
-    w->setData(WindowClosedGrabRole, QVariant::fromValue(static_cast<void*>(this)));
+    w->setData(effect::window_data::closed_grab, this);
 
     w->addRepaintFull();
 }
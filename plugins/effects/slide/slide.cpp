@@ -317,8 +317,8 @@ void SlideEffect::prepareSwitching()
             effects->setElevatedWindow(w, true);
             m_elevatedWindows << w;
         }
-        w->setData(WindowForceBackgroundContrastRole, QVariant(true));
-        w->setData(WindowForceBlurRole, QVariant(true));
+        w->setData(effect::window_data::force_background_contrast, true);
+        w->setData(effect::window_data::force_blur, true);
     }
 }
 
@@ -329,8 +329,8 @@ void SlideEffect::finishedSwitching()
     }
     auto const windows = effects->stackingOrder();
     for (EffectWindow* w : windows) {
-        w->setData(WindowForceBackgroundContrastRole, QVariant());
-        w->setData(WindowForceBlurRole, QVariant());
+        w->resetData(effect::window_data::force_background_contrast);
+        w->resetData(effect::window_data::force_blur);
     }
 
     for (EffectWindow* w : std::as_const(m_elevatedWindows)) {
@@ -419,8 +419,8 @@ void SlideEffect::windowAdded(EffectWindow* w)
         effects->setElevatedWindow(w, true);
         m_elevatedWindows << w;
     }
-    w->setData(WindowForceBackgroundContrastRole, QVariant(true));
-    w->setData(WindowForceBlurRole, QVariant(true));
+    w->setData(effect::window_data::force_background_contrast, true);
+    w->setData(effect::window_data::force_blur, true);
 
     window_refs[w] = EffectWindowVisibleRef(w, EffectWindow::PAINT_DISABLED_BY_DESKTOP);
 }
@@ -148,7 +148,7 @@ void SlideBackEffect::prePaintScreen(effect::screen_prepaint_data& data)
 
     auto const stack = effects->stackingOrder();
     for (auto const& w : stack) {
-        w->setData(WindowForceBlurRole, QVariant(true));
+        w->setData(effect::window_data::force_blur, true);
     }
 
     effects->prePaintScreen(data);
@@ -161,7 +161,7 @@ void SlideBackEffect::postPaintScreen()
     }
 
     for (auto& w : effects->stackingOrder()) {
-        w->setData(WindowForceBlurRole, QVariant());
+        w->resetData(effect::window_data::force_blur);
     }
 
     effects->postPaintScreen();
@@ -77,8 +77,9 @@ void update_function(SlidingPopupsEffect& effect, como::effect::anim_update cons
 
     if (!update.base.valid) {
         // Property was removed, thus also remove the effect for window.
-        if (window->data(WindowClosedGrabRole).value<void*>() == &effect) {
-            window->setData(WindowClosedGrabRole, QVariant());
+        auto grab = window->data(como::effect::window_data::closed_grab);
+        if (grab && *grab == &effect) {
+            window->resetData(como::effect::window_data::closed_grab);
         }
         effect.animations.remove(window);
         effect.window_data.remove(window);
@@ -91,8 +92,7 @@ void update_function(SlidingPopupsEffect& effect, como::effect::anim_update cons
     sanitize_anim_data(data, effect.config.in, effect.config.out);
 
     // Grab the window, so other windowClosed effects will ignore it
-    data.base.window->setData(WindowClosedGrabRole,
-                              QVariant::fromValue(static_cast<void*>(&effect)));
+    data.base.window->setData(como::effect::window_data::closed_grab, &effect);
 
     if (window_added) {
         effect.slide_in(window);
@@ -241,8 +241,8 @@ void SlidingPopupsEffect::postPaintWindow(EffectWindow* win)
     if (animationIt != animations.end()) {
         if ((*animationIt).timeline.done()) {
             if (!win->isDeleted()) {
-                win->setData(WindowForceBackgroundContrastRole, QVariant());
-                win->setData(WindowForceBlurRole, QVariant());
+                win->resetData(effect::window_data::force_background_contrast);
+                win->resetData(effect::window_data::force_blur);
             }
             animations.erase(animationIt);
         }
@@ -292,9 +292,9 @@ void SlidingPopupsEffect::slide_in(EffectWindow* win)
         animation.timeline.reset();
     }
 
-    win->setData(WindowAddedGrabRole, QVariant::fromValue(static_cast<void*>(this)));
-    win->setData(WindowForceBackgroundContrastRole, QVariant(true));
-    win->setData(WindowForceBlurRole, QVariant(true));
+    win->setData(effect::window_data::added_grab, this);
+    win->setData(effect::window_data::force_background_contrast, true);
+    win->setData(effect::window_data::force_blur, true);
 
     win->addRepaintFull();
 }
@@ -334,9 +334,9 @@ void SlidingPopupsEffect::slide_out(EffectWindow* win)
         animation.timeline.reset();
     }
 
-    win->setData(WindowClosedGrabRole, QVariant::fromValue(static_cast<void*>(this)));
-    win->setData(WindowForceBackgroundContrastRole, QVariant(true));
-    win->setData(WindowForceBlurRole, QVariant(true));
+    win->setData(effect::window_data::closed_grab, this);
+    win->setData(effect::window_data::force_background_contrast, true);
+    win->setData(effect::window_data::force_blur, true);
 
     win->addRepaintFull();
 }
@@ -347,8 +347,8 @@ void SlidingPopupsEffect::stopAnimations()
         auto win = it.key();
 
         if (!win->isDeleted()) {
-            win->setData(WindowForceBackgroundContrastRole, QVariant());
-            win->setData(WindowForceBlurRole, QVariant());
+            win->resetData(effect::window_data::force_background_contrast);
+            win->resetData(effect::window_data::force_blur);
         }
     }
 
@@ -266,5 +266,22 @@ Item {
         id: stackModel
     }
 
-    Component.onCompleted: start();
+    // With persistent views the scene is created before and kept after the effect runs.
+    Connections {
+        target: effect
+        function onRunningChanged() {
+            if (effect.running) {
+                container.start();
+            } else {
+                container.animationEnabled = false;
+                container.stop();
+            }
+        }
+    }
+
+    Component.onCompleted: {
+        if (effect.running) {
+            start();
+        }
+    }
 }
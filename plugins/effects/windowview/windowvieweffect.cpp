@@ -152,6 +152,12 @@ void WindowViewEffect::reconfigure(ReconfigureFlags)
     WindowViewConfig::self()->read();
     setAnimationDuration(animationTime(300));
 
+    // Keeps the scene alive between activations so it can be shown in the next frame.
+    setPersistentViews(WindowViewConfig::persistentViews());
+    if (persistentViews()) {
+        warmUp();
+    }
+
     for (ElectricBorder border : std::as_const(m_borderActivate)) {
         effects->unreserveElectricBorder(border, this);
     }
@@ -0,0 +1,394 @@
+/*
+    SPDX-FileCopyrightText: 2008 Cédric Borgese <cedric.borgese@gmail.com>
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QRectF>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace como::wobbly
+{
+
+struct parameters {
+    double stiffness;
+    double drag;
+    double move_factor;
+
+    double min_velocity;
+    double max_velocity;
+    double min_acceleration;
+    double max_acceleration;
+};
+
+struct step_result {
+    double acceleration_sum{0.};
+    double velocity_sum{0.};
+};
+
+/**
+ * Spring mesh of the wobbly model.
+ *
+ * The state is kept in a structure-of-arrays layout with one contiguous array per component. All
+ * per-point passes are branch-free loops over these arrays, so the compiler can vectorize them.
+ * Neighbor relations are precomputed once per grid and don't need to be evaluated per step.
+ */
+class grid
+{
+public:
+    grid() = default;
+
+    grid(size_t width, size_t height)
+        : width{width}
+        , height{height}
+        , count{width * height}
+    {
+        assert(width >= 2 && height >= 2);
+
+        for (auto vec : {&origin_x,
+                         &origin_y,
+                         &position_x,
+                         &position_y,
+                         &velocity_x,
+                         &velocity_y,
+                         &acceleration_x,
+                         &acceleration_y,
+                         &scratch_a,
+                         &scratch_b,
+                         &spring_weight,
+                         &rest_x,
+                         &rest_y,
+                         &ring_weight}) {
+            vec->assign(count, 0.);
+        }
+        constraint.assign(count, 0);
+
+        for (size_t j = 0; j < height; ++j) {
+            for (size_t i = 0; i < width; ++i) {
+                auto const index = j * width + i;
+                auto const has_left = i > 0;
+                auto const has_right = i < width - 1;
+                auto const has_top = j > 0;
+                auto const has_bottom = j < height - 1;
+
+                auto const springs = has_left + has_right + has_top + has_bottom;
+                spring_weight[index] = 1. / springs;
+
+                // A spring to the left pushes to the right by its rest length and vice versa.
+                rest_x[index] = static_cast<int>(has_left) - static_cast<int>(has_right);
+                rest_y[index] = static_cast<int>(has_top) - static_cast<int>(has_bottom);
+
+                auto const ring
+                    = (1 + has_left + has_right) * (1 + has_top + has_bottom) - 1;
+                ring_weight[index] = 0.5 / ring;
+            }
+        }
+    }
+
+    /**
+     * Sets the rest positions of the points to a regular grid over @p geometry.
+     */
+    void set_origin(QRectF const& geometry)
+    {
+        x_length = geometry.width() / (width - 1.);
+        y_length = geometry.height() / (height - 1.);
+
+        for (size_t j = 0; j < height; ++j) {
+            auto const y = j == height - 1 ? geometry.y() + geometry.height()
+                                           : geometry.y() + j * y_length;
+            auto row_x = &origin_x[j * width];
+            auto row_y = &origin_y[j * width];
+
+            for (size_t i = 0; i < width - 1; ++i) {
+                row_x[i] = geometry.x() + i * x_length;
+                row_y[i] = y;
+            }
+            row_x[width - 1] = geometry.x() + geometry.width();
+            row_y[width - 1] = y;
+        }
+    }
+
+    /**
+     * Places all points at rest on a regular grid over @p geometry.
+     */
+    void reset(QRectF const& geometry)
+    {
+        set_origin(geometry);
+        position_x = origin_x;
+        position_y = origin_y;
+        std::fill(velocity_x.begin(), velocity_x.end(), 0.);
+        std::fill(velocity_y.begin(), velocity_y.end(), 0.);
+        std::fill(constraint.begin(), constraint.end(), 0);
+    }
+
+    /**
+     * Integrates the mesh by @p time milliseconds. Call set_origin() before to update the rest
+     * positions to the current window geometry.
+     */
+    step_result step(parameters const& params, double time)
+    {
+        step_result res;
+
+        compute_acceleration(params.stiffness);
+
+        ring_mean(acceleration_x);
+        ring_mean(acceleration_y);
+
+        for (size_t i = 0; i < count; ++i) {
+            auto const acc_x
+                = bound(acceleration_x[i], params.min_acceleration, params.max_acceleration);
+            auto const acc_y
+                = bound(acceleration_y[i], params.min_acceleration, params.max_acceleration);
+
+            velocity_x[i] = acc_x * time + velocity_x[i] * params.drag;
+            velocity_y[i] = acc_y * time + velocity_y[i] * params.drag;
+
+            res.acceleration_sum += std::fabs(acc_x) + std::fabs(acc_y);
+        }
+
+        ring_mean(velocity_x);
+        ring_mean(velocity_y);
+
+        auto const move = time * params.move_factor;
+
+        for (size_t i = 0; i < count; ++i) {
+            auto const vel_x = bound(velocity_x[i], params.min_velocity, params.max_velocity);
+            auto const vel_y = bound(velocity_y[i], params.min_velocity, params.max_velocity);
+
+            velocity_x[i] = vel_x;
+            velocity_y[i] = vel_y;
+            position_x[i] += vel_x * move;
+            position_y[i] += vel_y * move;
+
+            res.velocity_sum += std::fabs(vel_x) + std::fabs(vel_y);
+        }
+
+        pin_edges();
+        return res;
+    }
+
+    /**
+     * Maps normalized coordinates (@p u, @p v) onto the Bézier surface spanned by the points and
+     * writes the results to @p x and @p y. The grid must have 4x4 points.
+     */
+    void map_bezier(std::span<double const> u,
+                    std::span<double const> v,
+                    std::span<double> x,
+                    std::span<double> y) const
+    {
+        assert(width == 4 && height == 4);
+        assert(u.size() == v.size() && x.size() >= u.size() && y.size() >= u.size());
+
+        auto const size = u.size();
+
+        for (size_t k = 0; k < size; ++k) {
+            double pu[4];
+            double pv[4];
+            bernstein(u[k], pu);
+            bernstein(v[k], pv);
+
+            double res_x{0.};
+            double res_y{0.};
+
+#pragma GCC unroll 4
+            for (size_t j = 0; j < 4; ++j) {
+                double row_x{0.};
+                double row_y{0.};
+#pragma GCC unroll 4
+                for (size_t i = 0; i < 4; ++i) {
+                    row_x += pu[i] * position_x[j * 4 + i];
+                    row_y += pu[i] * position_y[j * 4 + i];
+                }
+                res_x += pv[j] * row_x;
+                res_y += pv[j] * row_y;
+            }
+
+            x[k] = res_x;
+            y[k] = res_y;
+        }
+    }
+
+    size_t width{0};
+    size_t height{0};
+    size_t count{0};
+
+    std::vector<double> origin_x;
+    std::vector<double> origin_y;
+    std::vector<double> position_x;
+    std::vector<double> position_y;
+    std::vector<double> velocity_x;
+    std::vector<double> velocity_y;
+    std::vector<double> acceleration_x;
+    std::vector<double> acceleration_y;
+
+    // If set the point is only pulled towards its origin, ignoring the neighbor points.
+    std::vector<uint8_t> constraint;
+
+    // Edges that are not allowed to wobble stay at their origin.
+    struct {
+        bool top{true};
+        bool left{true};
+        bool right{true};
+        bool bottom{true};
+    } can_wobble;
+
+private:
+    static void bernstein(double t, double* res)
+    {
+        auto const s = 1. - t;
+        res[0] = s * s * s;
+        res[1] = 3. * s * s * t;
+        res[2] = 3. * s * t * t;
+        res[3] = t * t * t;
+    }
+
+    static double bound(double val, double min, double max)
+    {
+        auto const abs = std::fabs(val);
+        auto const clamped = abs > max ? std::copysign(max, val) : val;
+        return abs < min ? 0. : clamped;
+    }
+
+    // Sums up the values of the direct neighbors (left, right, top, bottom) of each point.
+    void neighbor_sum(std::vector<double> const& data, std::vector<double>& sum) const
+    {
+        for (size_t j = 0; j < height; ++j) {
+            auto const row = j * width;
+            auto out = &sum[row];
+            auto in = &data[row];
+
+            out[0] = in[1];
+            for (size_t i = 1; i < width - 1; ++i) {
+                out[i] = in[i - 1] + in[i + 1];
+            }
+            out[width - 1] = in[width - 2];
+
+            if (j > 0) {
+                auto top = &data[row - width];
+                for (size_t i = 0; i < width; ++i) {
+                    out[i] += top[i];
+                }
+            }
+            if (j < height - 1) {
+                auto bottom = &data[row + width];
+                for (size_t i = 0; i < width; ++i) {
+                    out[i] += bottom[i];
+                }
+            }
+        }
+    }
+
+    void compute_acceleration(double stiffness)
+    {
+        neighbor_sum(position_x, scratch_a);
+        neighbor_sum(position_y, scratch_b);
+
+        for (size_t i = 0; i < count; ++i) {
+            // Mean of the spring forces to all neighbors. The rest lengths cancel out for opposing
+            // neighbors so only the remainder is added.
+            auto const spring_x
+                = (scratch_a[i] + rest_x[i] * x_length) * spring_weight[i] - position_x[i];
+            auto const spring_y
+                = (scratch_b[i] + rest_y[i] * y_length) * spring_weight[i] - position_y[i];
+
+            auto const pull_x = origin_x[i] - position_x[i];
+            auto const pull_y = origin_y[i] - position_y[i];
+
+            acceleration_x[i] = (constraint[i] ? pull_x : spring_x) * stiffness;
+            acceleration_y[i] = (constraint[i] ? pull_y : spring_y) * stiffness;
+        }
+    }
+
+    // Averages each value with the mean of its up to eight surrounding values.
+    void ring_mean(std::vector<double>& data)
+    {
+        // Horizontal box sums of three.
+        for (size_t j = 0; j < height; ++j) {
+            auto const row = j * width;
+            auto out = &scratch_a[row];
+            auto in = &data[row];
+
+            out[0] = in[0] + in[1];
+            for (size_t i = 1; i < width - 1; ++i) {
+                out[i] = in[i - 1] + in[i] + in[i + 1];
+            }
+            out[width - 1] = in[width - 2] + in[width - 1];
+        }
+
+        // Vertical box sums of the horizontal ones.
+        for (size_t j = 0; j < height; ++j) {
+            auto const row = j * width;
+            auto out = &scratch_b[row];
+            auto center = &scratch_a[row];
+
+            for (size_t i = 0; i < width; ++i) {
+                out[i] = center[i];
+            }
+            if (j > 0) {
+                auto top = &scratch_a[row - width];
+                for (size_t i = 0; i < width; ++i) {
+                    out[i] += top[i];
+                }
+            }
+            if (j < height - 1) {
+                auto bottom = &scratch_a[row + width];
+                for (size_t i = 0; i < width; ++i) {
+                    out[i] += bottom[i];
+                }
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = 0.5 * data[i] + (scratch_b[i] - data[i]) * ring_weight[i];
+        }
+    }
+
+    void pin_edges()
+    {
+        if (!can_wobble.top) {
+            for (size_t i = 0; i < (height - 1) * width; ++i) {
+                position_y[i] = origin_y[i];
+            }
+        }
+        if (!can_wobble.bottom) {
+            for (size_t i = width; i < count; ++i) {
+                position_y[i] = origin_y[i];
+            }
+        }
+        if (!can_wobble.left) {
+            for (size_t j = 0; j < height; ++j) {
+                for (size_t i = 0; i < width - 1; ++i) {
+                    position_x[j * width + i] = origin_x[j * width + i];
+                }
+            }
+        }
+        if (!can_wobble.right) {
+            for (size_t j = 0; j < height; ++j) {
+                for (size_t i = 1; i < width; ++i) {
+                    position_x[j * width + i] = origin_x[j * width + i];
+                }
+            }
+        }
+    }
+
+    double x_length{0.};
+    double y_length{0.};
+
+    std::vector<double> scratch_a;
+    std::vector<double> scratch_b;
+
+    // Precomputed per point: inverse number of springs, rest length direction and ring weight.
+    std::vector<double> spring_weight;
+    std::vector<double> rest_x;
+    std::vector<double> rest_y;
+    std::vector<double> ring_weight;
+};
+
+}
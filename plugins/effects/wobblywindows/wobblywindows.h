@@ -6,8 +6,12 @@
 #ifndef KWIN_WOBBLYWINDOWS_H
 #define KWIN_WOBBLYWINDOWS_H
 
+#include "wobbly_grid.h"
+
 #include <como/render/effect/interface/offscreen_effect.h>
 
+#include <vector>
+
 namespace como
 {
 
@@ -56,11 +60,6 @@ public:
     void setVelocityThreshold(qreal velocityThreshold);
     void setMoveFactor(qreal factor);
 
-    struct Pair {
-        qreal x;
-        qreal y;
-    };
-
     enum WindowStatus {
         Free,
         Moving,
@@ -99,33 +98,10 @@ private:
     bool updateWindowWobblyDatas(EffectWindow* w, qreal time);
 
     struct WindowWobblyInfos {
-        QVector<Pair> origin;
-        QVector<Pair> position;
-        QVector<Pair> velocity;
-        QVector<Pair> acceleration;
-        QVector<Pair> buffer;
-
-        // if true, the physics system moves this point based only on it "normal" destination
-        // given by the window position, ignoring neighbour points.
-        QVector<bool> constraint;
-
-        unsigned int width = 0;
-        unsigned int height = 0;
-        unsigned int count = 0;
-
-        QVector<Pair> bezierSurface;
-        unsigned int bezierWidth = 0;
-        unsigned int bezierHeight = 0;
-        unsigned int bezierCount = 0;
-
+        wobbly::grid grid;
         WindowStatus status = Free;
 
         // for resizing. Only sides that have moved will wobble
-        bool can_wobble_top = false;
-        bool can_wobble_left = false;
-        bool can_wobble_right = false;
-        bool can_wobble_bottom = false;
-
         QRect resize_original_rect;
 
         std::chrono::milliseconds clock;
@@ -135,6 +111,12 @@ private:
 
     QRegion m_updateRegion;
 
+    // Scratch buffers for evaluating the Bézier surface in apply().
+    std::vector<double> bezier_u;
+    std::vector<double> bezier_v;
+    std::vector<double> bezier_x;
+    std::vector<double> bezier_y;
+
     qreal m_stiffness;
     qreal m_drag;
     qreal m_move_factor;
@@ -157,10 +139,6 @@ private:
 
     void initWobblyInfo(WindowWobblyInfos& wwi, QRect geometry) const;
 
-    WobblyWindowsEffect::Pair computeBezierPoint(const WindowWobblyInfos& wwi, Pair point) const;
-
-    static void heightRingLinearMean(QVector<Pair>& data, WindowWobblyInfos& wwi);
-
     void setParameterSet(const ParameterSet& pset);
 };
 
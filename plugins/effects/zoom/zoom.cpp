@@ -18,6 +18,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include <como/render/effect/interface/effects_handler.h>
 #include <como/render/effect/interface/paint_data.h>
 #include <como/render/gl/interface/framebuffer.h>
+#include <como/render/gl/interface/render_target_pool.h>
 #include <como/render/gl/interface/shader.h>
 #include <como/render/gl/interface/shader_manager.h>
 #include <como/render/gl/interface/texture.h>
@@ -278,11 +279,10 @@ ZoomEffect::OffscreenData* ZoomEffect::ensureOffscreenData(QRect const& viewport
     auto const nativeSize = rect.size();
 
     auto& data = m_offscreenData[effects->waylandDisplay() ? screen : nullptr];
-    if (!data.texture || data.texture->size() != nativeSize) {
-        data.texture.reset(new GLTexture(GL_RGBA8, nativeSize));
-        data.texture->setFilter(GL_LINEAR);
-        data.texture->setWrapMode(GL_CLAMP_TO_EDGE);
-        data.framebuffer = std::make_unique<GLFramebuffer>(data.texture.get());
+    if (!data.target || data.target->size() != nativeSize) {
+        data.target.reset();
+        data.target = GLRenderTargetPool::instance()->acquire(
+            nativeSize, GL_RGBA8, GLRenderTargetPool::Fit::Exact);
     }
 
     if (!data.vbo || data.viewport != rect) {
@@ -326,9 +326,13 @@ ZoomEffect::OffscreenData* ZoomEffect::ensureOffscreenData(QRect const& viewport
 void ZoomEffect::paintScreen(effect::screen_paint_data& data)
 {
     auto offscreenData = ensureOffscreenData(data.render.viewport, data.screen);
+    if (!offscreenData->target) {
+        effects->paintScreen(data);
+        return;
+    }
 
     QMatrix4x4 projection;
-    projection.ortho(QRect{{}, offscreenData->framebuffer->size()});
+    projection.ortho(QRect{{}, offscreenData->target->size()});
 
     // Render the scene in an offscreen texture and then upscale it.
     effect::screen_paint_data offscreen_data{
@@ -336,7 +340,7 @@ void ZoomEffect::paintScreen(effect::screen_paint_data& data)
         .render = {.targets = data.render.targets, .projection = projection},
     };
 
-    render::push_framebuffer(data.render, offscreenData->framebuffer.get());
+    render::push_framebuffer(data.render, offscreenData->target->framebuffer());
     effects->paintScreen(offscreen_data);
     render::pop_framebuffer(data.render);
 
@@ -435,9 +439,12 @@ void ZoomEffect::paintScreen(effect::screen_paint_data& data)
     auto shader = ShaderManager::instance()->pushShader(ShaderTrait::MapTexture);
     shader->setUniform(GLShader::ModelViewProjectionMatrix, effect::get_mvp(data) * matrix);
     for (auto& [screen, off_data] : m_offscreenData) {
-        off_data.texture->bind();
+        if (!off_data.target) {
+            continue;
+        }
+        off_data.target->texture()->bind();
         off_data.vbo->render(GL_TRIANGLES);
-        off_data.texture->unbind();
+        off_data.target->texture()->unbind();
     }
     ShaderManager::instance()->popShader();
 
@@ -22,7 +22,7 @@ class ZoomAccessibilityIntegration;
 #endif
 
 class EffectScreen;
-class GLFramebuffer;
+class GLRenderTarget;
 class GLTexture;
 class GLVertexBuffer;
 
@@ -91,8 +91,7 @@ private:
 
 private:
     struct OffscreenData {
-        std::unique_ptr<GLTexture> texture;
-        std::unique_ptr<GLFramebuffer> framebuffer;
+        std::unique_ptr<GLRenderTarget> target;
         std::unique_ptr<GLVertexBuffer> vbo;
         QRect viewport;
     };
@@ -0,0 +1,228 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "generic_scene_opengl.h"
+#include "lib/setup.h"
+
+#include "plugins/effects/screenshot/capturestreamframe.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingReply>
+#include <QDBusUnixFileDescriptor>
+#include <QPainter>
+#include <Wrapland/Client/shm_pool.h>
+#include <Wrapland/Client/surface.h>
+#include <Wrapland/Client/xdg_shell.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+/**
+ * Reads frames of a capture stream from a pipe. The compositor gets the write end.
+ */
+struct capture_stream_consumer {
+    capture_stream_consumer()
+    {
+        int fds[2];
+        REQUIRE(pipe2(fds, O_CLOEXEC) == 0);
+        read_fd = fds[0];
+        write_fd = fds[1];
+    }
+    ~capture_stream_consumer()
+    {
+        close_read();
+        close_write();
+    }
+
+    void close_read()
+    {
+        if (read_fd >= 0) {
+            close(read_fd);
+            read_fd = -1;
+        }
+    }
+
+    void close_write()
+    {
+        if (write_fd >= 0) {
+            close(write_fd);
+            write_fd = -1;
+        }
+    }
+
+    bool readable() const
+    {
+        pollfd pfd{read_fd, POLLIN, 0};
+        return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+    }
+
+    int read_fd;
+    int write_fd;
+};
+
+/**
+ * Counts painted frames.
+ */
+class capture_stream_paint_counter : public Effect
+{
+public:
+    void paintScreen(effect::screen_paint_data& data) override
+    {
+        effects->paintScreen(data);
+        painted++;
+    }
+
+    int painted{0};
+};
+
+QDBusPendingCall stream_window(QString const& handle, int fd)
+{
+    auto msg = QDBusMessage::createMethodCall(QStringLiteral("org.kde.KWin.ScreenShot2"),
+                                              QStringLiteral("/org/kde/KWin/ScreenShot2"),
+                                              QStringLiteral("org.kde.KWin.ScreenShot2"),
+                                              QStringLiteral("StreamWindow"));
+    msg.setArguments({handle,
+                      QVariantMap{{QStringLiteral("include-shadow"), false}},
+                      QVariant::fromValue(QDBusUnixFileDescriptor(fd))});
+    return QDBusConnection::sessionBus().asyncCall(msg);
+}
+
+QRect to_rect(capture::frame_rect const& rect)
+{
+    return {rect.x, rect.y, rect.width, rect.height};
+}
+
+}
+
+TEST_CASE("capture stream", "[effect]")
+{
+    qputenv("KWIN_SCREENSHOT_NO_PERMISSION_CHECKS", QByteArrayLiteral("1"));
+    qputenv("XDG_DATA_DIRS", QCoreApplication::applicationDirPath().toUtf8());
+    qRegisterMetaType<como::Effect*>();
+
+    auto setup = generic_scene_opengl_get_setup("capture-stream", "O2");
+    setup->set_outputs(1);
+    setup_wayland_connection();
+
+    auto& e = setup->base->mod.render->effects;
+    QSignalSpy effect_loaded_spy(e->loader.get(), &render::basic_effect_loader::effectLoaded);
+    QVERIFY(effect_loaded_spy.isValid());
+    QVERIFY(e->loadEffect(QStringLiteral("screenshot")));
+    QCOMPARE(effect_loaded_spy.count(), 1);
+
+    auto screenshot_effect = effect_loaded_spy.first().first().value<Effect*>();
+    QVERIFY(screenshot_effect);
+
+    // Owned by the effects handler.
+    auto counter = new capture_stream_paint_counter;
+    Q_EMIT e->loader->effectLoaded(counter, QStringLiteral("capture_stream_paint_counter"));
+
+    auto surface = create_surface();
+    auto toplevel = create_xdg_shell_toplevel(surface);
+    QVERIFY(toplevel);
+
+    auto window = render_and_wait_for_shown(surface, QSize(100, 50), Qt::red);
+    QVERIFY(window);
+
+    // Away from the cursor in the center of the output.
+    win::move(window, QPoint(0, 0));
+
+    capture_stream_consumer consumer;
+
+    QDBusPendingReply<QVariantMap> reply{
+        stream_window(window->meta.internal_id.toString(), consumer.write_fd)};
+    reply.waitForFinished();
+    QVERIFY(reply.isValid());
+    QVERIFY(!reply.isError());
+    QVERIFY(reply.value().contains(QStringLiteral("stream")));
+    QVERIFY(screenshot_effect->isActive());
+
+    // The compositor holds its own copy of the write end.
+    consumer.close_write();
+
+    // The first frame contains the whole window.
+    TRY_REQUIRE(consumer.readable());
+    auto frame = capture::read_frame(consumer.read_fd);
+    QVERIFY(frame);
+    QCOMPARE(frame->header.sequence, 0u);
+    QCOMPARE(frame->header.width, 100);
+    QCOMPARE(frame->header.height, 50);
+    QCOMPARE(frame->rects.size(), 1);
+    QCOMPARE(to_rect(frame->rects.front()), QRect(0, 0, 100, 50));
+
+    QImage image;
+    capture::apply_frame(image, *frame);
+    QCOMPARE(image.pixelColor(50, 25), QColor(Qt::red));
+
+    SECTION("no frame without damage")
+    {
+        // Frames are painted, but none of them damages the window.
+        auto const painted = counter->painted;
+        e->addRepaint(QRect(500, 500, 10, 10));
+        TRY_REQUIRE(counter->painted > painted);
+
+        QTest::qWait(100);
+        QVERIFY(!consumer.readable());
+    }
+
+    SECTION("damaged rect")
+    {
+        auto const damage = QRect(10, 10, 20, 20);
+
+        QImage buffer(QSize(100, 50), QImage::Format_ARGB32_Premultiplied);
+        buffer.fill(Qt::red);
+        QPainter(&buffer).fillRect(damage, Qt::green);
+        surface->attachBuffer(get_client().interfaces.shm->createBuffer(buffer));
+        surface->damage(damage);
+        surface->commit(Wrapland::Client::Surface::CommitFlag::None);
+        flush_wayland_connection();
+
+        TRY_REQUIRE(consumer.readable());
+        frame = capture::read_frame(consumer.read_fd);
+        QVERIFY(frame);
+        QCOMPARE(frame->header.sequence, 1u);
+        QCOMPARE(frame->header.width, 100);
+        QCOMPARE(frame->header.height, 50);
+
+        // Only the damaged pixels are sent.
+        QCOMPARE(frame->rects.size(), 1);
+        QCOMPARE(to_rect(frame->rects.front()), damage);
+        QCOMPARE(frame->pixels.size(), 20 * 20 * 4);
+
+        capture::apply_frame(image, *frame);
+        QCOMPARE(image.pixelColor(20, 20), QColor(Qt::green));
+        QCOMPARE(image.pixelColor(50, 25), QColor(Qt::red));
+    }
+
+    SECTION("reader closes")
+    {
+        consumer.close_read();
+
+        // The stream notices the closed pipe with its next frame and ends.
+        QImage buffer(QSize(100, 50), QImage::Format_ARGB32_Premultiplied);
+        buffer.fill(Qt::blue);
+        surface->attachBuffer(get_client().interfaces.shm->createBuffer(buffer));
+        surface->damage(QRect(0, 0, 100, 50));
+        surface->commit(Wrapland::Client::Surface::CommitFlag::None);
+        flush_wayland_connection();
+
+        TRY_REQUIRE(!screenshot_effect->isActive());
+
+        // Frames are painted without the stream again.
+        auto const painted = counter->painted;
+        render::full_repaint(*setup->base->mod.render);
+        TRY_REQUIRE(counter->painted > painted);
+        QVERIFY(!screenshot_effect->isActive());
+    }
+}
+
+}
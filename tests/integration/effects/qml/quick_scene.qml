@@ -0,0 +1,30 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+import QtQuick
+
+Item {
+    id: root
+
+    required property QtObject effect
+
+    // Number of times the scene was set up for a run of the effect.
+    property int activations: 0
+
+    Connections {
+        target: root.effect
+        function onRunningChanged() {
+            if (root.effect.running) {
+                root.activations++;
+            }
+        }
+    }
+
+    Component.onCompleted: {
+        if (effect.running) {
+            activations++;
+        }
+    }
+}
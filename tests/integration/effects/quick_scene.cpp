@@ -0,0 +1,107 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "lib/setup.h"
+
+#include <como/render/effect/interface/effects_handler.h>
+#include <como/render/effect/interface/quick_scene.h>
+
+#include <QQuickItem>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+class stub_quick_scene_effect : public QuickSceneEffect
+{
+public:
+    stub_quick_scene_effect()
+    {
+        setSource(QUrl::fromLocalFile(QFINDTESTDATA("./qml/quick_scene.qml")));
+    }
+
+protected:
+    QVariantMap initialProperties(EffectScreen const* /*screen*/) override
+    {
+        return {{QStringLiteral("effect"), QVariant::fromValue<QObject*>(this)}};
+    }
+};
+
+int activations(QuickSceneView* view)
+{
+    return view->rootItem()->property("activations").toInt();
+}
+
+}
+
+TEST_CASE("quick scene", "[effect]")
+{
+    test::setup setup("quick-scene");
+    setup.start();
+
+    stub_quick_scene_effect effect;
+    auto const screen = effects->screens().constFirst();
+
+    SECTION("cold start")
+    {
+        effect.setRunning(true);
+        QVERIFY(effect.isRunning());
+
+        // The scene is incubated asynchronously after the start.
+        TRY_REQUIRE(effect.viewForScreen(screen));
+        QCOMPARE(activations(effect.viewForScreen(screen)), 1);
+
+        effect.setRunning(false);
+        QVERIFY(!effect.viewForScreen(screen));
+    }
+
+    SECTION("warm start")
+    {
+        effect.warmUp();
+        QVERIFY(!effect.isRunning());
+        TRY_REQUIRE(effect.viewForScreen(screen));
+
+        auto view = effect.viewForScreen(screen);
+        QVERIFY(!effect.isActive());
+        QCOMPARE(activations(view), 0);
+
+        // The prepared view is used right away and painted in the next frame.
+        effect.setRunning(true);
+        QCOMPARE(effect.viewForScreen(screen), view);
+        QVERIFY(effect.isActive());
+        QVERIFY(view->isDirty());
+        QCOMPARE(activations(view), 1);
+
+        // Without persistence the views are released on stop.
+        effect.setRunning(false);
+        QVERIFY(!effect.viewForScreen(screen));
+    }
+
+    SECTION("persistent views")
+    {
+        effect.setPersistentViews(true);
+        effect.setRunning(true);
+        TRY_REQUIRE(effect.viewForScreen(screen));
+
+        auto view = effect.viewForScreen(screen);
+        QCOMPARE(activations(view), 1);
+
+        effect.setRunning(false);
+        QCOMPARE(effect.viewForScreen(screen), view);
+        QVERIFY(!effect.isActive());
+
+        effect.setRunning(true);
+        QCOMPARE(effect.viewForScreen(screen), view);
+        QCOMPARE(activations(view), 2);
+
+        effect.setRunning(false);
+        effect.setPersistentViews(false);
+        QVERIFY(!effect.viewForScreen(screen));
+    }
+}
+
+}
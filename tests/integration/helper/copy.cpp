@@ -13,7 +13,7 @@ class Window : public QRasterWindow
 {
     Q_OBJECT
 public:
-    explicit Window(QClipboard::Mode mode);
+    Window(QClipboard::Mode mode, QString text);
     ~Window() override;
 
 protected:
@@ -22,11 +22,13 @@ protected:
 
 private:
     QClipboard::Mode m_mode;
+    QString m_text;
 };
 
-Window::Window(QClipboard::Mode mode)
+Window::Window(QClipboard::Mode mode, QString text)
     : QRasterWindow()
     , m_mode(mode)
+    , m_text(std::move(text))
 {
 }
 
@@ -43,7 +45,7 @@ void Window::focusInEvent(QFocusEvent* event)
 {
     QRasterWindow::focusInEvent(event);
     // TODO: make it work without singleshot
-    QTimer::singleShot(100, [this] { qApp->clipboard()->setText(QStringLiteral("test"), m_mode); });
+    QTimer::singleShot(100, [this] { qApp->clipboard()->setText(m_text, m_mode); });
 }
 
 int main(int argc, char* argv[])
@@ -53,8 +55,14 @@ int main(int argc, char* argv[])
         mode = QClipboard::Selection;
     }
 
+    // Benchmarks pass the size in bytes of the copied text as the first argument.
+    auto text = QStringLiteral("test");
+    if (argc > 2) {
+        text = QString(atoi(argv[1]), QLatin1Char('x'));
+    }
+
     QGuiApplication app(argc, argv);
-    std::unique_ptr<Window> w(new Window(mode));
+    std::unique_ptr<Window> w(new Window(mode, text));
     w->setGeometry(QRect(0, 0, 100, 200));
     w->show();
 
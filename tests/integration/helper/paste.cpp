@@ -4,6 +4,7 @@ SPDX-FileCopyrightText: 2016 Martin Gräßlin <mgraesslin@kde.org>
 SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include <QClipboard>
+#include <QDebug>
 #include <QGuiApplication>
 #include <QPainter>
 #include <QRasterWindow>
@@ -41,11 +42,25 @@ int main(int argc, char* argv[])
         mode = QClipboard::Selection;
     }
 
+    // Benchmarks pass the size in bytes of the copied text as the first argument.
+    auto expected = QStringLiteral("test");
+    if (argc > 2) {
+        expected = QString(atoi(argv[1]), QLatin1Char('x'));
+    }
+
     QGuiApplication app(argc, argv);
-    QObject::connect(app.clipboard(), &QClipboard::changed, &app, [mode] {
-        if (qApp->clipboard()->text(mode) == QLatin1String("test")) {
-            QTimer::singleShot(100, qApp, &QCoreApplication::quit);
+    QObject::connect(app.clipboard(), &QClipboard::changed, &app, [mode, expected] {
+        auto const text = qApp->clipboard()->text(mode);
+        if (text.isEmpty()) {
+            return;
+        }
+
+        // Any other text fails, so a truncated or corrupted transfer is not taken for a paste.
+        auto const code = text == expected ? 0 : 1;
+        if (code) {
+            qWarning() << "Pasted" << text.size() << "characters, expected" << expected.size();
         }
+        QTimer::singleShot(100, qApp, [code] { QCoreApplication::exit(code); });
     });
     std::unique_ptr<Window> w(new Window);
     w->setGeometry(QRect(0, 0, 100, 200));
@@ -88,6 +88,8 @@ setup::setup(std::string const& test_name,
     wlr_output_commit_state(out, &wlr_out_state);
 
     try {
+        base::startup_tracer::scope trace(
+            base->startup, QStringLiteral("render platform"), QStringLiteral("render"));
         base->mod.render = std::make_unique<base_t::render_t>(*base);
     } catch (std::system_error const& exc) {
         std::cerr << "FATAL ERROR: render creation failed: " << exc.what() << std::endl;
@@ -106,10 +108,14 @@ setup::~setup()
 void setup::start()
 {
     base->options = base::create_options(base->operation_mode, base->config.main);
-    base->mod.input
-        = std::make_unique<base_t::input_t>(*base, input::config(KConfig::SimpleConfig));
-    base->mod.input->mod.dbus
-        = std::make_unique<input::dbus::device_manager<base_t::input_t>>(*base->mod.input);
+    {
+        base::startup_tracer::scope trace(
+            base->startup, QStringLiteral("input platform"), QStringLiteral("input"));
+        base->mod.input
+            = std::make_unique<base_t::input_t>(*base, input::config(KConfig::SimpleConfig));
+        base->mod.input->mod.dbus
+            = std::make_unique<input::dbus::device_manager<base_t::input_t>>(*base->mod.input);
+    }
 
     keyboard = static_cast<wlr_keyboard*>(calloc(1, sizeof(wlr_keyboard)));
     pointer = static_cast<wlr_pointer*>(calloc(1, sizeof(wlr_pointer)));
@@ -125,12 +131,22 @@ void setup::start()
     wlr_signal_emit_safe(&base->backend.native->events.new_input, pointer);
     wlr_signal_emit_safe(&base->backend.native->events.new_input, touch);
 
-    base->mod.space = std::make_unique<base_t::space_t>(*base->mod.render, *base->mod.input);
-    base->mod.space->mod.desktop
-        = std::make_unique<desktop::kde::platform<base_t::space_t>>(*base->mod.space);
-    win::init_shortcuts(*base->mod.space);
-    render::init_shortcuts(*base->mod.render);
-    base->mod.script = std::make_unique<scripting::platform<base_t::space_t>>(*base->mod.space);
+    {
+        base::startup_tracer::scope trace(
+            base->startup, QStringLiteral("space"), QStringLiteral("win"));
+        base->mod.space
+            = std::make_unique<base_t::space_t>(*base->mod.render, *base->mod.input);
+        base->mod.space->mod.desktop
+            = std::make_unique<desktop::kde::platform<base_t::space_t>>(*base->mod.space);
+        win::init_shortcuts(*base->mod.space);
+        render::init_shortcuts(*base->mod.render);
+    }
+    {
+        base::startup_tracer::scope trace(
+            base->startup, QStringLiteral("scripting"), QStringLiteral("script"));
+        base->mod.script
+            = std::make_unique<scripting::platform<base_t::space_t>>(*base->mod.space);
+    }
 
     base::wayland::platform_start(*base);
 
@@ -292,6 +292,71 @@ TEST_CASE("move resize window", "[win]")
         QVERIFY(wait_for_destroyed(c));
     }
 
+    SECTION("resize throttling")
+    {
+        // During an interactive resize only one configure is outstanding at a time.
+        auto surface = create_surface();
+        QVERIFY(surface);
+        auto shellSurface = create_xdg_shell_toplevel(surface);
+        QVERIFY(shellSurface);
+
+        auto c = render_and_wait_for_shown(surface, QSize(100, 50), Qt::blue);
+        QVERIFY(c);
+        QCOMPARE(get_wayland_window(setup.base->mod.space->stacking.active), c);
+        QCOMPARE(c->geo.frame, QRect(0, 0, 100, 50));
+
+        QSignalSpy configureRequestedSpy(shellSurface.get(),
+                                         &Wrapland::Client::XdgShellToplevel::configured);
+        QVERIFY(configureRequestedSpy.isValid());
+        QSignalSpy geometryChangedSpy(c->qobject.get(),
+                                      &win::window_qobject::frame_geometry_changed);
+        QVERIFY(geometryChangedSpy.isValid());
+
+        win::active_window_resize(*setup.base->mod.space);
+        QCOMPARE(win::is_resize(c), true);
+        QVERIFY(configureRequestedSpy.wait());
+        auto const count = configureRequestedSpy.count();
+
+        win::key_press_event(c, Qt::Key_Right);
+        win::update_move_resize(c, cursor()->pos());
+        QVERIFY(configureRequestedSpy.wait());
+        QCOMPARE(configureRequestedSpy.count(), count + 1);
+        QCOMPARE(shellSurface->get_configure_data().size, QSize(108, 50));
+        auto const serial = configureRequestedSpy.back().front().value<quint32>();
+
+        // Further changes are held back while the client has not committed the configure.
+        win::key_press_event(c, Qt::Key_Right);
+        win::update_move_resize(c, cursor()->pos());
+        win::key_press_event(c, Qt::Key_Right);
+        win::update_move_resize(c, cursor()->pos());
+        REQUIRE_FALSE(configureRequestedSpy.wait(100));
+        QCOMPARE(configureRequestedSpy.count(), count + 1);
+
+        // Acking alone does not release them.
+        shellSurface->ackConfigure(serial);
+        REQUIRE_FALSE(configureRequestedSpy.wait(100));
+
+        // Once the client committed, the latest size is sent in a single configure.
+        render(surface, QSize(108, 50), Qt::blue);
+        QVERIFY(geometryChangedSpy.wait());
+        QCOMPARE(c->geo.frame, QRect(0, 0, 108, 50));
+        TRY_REQUIRE(configureRequestedSpy.count() == count + 2);
+        QCOMPARE(shellSurface->get_configure_data().size, QSize(124, 50));
+        QVERIFY(c->resize_configure.response_time.count() > 0);
+
+        shellSurface->ackConfigure(configureRequestedSpy.back().front().value<quint32>());
+        render(surface, QSize(124, 50), Qt::blue);
+        QVERIFY(geometryChangedSpy.wait());
+        QCOMPARE(c->geo.frame, QRect(0, 0, 124, 50));
+
+        win::key_press_event(c, Qt::Key_Enter);
+        QCOMPARE(win::is_resize(c), false);
+        QVERIFY(!c->resize_configure.held_frame);
+
+        surface.reset();
+        QVERIFY(wait_for_destroyed(c));
+    }
+
     SECTION("pack to")
     {
         struct data {
@@ -0,0 +1,172 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "generic_scene_opengl.h"
+#include "lib/setup.h"
+
+#include "como/render/effect/interface/offscreen_effect.h"
+
+#include <Wrapland/Client/shm_pool.h>
+#include <Wrapland/Client/surface.h>
+#include <Wrapland/Client/xdg_shell.h>
+
+namespace como::detail::test
+{
+
+/**
+ * Redirects a window without transforming it and reads back each painted frame.
+ */
+class offscreen_redirect_effect : public OffscreenEffect
+{
+public:
+    int requestedEffectChainPosition() const override
+    {
+        return 10;
+    }
+
+    void paintScreen(effect::screen_paint_data& data) override
+    {
+        effects->paintScreen(data);
+        images.push_back(effects->blit_from_framebuffer(data.render, data.screen->geometry(), 1.));
+    }
+
+    void redirect_window(EffectWindow* window)
+    {
+        redirect(window);
+    }
+
+    std::vector<QImage> images;
+};
+
+/**
+ * Records the regions of a window rendered into the offscreen texture. The redirecting effect
+ * passes these renders further down the chain, while it paints the window on screen itself.
+ * Optionally dims the rendered content to tell renders apart.
+ */
+class offscreen_render_recorder : public Effect
+{
+public:
+    int requestedEffectChainPosition() const override
+    {
+        return 90;
+    }
+
+    void drawWindow(effect::window_paint_data& data) override
+    {
+        if (&data.window == window) {
+            renders.push_back(data.paint.region);
+            if (dim) {
+                data.paint.brightness *= 0.5;
+            }
+        }
+        effects->drawWindow(data);
+    }
+
+    EffectWindow* window{nullptr};
+    bool dim{false};
+    std::vector<QRegion> renders;
+};
+
+TEST_CASE("offscreen effect", "[render]")
+{
+    auto setup = generic_scene_opengl_get_setup("offscreen-effect", "O2");
+    setup->set_outputs(1);
+    setup_wayland_connection();
+
+    // Owned by the effects handler.
+    auto redirect_effect = new offscreen_redirect_effect;
+    auto recorder = new offscreen_render_recorder;
+    auto& loader = setup->base->mod.render->effects->loader;
+    Q_EMIT loader->effectLoaded(redirect_effect, QStringLiteral("offscreen_redirect"));
+    Q_EMIT loader->effectLoaded(recorder, QStringLiteral("offscreen_render_recorder"));
+
+    auto surface = create_surface();
+    auto toplevel = create_xdg_shell_toplevel(surface);
+    REQUIRE(toplevel);
+
+    auto window = render_and_wait_for_shown(surface, QSize(100, 100), Qt::red);
+    REQUIRE(window);
+
+    // In the vertical center of the output, so the sampled row is the same independent of the
+    // orientation of the read back image.
+    auto const output = get_output(0)->geometry();
+    auto const y = output.center().y();
+    win::move(window, QPoint(100, y - 50));
+
+    auto eff_win = window->render->effect.get();
+    recorder->window = eff_win;
+    redirect_effect->redirect_window(eff_win);
+
+    auto next_image = [&] {
+        auto const count = redirect_effect->images.size();
+        render::full_repaint(*setup->base->mod.render);
+        TRY_REQUIRE(redirect_effect->images.size() > count);
+        return redirect_effect->images.back();
+    };
+
+    auto is_red = [&](auto const& image, int x) {
+        return image.pixelColor(x, y) == QColor(Qt::red);
+    };
+    auto is_dimmed = [&](auto const& image, int x) {
+        auto const color = image.pixelColor(x, y);
+        return color.red() > 64 && color.red() < 192 && color.green() == 0;
+    };
+
+    // The texture is rendered in full when it was allocated.
+    auto image = next_image();
+    REQUIRE(recorder->renders.size() == 1);
+    REQUIRE(recorder->renders.front() == infiniteRegion());
+    REQUIRE(is_red(image, 125));
+    REQUIRE(is_red(image, 175));
+
+    // Without damage the texture is painted as is.
+    recorder->renders.clear();
+    image = next_image();
+    REQUIRE(recorder->renders.empty());
+    REQUIRE(is_red(image, 125));
+
+    recorder->dim = true;
+
+    SECTION("damage")
+    {
+        // The same content with damage on a strip in the left half of the window.
+        auto const damage = QRect(10, 0, 30, 100);
+
+        QImage buffer(QSize(100, 100), QImage::Format_ARGB32_Premultiplied);
+        buffer.fill(Qt::red);
+        surface->attachBuffer(get_client().interfaces.shm->createBuffer(buffer));
+        surface->damage(damage);
+        surface->commit(Wrapland::Client::Surface::CommitFlag::None);
+        flush_wayland_connection();
+
+        TRY_REQUIRE(recorder->renders.size() == 1);
+
+        // Only the damage and the texels around it are rendered again.
+        auto const expected = damage.adjusted(-1, -1, 1, 1)
+                                  .translated(eff_win->bufferGeometry().topLeft())
+                                  .intersected(eff_win->expandedGeometry());
+        REQUIRE(recorder->renders.front() == QRegion(expected));
+
+        // The rest of the texture keeps its previous content.
+        image = next_image();
+        REQUIRE(recorder->renders.size() == 1);
+        REQUIRE(is_dimmed(image, 125));
+        REQUIRE(is_red(image, 175));
+    }
+
+    SECTION("damage without extents")
+    {
+        // The window is rendered in full again.
+        Q_EMIT eff_win->windowDamaged(eff_win, QRegion());
+
+        image = next_image();
+        REQUIRE(recorder->renders.size() == 1);
+        REQUIRE(recorder->renders.front() == infiniteRegion());
+        REQUIRE(is_dimmed(image, 125));
+        REQUIRE(is_dimmed(image, 175));
+    }
+}
+
+}
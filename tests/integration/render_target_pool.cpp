@@ -0,0 +1,178 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "generic_scene_opengl.h"
+#include "lib/setup.h"
+
+#include "como/render/gl/interface/framebuffer.h"
+#include "como/render/gl/interface/render_target_pool.h"
+#include "como/render/gl/interface/texture.h"
+#include "como/render/gl/render_target_pool_metrics.h"
+
+namespace como::detail::test
+{
+
+TEST_CASE("render target pool", "[render]")
+{
+    // Room for four textures of 256x256 pixels.
+    qputenv("KWIN_GL_RENDER_TARGET_BUDGET", QByteArrayLiteral("1"));
+
+    auto setup = generic_scene_opengl_get_setup("render-target-pool", "O2");
+    setup->set_outputs(1);
+    REQUIRE(setup->base->mod.render->effects->makeOpenGLContextCurrent());
+
+    // Starts from a pool with the budget of the environment.
+    GLRenderTargetPool::cleanup();
+    auto pool = GLRenderTargetPool::instance();
+    REQUIRE(pool->budget() == 1024 * 1024);
+
+    auto const& stats = pool->stats();
+
+    SECTION("reuse")
+    {
+        auto target = pool->acquire(QSize(100, 50));
+        REQUIRE(target);
+        auto const texture = target->texture();
+        REQUIRE(stats.usedBytes == 128 * 64 * 4);
+
+        target.reset();
+        REQUIRE(stats.usedBytes == 0);
+        REQUIRE(stats.pooledBytes == 128 * 64 * 4);
+
+        // A different size of the same class gets the released texture.
+        target = pool->acquire(QSize(110, 60));
+        REQUIRE(target);
+        REQUIRE(target->texture() == texture);
+
+        // Other formats and exact fits do not.
+        auto exact = pool->acquire(QSize(128, 64), GL_RGBA8, GLRenderTargetPool::Fit::Exact);
+        REQUIRE(exact);
+        REQUIRE(exact->texture() != texture);
+        auto other_format = pool->acquire(QSize(100, 50), GL_RGBA16F);
+        REQUIRE(other_format);
+        REQUIRE(other_format->texture() != texture);
+
+        REQUIRE(stats.acquired == 4);
+        REQUIRE(stats.reused == 1);
+        REQUIRE(stats.allocated == 3);
+    }
+
+    SECTION("oversized size class")
+    {
+        auto target = pool->acquire(QSize(100, 50));
+        REQUIRE(target);
+        REQUIRE(target->size() == QSize(100, 50));
+        REQUIRE(target->texture()->size() == QSize(128, 64));
+        REQUIRE(target->textureCoordScale() == QSizeF(100. / 128, 50. / 64));
+
+        // Renders into the top part of the texture in OpenGL coordinates.
+        auto framebuffer = target->framebuffer();
+        REQUIRE(framebuffer->size() == QSize(100, 50));
+        REQUIRE(framebuffer->viewport() == QRect(0, 14, 100, 50));
+
+        // Resizing in the class moves the viewport without a new texture.
+        auto const texture = target->texture();
+        REQUIRE(target->resize(QSize(120, 40)));
+        REQUIRE(target->texture() == texture);
+        REQUIRE(target->framebuffer()->viewport() == QRect(0, 24, 120, 40));
+
+        // The size of the class renders into the whole texture.
+        REQUIRE(target->resize(QSize(128, 64)));
+        REQUIRE(target->framebuffer()->texture == texture);
+        REQUIRE(target->framebuffer()->viewport() == QRect(0, 0, 128, 64));
+        REQUIRE(target->textureCoordScale() == QSizeF(1, 1));
+
+        REQUIRE_FALSE(target->resize(QSize(200, 64)));
+        REQUIRE(target->size() == QSize(128, 64));
+
+        // Exact fits are never resized.
+        auto exact = pool->acquire(QSize(100, 50), GL_RGBA8, GLRenderTargetPool::Fit::Exact);
+        REQUIRE(exact);
+        REQUIRE(exact->texture()->size() == QSize(100, 50));
+        REQUIRE(exact->textureCoordScale() == QSizeF(1, 1));
+        REQUIRE_FALSE(exact->resize(QSize(90, 50)));
+    }
+
+    SECTION("eviction")
+    {
+        uint64_t const small_bytes = 256 * 256 * 4;
+
+        std::vector<std::unique_ptr<GLRenderTarget>> targets;
+        for (int i = 0; i < 3; i++) {
+            targets.push_back(pool->acquire(QSize(256, 256)));
+            REQUIRE(targets.back());
+        }
+        targets.clear();
+
+        // Still in budget.
+        REQUIRE(stats.evicted == 0);
+        REQUIRE(stats.pooledBytes == 3 * small_bytes);
+
+        // Textures in use count against the budget. The oldest unused ones are freed first.
+        auto large = pool->acquire(QSize(512, 512));
+        REQUIRE(large);
+        REQUIRE(stats.usedBytes == 4 * small_bytes);
+
+        large.reset();
+        REQUIRE(stats.evicted == 3);
+        REQUIRE(stats.pooledBytes == 4 * small_bytes);
+        REQUIRE(stats.usedBytes == 0);
+
+        auto const allocated = stats.allocated;
+        auto small = pool->acquire(QSize(256, 256));
+        REQUIRE(small);
+        REQUIRE(stats.allocated == allocated + 1);
+
+        // Lowering the budget frees unused textures right away.
+        pool->setBudget(0);
+        REQUIRE(stats.evicted == 4);
+        REQUIRE(stats.pooledBytes == 0);
+        REQUIRE(stats.usedBytes == small_bytes);
+    }
+
+    SECTION("metrics")
+    {
+        auto target = pool->acquire(QSize(256, 256));
+        REQUIRE(target);
+        auto other = pool->acquire(QSize(64, 64));
+        REQUIRE(other);
+        other.reset();
+
+        // Published by the scene once it painted.
+        auto& metrics = render::gl::render_target_pool_metrics::instance();
+        render::full_repaint(*setup->base->mod.render);
+        TRY_REQUIRE(metrics.used_bytes.value() == 256 * 256 * 4);
+        REQUIRE(metrics.pooled_bytes.value() == 64 * 64 * 4);
+        REQUIRE(metrics.acquired.value() == 2);
+        REQUIRE(metrics.allocated.value() == 2);
+        REQUIRE(metrics.reused.value() == 0);
+        REQUIRE(metrics.evicted.value() == 0);
+
+        target.reset();
+        render::full_repaint(*setup->base->mod.render);
+        TRY_REQUIRE(metrics.used_bytes.value() == 0);
+        REQUIRE(metrics.pooled_bytes.value() == (256 * 256 + 64 * 64) * 4);
+    }
+
+    SECTION("cleanup")
+    {
+        auto target = pool->acquire(QSize(256, 256));
+        REQUIRE(target);
+        target.reset();
+        REQUIRE(stats.pooledBytes > 0);
+
+        // Tearing down the GL backend on shutdown calls cleanupGL, which frees the pool. Another
+        // pool is created empty then. Without textures it can be destroyed without a context.
+        setup.reset();
+        auto const& new_stats = GLRenderTargetPool::instance()->stats();
+        REQUIRE(new_stats.acquired == 0);
+        REQUIRE(new_stats.pooledBytes == 0);
+        GLRenderTargetPool::cleanup();
+    }
+
+    qunsetenv("KWIN_GL_RENDER_TARGET_BUDGET");
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "lib/setup.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace como::detail::test
+{
+
+TEST_CASE("startup", "[base]")
+{
+    // Upper bound for reaching the first presented frame with the headless backend. It is generous
+    // to not fail on busy CI machines but catches regressions like blocking plugin scans or
+    // synchronous waits in the startup path.
+    constexpr std::chrono::milliseconds budget{5000};
+
+    test::setup setup("startup");
+    setup.start();
+
+    auto& tracer = setup.base->startup;
+    TRY_REQUIRE_WITH_TIMEOUT(tracer.finished(), budget.count());
+    REQUIRE(tracer.first_frame());
+    REQUIRE(*tracer.first_frame() < budget);
+
+    auto const& phases = tracer.phases();
+    auto find_phase = [&](QString const& name) {
+        return std::find_if(
+            phases.cbegin(), phases.cend(), [&](auto const& phase) { return phase.name == name; });
+    };
+
+    SECTION("phases")
+    {
+        struct data {
+            QString name;
+            QString category;
+        };
+
+        auto test_data = GENERATE(data{"base platform", "base"},
+                                  data{"options", "base"},
+                                  data{"render platform", "render"},
+                                  data{"input platform", "input"},
+                                  data{"space", "win"},
+                                  data{"scripting", "script"},
+                                  data{"scene", "render"},
+                                  data{"effects", "render"});
+
+        auto phase = find_phase(test_data.name);
+        REQUIRE(phase != phases.cend());
+        QCOMPARE(phase->category, test_data.category);
+        QVERIFY(phase->begin <= phase->end);
+        QVERIFY(phase->end <= *tracer.first_frame());
+    }
+
+    SECTION("order")
+    {
+        auto base = find_phase("base platform");
+        auto render = find_phase("render platform");
+        auto space = find_phase("space");
+        auto scene = find_phase("scene");
+        REQUIRE(base != phases.cend());
+        REQUIRE(render != phases.cend());
+        REQUIRE(space != phases.cend());
+        REQUIRE(scene != phases.cend());
+
+        QVERIFY(base->end <= render->begin);
+        QVERIFY(render->end <= space->begin);
+        QVERIFY(space->end <= scene->begin);
+    }
+
+    SECTION("chrome trace")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        auto const path = dir.filePath(QStringLiteral("trace.json"));
+        REQUIRE(tracer.write(path));
+
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::ReadOnly));
+
+        auto const root = QJsonDocument::fromJson(file.readAll()).object();
+        auto const events = root.value(QStringLiteral("traceEvents")).toArray();
+
+        // All phases and the first frame marker.
+        QCOMPARE(events.size(), static_cast<qsizetype>(phases.size() + 1));
+
+        for (auto const& value : events) {
+            auto const event = value.toObject();
+            QVERIFY(!event.value(QStringLiteral("name")).toString().isEmpty());
+            QVERIFY(event.value(QStringLiteral("ts")).toDouble() >= 0);
+
+            auto const type = event.value(QStringLiteral("ph")).toString();
+            QVERIFY((type == QStringLiteral("X") || type == QStringLiteral("i")));
+        }
+    }
+}
+
+TEST_CASE("startup xwayland", "[base],[xwl]")
+{
+    test::setup setup("startup-xwayland", base::operation_mode::xwayland);
+    setup.start();
+
+    auto& tracer = setup.base->startup;
+    TRY_REQUIRE_WITH_TIMEOUT(tracer.finished(), 5000);
+
+    auto find_xwayland = [&] {
+        auto const& phases = tracer.phases();
+        return std::count_if(phases.cbegin(), phases.cend(), [](auto const& phase) {
+            return phase.name == QStringLiteral("xwayland");
+        });
+    };
+
+    // Xwayland is started on demand, commonly after the first frame. It is still recorded.
+    auto connection = xcb_connection_create();
+    QVERIFY(!xcb_connection_has_error(connection.get()));
+    TRY_REQUIRE_WITH_TIMEOUT(find_xwayland() == 1, 5000);
+
+    auto const& phases = tracer.phases();
+    auto phase = std::find_if(phases.cbegin(), phases.cend(), [](auto const& data) {
+        return data.name == QStringLiteral("xwayland");
+    });
+    QCOMPARE(phase->category, QStringLiteral("xwl"));
+    QVERIFY(phase->begin <= phase->end);
+
+    // Other phases after the first frame are still ignored.
+    auto const count = phases.size();
+    tracer.add(QStringLiteral("scene"), QStringLiteral("render"), tracer.now());
+    tracer.add(QStringLiteral("xwayland"), QStringLiteral("xwl"), tracer.now());
+    QCOMPARE(tracer.phases().size(), count);
+}
+
+}
@@ -6,6 +6,8 @@ SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "lib/setup.h"
 
+#include "como/debug/perf/metrics.h"
+
 #include <KDecoration2/Decoration>
 #include <Wrapland/Client/compositor.h>
 #include <Wrapland/Client/plasmashell.h>
@@ -346,6 +348,68 @@ TEST_CASE("struts", "[win]")
             == QRect(0, 0, 2560, 1000));
     }
 
+    SECTION("incremental area update")
+    {
+        // Adding a panel after the outputs are set up checks only windows on the changed output.
+        auto& registry = debug::metrics_registry::instance();
+        auto const& full = registry.counter(QStringLiteral("como_space_areas_updates_total"),
+                                            QStringLiteral("Updates of work areas and struts."),
+                                            {{QStringLiteral("kind"), QStringLiteral("full")}});
+        auto const& incremental
+            = registry.counter(QStringLiteral("como_space_areas_updates_total"),
+                               QStringLiteral("Updates of work areas and struts."),
+                               {{QStringLiteral("kind"), QStringLiteral("incremental")}});
+        // A window touching the bottom of the first output is kept at the new bottom edge. A window
+        // beyond the second output would be moved back onto it, if it were checked.
+        auto show_window = [&](auto const& surface, QPoint const& pos) {
+            auto window = render_and_wait_for_shown(surface, QSize(100, 100), Qt::blue);
+            REQUIRE(window);
+            win::move(window, pos);
+            REQUIRE(window->geo.frame == QRect(pos, QSize(100, 100)));
+            return window;
+        };
+
+        auto affected_surface = create_surface();
+        auto affected_toplevel = create_xdg_shell_toplevel(affected_surface);
+        auto affected = show_window(affected_surface, QPoint(100, 924));
+
+        auto unaffected_surface = create_surface();
+        auto unaffected_toplevel = create_xdg_shell_toplevel(unaffected_surface);
+        auto unaffected = show_window(unaffected_surface, QPoint(2600, 100));
+
+        auto const full_count = full.value();
+        auto const incremental_count = incremental.value();
+
+        const QRect windowGeometry(0, 1000, 1280, 24);
+        auto surface = create_surface();
+        auto shellSurface = create_xdg_shell_toplevel(surface, CreationSetup::CreateOnly);
+
+        auto plasmaSurface = std::unique_ptr<Wrapland::Client::PlasmaShellSurface>(
+            plasma_shell->createSurface(surface.get()));
+        plasmaSurface->setPosition(windowGeometry.topLeft());
+        plasmaSurface->setRole(Wrapland::Client::PlasmaShellSurface::Role::Panel);
+        init_xdg_shell_toplevel(surface, shellSurface);
+
+        auto c = render_and_wait_for_shown(
+            surface, windowGeometry.size(), Qt::red, QImage::Format_RGB32);
+        QVERIFY(c);
+        QVERIFY(c->hasStrut());
+
+        REQUIRE(full.value() == full_count);
+        REQUIRE(incremental.value() > incremental_count);
+
+        auto const& outputs = setup.base->outputs;
+        REQUIRE(win::space_window_area(
+                    *setup.base->mod.space, win::area_option::placement, outputs.at(0), 1)
+                == QRect(0, 0, 1280, 1000));
+        REQUIRE(win::space_window_area(
+                    *setup.base->mod.space, win::area_option::placement, outputs.at(1), 1)
+                == QRect(1280, 0, 1280, 1024));
+
+        REQUIRE(affected->geo.frame == QRect(100, 900, 100, 100));
+        REQUIRE(unaffected->geo.frame == QRect(2600, 100, 100, 100));
+    }
+
     SECTION("wayland mobile panel")
     {
         // First enable maxmizing policy
@@ -0,0 +1,163 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "generic_scene_opengl.h"
+#include "lib/setup.h"
+
+#include "como/render/gl/window_batch.h"
+
+#include <Wrapland/Client/surface.h>
+#include <Wrapland/Client/xdg_shell.h>
+
+namespace como::detail::test
+{
+
+/**
+ * Records the batch metrics of each painted frame and reads back its content. Optionally
+ * translates a window to paint it transformed.
+ */
+class batch_frame_effect : public Effect
+{
+public:
+    struct frame {
+        double windows;
+        double draw_calls;
+        double flushes;
+        QImage image;
+    };
+
+    void prePaintScreen(effect::screen_prepaint_data& data) override
+    {
+        if (transformed) {
+            data.paint.mask |= PAINT_SCREEN_WITH_TRANSFORMED_WINDOWS;
+        }
+        effects->prePaintScreen(data);
+    }
+
+    void paintScreen(effect::screen_paint_data& data) override
+    {
+        auto& metrics = render::gl::window_batch_metrics::instance();
+        auto const windows = metrics.windows.value();
+        auto const draw_calls = metrics.draw_calls.value();
+        auto const flushes = metrics.flushes.value();
+
+        effects->paintScreen(data);
+
+        // Reading back flushes the last batch.
+        auto image = effects->blit_from_framebuffer(data.render, data.screen->geometry(), 1.);
+
+        frames.push_back({metrics.windows.value() - windows,
+                          metrics.draw_calls.value() - draw_calls,
+                          metrics.flushes.value() - flushes,
+                          image});
+    }
+
+    void prePaintWindow(effect::window_prepaint_data& data) override
+    {
+        if (&data.window == transformed) {
+            data.paint.mask |= PAINT_WINDOW_TRANSFORMED;
+        }
+        effects->prePaintWindow(data);
+    }
+
+    void paintWindow(effect::window_paint_data& data) override
+    {
+        if (&data.window == transformed) {
+            data.paint.geo.translation += QVector3D(100, 0, 0);
+        }
+        effects->paintWindow(data);
+    }
+
+    EffectWindow* transformed{nullptr};
+    std::vector<frame> frames;
+};
+
+TEST_CASE("window batch", "[render]")
+{
+    auto setup = generic_scene_opengl_get_setup("window-batch", "O2");
+    setup->set_outputs(1);
+    setup_wayland_connection();
+
+    // Owned by the effects handler.
+    auto effect = new batch_frame_effect;
+    Q_EMIT setup->base->mod.render->effects->loader->effectLoaded(effect,
+                                                                  QStringLiteral("batch_frame"));
+
+    // Windows side by side in the vertical center of the output. The sampled row is the same
+    // independent of the orientation of the read back image.
+    auto const output = get_output(0)->geometry();
+    auto const y = output.center().y();
+
+    auto show = [&](auto const& surface, QColor const& color, int x) {
+        auto window = render_and_wait_for_shown(surface, QSize(100, 100), color);
+        REQUIRE(window);
+        win::move(window, QPoint(x, y - 50));
+        return window;
+    };
+
+    std::unique_ptr<Wrapland::Client::Surface> surfaces[3];
+    std::unique_ptr<Wrapland::Client::XdgShellToplevel> toplevels[3];
+    for (int i = 0; i < 3; i++) {
+        surfaces[i] = create_surface();
+        toplevels[i] = create_xdg_shell_toplevel(surfaces[i]);
+        QVERIFY(toplevels[i]);
+    }
+
+    show(surfaces[0], Qt::red, 0);
+    auto middle = show(surfaces[1], Qt::green, 200);
+    show(surfaces[2], Qt::blue, 400);
+
+    auto next_frame = [&]() -> batch_frame_effect::frame {
+        auto const count = effect->frames.size();
+        render::full_repaint(*setup->base->mod.render);
+        TRY_REQUIRE(effect->frames.size() > count);
+        return effect->frames.at(count);
+    };
+
+    auto color_at = [&](auto const& frame, int x) { return frame.image.pixelColor(x, y); };
+
+    SECTION("untransformed windows")
+    {
+        auto const frame = next_frame();
+
+        // All windows are drawn with one vertex upload. Each window has its own texture.
+        REQUIRE(frame.windows == 3);
+        REQUIRE(frame.flushes == 1);
+        REQUIRE(frame.draw_calls == 3);
+
+        REQUIRE(color_at(frame, 50) == QColor(Qt::red));
+        REQUIRE(color_at(frame, 250) == QColor(Qt::green));
+        REQUIRE(color_at(frame, 450) == QColor(Qt::blue));
+        REQUIRE(color_at(frame, 150) != QColor(Qt::red));
+        REQUIRE(color_at(frame, 150) != QColor(Qt::green));
+    }
+
+    SECTION("transformed window")
+    {
+        effect->transformed = middle->render->effect.get();
+        auto const frame = next_frame();
+
+        // The transformed window is painted on its own. It splits the windows below and above it
+        // into two batches.
+        REQUIRE(frame.windows == 2);
+        REQUIRE(frame.flushes == 2);
+        REQUIRE(frame.draw_calls == 2);
+
+        REQUIRE(color_at(frame, 50) == QColor(Qt::red));
+        REQUIRE(color_at(frame, 250) != QColor(Qt::green));
+        REQUIRE(color_at(frame, 350) == QColor(Qt::green));
+        REQUIRE(color_at(frame, 450) == QColor(Qt::blue));
+
+        effect->transformed = nullptr;
+        auto const untransformed = next_frame();
+
+        REQUIRE(untransformed.windows == 3);
+        REQUIRE(untransformed.flushes == 1);
+        REQUIRE(color_at(untransformed, 250) == QColor(Qt::green));
+        REQUIRE(color_at(untransformed, 350) != QColor(Qt::green));
+    }
+}
+
+}
@@ -1384,6 +1384,50 @@ TEST_CASE("xdg-shell window", "[win]")
         QCOMPARE(win::render_geometry(client).size(), QSize(200, 100));
     }
 
+    SECTION("subsurface render order")
+    {
+        // This test verifies that the annexed descendants of a window follow the stacking of its
+        // subsurfaces, each directly followed by its own subsurfaces.
+        auto surface = create_surface();
+        QVERIFY(surface);
+        auto shellSurface = create_xdg_shell_toplevel(surface);
+        QVERIFY(shellSurface);
+
+        auto client = render_and_wait_for_shown(surface, QSize(200, 100), Qt::red);
+        QVERIFY(client);
+
+        auto first_surface = create_surface();
+        auto first = create_subsurface(first_surface, surface);
+        QVERIFY(first);
+        auto second_surface = create_surface();
+        auto second = create_subsurface(second_surface, surface);
+        QVERIFY(second);
+        auto nested_surface = create_surface();
+        auto nested = create_subsurface(nested_surface, first_surface);
+        QVERIFY(nested);
+
+        render(nested_surface, QSize(10, 10), Qt::blue);
+        render(first_surface, QSize(20, 20), Qt::blue);
+        render(second_surface, QSize(30, 30), Qt::blue);
+        surface->commit(Wrapland::Client::Surface::CommitFlag::None);
+
+        auto get_sizes = [&] {
+            std::vector<QSize> sizes;
+            for (auto child : client->transient->annexed_descendants()) {
+                sizes.push_back(child->geo.size());
+            }
+            return sizes;
+        };
+
+        TRY_REQUIRE(get_sizes() == std::vector<QSize>{{20, 20}, {10, 10}, {30, 30}});
+
+        // Restacking the first subsurface above the second one moves its subsurface along.
+        first->placeAbove(QPointer<Wrapland::Client::SubSurface>(second.get()));
+        surface->commit(Wrapland::Client::Surface::CommitFlag::None);
+
+        TRY_REQUIRE(get_sizes() == std::vector<QSize>{{30, 30}, {20, 20}, {10, 10}});
+    }
+
     SECTION("window geo interactive resize")
     {
         // This test verifies that correct window geometry is provided along each
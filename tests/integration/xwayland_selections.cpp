@@ -6,6 +6,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "lib/setup.h"
 
+#include <QElapsedTimer>
 #include <QProcess>
 #include <QProcessEnvironment>
 #include <catch2/generators/catch_generators.hpp>
@@ -13,6 +14,167 @@ SPDX-License-Identifier: GPL-2.0-or-later
 namespace como::detail::test
 {
 
+namespace
+{
+
+enum class sync_direction {
+    wayland_to_x11,
+    x11_to_wayland,
+};
+
+struct copy_paste_result {
+    int exit_code{-1};
+    // From starting the paste process until it exited.
+    std::chrono::milliseconds paste_time{0};
+};
+
+/**
+ * Copies with the copy helper and pastes with the paste helper on the other platform. If
+ * @a payload_size is set, the copy helper offers text of that size instead of the default text.
+ */
+copy_paste_result copy_paste(test::setup& setup,
+                             std::string const& clipboard_mode,
+                             sync_direction direction,
+                             std::optional<int> payload_size = {})
+{
+    QString copy_platform = QStringLiteral("wayland");
+    QString paste_platform = QStringLiteral("xcb");
+
+    if (direction == sync_direction::x11_to_wayland) {
+        copy_platform = QStringLiteral("xcb");
+        paste_platform = QStringLiteral("wayland");
+    } else {
+        REQUIRE(direction == sync_direction::wayland_to_x11);
+    }
+
+    QStringList arguments;
+    if (payload_size) {
+        arguments << QString::number(*payload_size);
+    }
+    arguments << QString::fromStdString(clipboard_mode);
+
+    // this test verifies the syncing of X11 to Wayland clipboard
+    QString const copy = QFINDTESTDATA(QStringLiteral("copy"));
+    QVERIFY(!copy.isEmpty());
+    const QString paste = QFINDTESTDATA(QStringLiteral("paste"));
+    QVERIFY(!paste.isEmpty());
+
+    QSignalSpy clientAddedSpy(setup.base->mod.space->qobject.get(), &space::qobject_t::clientAdded);
+    QVERIFY(clientAddedSpy.isValid());
+    QSignalSpy shellClientAddedSpy(setup.base->mod.space->qobject.get(),
+                                   &space::qobject_t::wayland_window_added);
+    QVERIFY(shellClientAddedSpy.isValid());
+
+    QSignalSpy clipboardChangedSpy = [&setup, &clipboard_mode]() {
+        if (clipboard_mode == "Clipboard") {
+            return QSignalSpy(setup.base->server->seat(),
+                              &Wrapland::Server::Seat::selectionChanged);
+        }
+        if (clipboard_mode == "Selection") {
+            return QSignalSpy(setup.base->server->seat(),
+                              &Wrapland::Server::Seat::primarySelectionChanged);
+        }
+        std::terminate();
+    }();
+
+    QVERIFY(clipboardChangedSpy.isValid());
+
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+
+    // start the copy process
+    environment.insert(QStringLiteral("QT_QPA_PLATFORM"), copy_platform);
+    auto copy_process = std::make_unique<QProcess>();
+    copy_process->setProcessEnvironment(environment);
+    copy_process->setProcessChannelMode(QProcess::ForwardedChannels);
+    copy_process->setProgram(copy);
+    copy_process->setArguments(arguments);
+    copy_process->start();
+    QVERIFY(copy_process->waitForStarted());
+
+    std::optional<space::window_t> copyClient;
+    if (copy_platform == QLatin1String("xcb")) {
+        QVERIFY(clientAddedSpy.wait());
+        auto copy_client_id = clientAddedSpy.first().first().value<quint32>();
+        copyClient = setup.base->mod.space->windows_map.at(copy_client_id);
+    } else {
+        QVERIFY(shellClientAddedSpy.wait());
+        auto copy_client_id = shellClientAddedSpy.first().first().value<quint32>();
+        copyClient = setup.base->mod.space->windows_map.at(copy_client_id);
+    }
+    QVERIFY(copyClient);
+    if (setup.base->mod.space->stacking.active != *copyClient) {
+        std::visit(overload{[&setup](auto&& win) {
+                       win::activate_window(*setup.base->mod.space, *win);
+                   }},
+                   *copyClient);
+    }
+    QCOMPARE(setup.base->mod.space->stacking.active, copyClient);
+    if (copy_platform == QLatin1String("xcb")) {
+        QVERIFY(clipboardChangedSpy.isEmpty());
+        QVERIFY(clipboardChangedSpy.wait());
+    } else {
+        // TODO: it would be better to be able to connect to a signal, instead of waiting
+        // the idea is to make sure that the clipboard is updated, thus we need to give it
+        // enough time before starting the paste process which creates another window
+        QTest::qWait(250);
+    }
+
+    // start the paste process
+    auto paste_process = std::make_unique<QProcess>();
+    QSignalSpy finishedSpy(
+        paste_process.get(),
+        static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished));
+    QVERIFY(finishedSpy.isValid());
+    environment.insert(QStringLiteral("QT_QPA_PLATFORM"), paste_platform);
+    paste_process->setProcessEnvironment(environment);
+    paste_process->setProcessChannelMode(QProcess::ForwardedChannels);
+    paste_process->setProgram(paste);
+    paste_process->setArguments(arguments);
+
+    QElapsedTimer paste_timer;
+    paste_timer.start();
+    paste_process->start();
+    QVERIFY(paste_process->waitForStarted());
+
+    std::optional<space::window_t> pasteClient;
+    if (paste_platform == QLatin1String("xcb")) {
+        QVERIFY(clientAddedSpy.wait());
+        auto paste_client_id = clientAddedSpy.last().first().value<quint32>();
+        pasteClient = setup.base->mod.space->windows_map.at(paste_client_id);
+    } else {
+        QVERIFY(shellClientAddedSpy.wait());
+        auto paste_client_id = shellClientAddedSpy.last().first().value<quint32>();
+        pasteClient = setup.base->mod.space->windows_map.at(paste_client_id);
+    }
+    QCOMPARE(clientAddedSpy.count(), 1);
+    QCOMPARE(shellClientAddedSpy.count(), 1);
+    QVERIFY(pasteClient);
+
+    if (setup.base->mod.space->stacking.active != pasteClient) {
+        QSignalSpy clientActivatedSpy(setup.base->mod.space->qobject.get(),
+                                      &space::qobject_t::clientActivated);
+        QVERIFY(clientActivatedSpy.isValid());
+        std::visit(overload{[&setup](auto&& win) {
+                       win::activate_window(*setup.base->mod.space, *win);
+                   }},
+                   *pasteClient);
+        QVERIFY(clientActivatedSpy.wait());
+    }
+    QTRY_COMPARE(setup.base->mod.space->stacking.active, pasteClient);
+    QVERIFY(finishedSpy.wait(60000));
+
+    copy_paste_result result;
+    result.exit_code = finishedSpy.first().first().toInt();
+    result.paste_time = std::chrono::milliseconds(paste_timer.elapsed());
+
+    copy_process->terminate();
+    QVERIFY(copy_process->waitForFinished());
+
+    return result;
+}
+
+}
+
 TEST_CASE("xwayland selections", "[win],[xwl]")
 {
     test::setup setup("xwayland-selections", base::operation_mode::xwayland);
@@ -27,146 +189,39 @@ TEST_CASE("xwayland selections", "[win],[xwl]")
 
     SECTION("sync")
     {
-        enum class sync_direction {
-            wayland_to_x11,
-            x11_to_wayland,
-        };
-
         auto clipboard_mode = GENERATE(as<std::string>{}, "Clipboard", "Selection");
         auto direction = GENERATE(sync_direction::wayland_to_x11, sync_direction::x11_to_wayland);
 
-        QString copy_platform = QStringLiteral("wayland");
-        QString paste_platform = QStringLiteral("xcb");
+        auto const result = copy_paste(setup, clipboard_mode, direction);
+        QCOMPARE(result.exit_code, 0);
+    }
+}
 
-        if (direction == sync_direction::x11_to_wayland) {
-            copy_platform = QStringLiteral("xcb");
-            paste_platform = QStringLiteral("wayland");
-        } else {
-            REQUIRE(direction == sync_direction::wayland_to_x11);
-        }
+TEST_CASE("xwayland selections throughput", "[win],[xwl],[!benchmark]")
+{
+    test::setup setup("xwayland-selections-throughput", base::operation_mode::xwayland);
+    setup.start();
+    setup.set_outputs(2);
+    test_outputs_default();
+    setup_wayland_connection();
+    xcb_connection_create();
 
-        // this test verifies the syncing of X11 to Wayland clipboard
-        QString const copy = QFINDTESTDATA(QStringLiteral("copy"));
-        QVERIFY(!copy.isEmpty());
-        const QString paste = QFINDTESTDATA(QStringLiteral("paste"));
-        QVERIFY(!paste.isEmpty());
-
-        QSignalSpy clientAddedSpy(setup.base->mod.space->qobject.get(),
-                                  &space::qobject_t::clientAdded);
-        QVERIFY(clientAddedSpy.isValid());
-        QSignalSpy shellClientAddedSpy(setup.base->mod.space->qobject.get(),
-                                       &space::qobject_t::wayland_window_added);
-        QVERIFY(shellClientAddedSpy.isValid());
-
-        QSignalSpy clipboardChangedSpy = [&setup, &clipboard_mode]() {
-            if (clipboard_mode == "Clipboard") {
-                return QSignalSpy(setup.base->server->seat(),
-                                  &Wrapland::Server::Seat::selectionChanged);
-            }
-            if (clipboard_mode == "Selection") {
-                return QSignalSpy(setup.base->server->seat(),
-                                  &Wrapland::Server::Seat::primarySelectionChanged);
-            }
-            std::terminate();
-        }();
-
-        QVERIFY(clipboardChangedSpy.isValid());
-
-        QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
-
-        // start the copy process
-        environment.insert(QStringLiteral("QT_QPA_PLATFORM"), copy_platform);
-        auto copy_process = new QProcess();
-        copy_process->setProcessEnvironment(environment);
-        copy_process->setProcessChannelMode(QProcess::ForwardedChannels);
-        copy_process->setProgram(copy);
-        copy_process->setArguments({QString::fromStdString(clipboard_mode)});
-        copy_process->start();
-        QVERIFY(copy_process->waitForStarted());
-
-        std::optional<space::window_t> copyClient;
-        if (copy_platform == QLatin1String("xcb")) {
-            QVERIFY(clientAddedSpy.wait());
-            auto copy_client_id = clientAddedSpy.first().first().value<quint32>();
-            copyClient = setup.base->mod.space->windows_map.at(copy_client_id);
-        } else {
-            QVERIFY(shellClientAddedSpy.wait());
-            auto copy_client_id = shellClientAddedSpy.first().first().value<quint32>();
-            copyClient = setup.base->mod.space->windows_map.at(copy_client_id);
-        }
-        QVERIFY(copyClient);
-        if (setup.base->mod.space->stacking.active != *copyClient) {
-            std::visit(overload{[&setup](auto&& win) {
-                           win::activate_window(*setup.base->mod.space, *win);
-                       }},
-                       *copyClient);
-        }
-        QCOMPARE(setup.base->mod.space->stacking.active, copyClient);
-        if (copy_platform == QLatin1String("xcb")) {
-            QVERIFY(clipboardChangedSpy.isEmpty());
-            QVERIFY(clipboardChangedSpy.wait());
-        } else {
-            // TODO: it would be better to be able to connect to a signal, instead of waiting
-            // the idea is to make sure that the clipboard is updated, thus we need to give it
-            // enough time before starting the paste process which creates another window
-            QTest::qWait(250);
-        }
+    auto direction = GENERATE(sync_direction::wayland_to_x11, sync_direction::x11_to_wayland);
 
-        // start the paste process
-        auto paste_process = new QProcess();
-        QSignalSpy finishedSpy(
-            paste_process,
-            static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished));
-        QVERIFY(finishedSpy.isValid());
-        environment.insert(QStringLiteral("QT_QPA_PLATFORM"), paste_platform);
-        paste_process->setProcessEnvironment(environment);
-        paste_process->setProcessChannelMode(QProcess::ForwardedChannels);
-        paste_process->setProgram(paste);
-        paste_process->setArguments({QString::fromStdString(clipboard_mode)});
-        paste_process->start();
-        QVERIFY(paste_process->waitForStarted());
-
-        std::optional<space::window_t> pasteClient;
-        if (paste_platform == QLatin1String("xcb")) {
-            QVERIFY(clientAddedSpy.wait());
-            auto paste_client_id = clientAddedSpy.last().first().value<quint32>();
-            pasteClient = setup.base->mod.space->windows_map.at(paste_client_id);
-        } else {
-            QVERIFY(shellClientAddedSpy.wait());
-            auto paste_client_id = shellClientAddedSpy.last().first().value<quint32>();
-            pasteClient = setup.base->mod.space->windows_map.at(paste_client_id);
-        }
-        QCOMPARE(clientAddedSpy.count(), 1);
-        QCOMPARE(shellClientAddedSpy.count(), 1);
-        QVERIFY(pasteClient);
-
-        if (setup.base->mod.space->stacking.active != pasteClient) {
-            QSignalSpy clientActivatedSpy(setup.base->mod.space->qobject.get(),
-                                          &space::qobject_t::clientActivated);
-            QVERIFY(clientActivatedSpy.isValid());
-            std::visit(overload{[&setup](auto&& win) {
-                           win::activate_window(*setup.base->mod.space, *win);
-                       }},
-                       *pasteClient);
-            QVERIFY(clientActivatedSpy.wait());
-        }
-        QTRY_COMPARE(setup.base->mod.space->stacking.active, pasteClient);
-        QVERIFY(finishedSpy.wait());
-        QCOMPARE(finishedSpy.first().first().toInt(), 0);
-        delete paste_process;
-        paste_process = nullptr;
-
-        if (copy_process) {
-            copy_process->terminate();
-            QVERIFY(copy_process->waitForFinished());
-            copy_process = nullptr;
-        }
-        if (paste_process) {
-            paste_process->terminate();
-            QVERIFY(paste_process->waitForFinished());
-            paste_process = nullptr;
-        }
-    }
+    // The paste helper exits successfully only once it received the whole text. Process startup
+    // and window activation are measured with the default text and subtracted.
+    constexpr int payload_size{32 * 1024 * 1024};
+    auto const baseline = copy_paste(setup, "Clipboard", direction);
+    QCOMPARE(baseline.exit_code, 0);
+    auto const large = copy_paste(setup, "Clipboard", direction, payload_size);
+    QCOMPARE(large.exit_code, 0);
+
+    auto const transfer_time = std::max(large.paste_time - baseline.paste_time,
+                                        std::chrono::milliseconds(1));
+    auto const mb_per_s = payload_size / 1024. / 1024. / (transfer_time.count() / 1000.);
+
+    qInfo() << (direction == sync_direction::wayland_to_x11 ? "Wayland to X11:" : "X11 to Wayland:")
+            << payload_size << "bytes in" << transfer_time.count() << "ms," << mb_per_s << "MB/s";
 }
 
 }
@@ -226,18 +226,34 @@ int main(int argc, char* argv[])
                                           : base::operation_mode::wayland,
     });
 
-    base.mod.render = std::make_unique<base_t::render_t>(base);
-
-    base.mod.input = std::make_unique<base_t::input_t>(base, input::config(KConfig::NoGlobals));
-    base.mod.input->mod.dbus
-        = std::make_unique<input::dbus::device_manager<base_t::input_t>>(*base.mod.input);
-
-    base.mod.space = std::make_unique<base_t::space_t>(*base.mod.render, *base.mod.input);
-    base.mod.space->mod.desktop
-        = std::make_unique<desktop::kde::platform<base_t::space_t>>(*base.mod.space);
-    win::init_shortcuts(*base.mod.space);
-    render::init_shortcuts(*base.mod.render);
-    base.mod.script = std::make_unique<scripting::platform<base_t::space_t>>(*base.mod.space);
+    {
+        base::startup_tracer::scope trace(
+            base.startup, QStringLiteral("render platform"), QStringLiteral("render"));
+        base.mod.render = std::make_unique<base_t::render_t>(base);
+    }
+    {
+        base::startup_tracer::scope trace(
+            base.startup, QStringLiteral("input platform"), QStringLiteral("input"));
+        base.mod.input
+            = std::make_unique<base_t::input_t>(base, input::config(KConfig::NoGlobals));
+        base.mod.input->mod.dbus
+            = std::make_unique<input::dbus::device_manager<base_t::input_t>>(*base.mod.input);
+    }
+    {
+        base::startup_tracer::scope trace(
+            base.startup, QStringLiteral("space"), QStringLiteral("win"));
+        base.mod.space = std::make_unique<base_t::space_t>(*base.mod.render, *base.mod.input);
+        base.mod.space->mod.desktop
+            = std::make_unique<desktop::kde::platform<base_t::space_t>>(*base.mod.space);
+        win::init_shortcuts(*base.mod.space);
+        render::init_shortcuts(*base.mod.render);
+    }
+    {
+        base::startup_tracer::scope trace(
+            base.startup, QStringLiteral("scripting"), QStringLiteral("script"));
+        base.mod.script
+            = std::make_unique<scripting::platform<base_t::space_t>>(*base.mod.space);
+    }
 
     base::wayland::platform_start(base);
 
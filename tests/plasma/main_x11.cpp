@@ -134,7 +134,11 @@ int main(int argc, char* argv[])
     base::x11::platform_init_crash_count(base, crash_count);
 
     auto handle_ownership_claimed = [&base] {
-        base.options = base::create_options(base::operation_mode::x11, base.config.main);
+        {
+            base::startup_tracer::scope trace(
+                base.startup, QStringLiteral("options"), QStringLiteral("base"));
+            base.options = base::create_options(base::operation_mode::x11, base.config.main);
+        }
 
         // Check  whether another windowmanager is running
         const uint32_t maskValues[] = {XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT};
@@ -157,31 +161,50 @@ int main(int argc, char* argv[])
         }
 
         base.session = std::make_unique<base::seat::backend::logind::session>();
-        base.mod.render = std::make_unique<render::backend::x11::platform<base_t>>(base);
-        base.mod.input = std::make_unique<input::x11::platform<base_t>>(base);
+        {
+            base::startup_tracer::scope trace(
+                base.startup, QStringLiteral("render platform"), QStringLiteral("render"));
+            base.mod.render = std::make_unique<render::backend::x11::platform<base_t>>(base);
+        }
+        {
+            base::startup_tracer::scope trace(
+                base.startup, QStringLiteral("input platform"), QStringLiteral("input"));
+            base.mod.input = std::make_unique<input::x11::platform<base_t>>(base);
+        }
 
         base.update_outputs();
         auto render = static_cast<render::backend::x11::platform<base_t>*>(base.mod.render.get());
         try {
+            base::startup_tracer::scope trace(
+                base.startup, QStringLiteral("render backend"), QStringLiteral("render"));
             render->init();
         } catch (std::exception const&) {
             std::cerr << "FATAL ERROR: backend failed to initialize, exiting now" << std::endl;
             ::exit(1);
         }
 
-        try {
-            base.mod.space = std::make_unique<base_t::space_t>(*base.mod.render, *base.mod.input);
-        } catch (std::exception& ex) {
-            qCCritical(KWIN_CORE) << "Abort since space creation fails with:" << ex.what();
-            exit(1);
-        }
-
-        base.mod.space->mod.desktop
-            = std::make_unique<desktop::kde::platform<base_t::space_t>>(*base.mod.space);
-        win::init_shortcuts(*base.mod.space);
-        render::init_shortcuts(*base.mod.render);
+        {
+            base::startup_tracer::scope trace(
+                base.startup, QStringLiteral("space"), QStringLiteral("win"));
+            try {
+                base.mod.space
+                    = std::make_unique<base_t::space_t>(*base.mod.render, *base.mod.input);
+            } catch (std::exception& ex) {
+                qCCritical(KWIN_CORE) << "Abort since space creation fails with:" << ex.what();
+                exit(1);
+            }
 
-        base.mod.script = std::make_unique<scripting::platform<base_t::space_t>>(*base.mod.space);
+            base.mod.space->mod.desktop
+                = std::make_unique<desktop::kde::platform<base_t::space_t>>(*base.mod.space);
+            win::init_shortcuts(*base.mod.space);
+            render::init_shortcuts(*base.mod.render);
+        }
+        {
+            base::startup_tracer::scope trace(
+                base.startup, QStringLiteral("scripting"), QStringLiteral("script"));
+            base.mod.script
+                = std::make_unique<scripting::platform<base_t::space_t>>(*base.mod.space);
+        }
         render->start(*base.mod.space);
 
         // Trigger possible errors, there's still a chance to abort.
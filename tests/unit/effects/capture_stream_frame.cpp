@@ -0,0 +1,165 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "plugins/effects/screenshot/capturestreamframe.h"
+
+#include <QColor>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+struct pipe_pair {
+    pipe_pair()
+    {
+        int fds[2];
+        REQUIRE(pipe2(fds, O_CLOEXEC) == 0);
+        read_fd = fds[0];
+        write_fd = fds[1];
+    }
+    ~pipe_pair()
+    {
+        close(read_fd);
+        if (write_fd >= 0) {
+            close(write_fd);
+        }
+    }
+
+    void close_write()
+    {
+        close(write_fd);
+        write_fd = -1;
+    }
+
+    int read_fd;
+    int write_fd;
+};
+
+void write_all(int fd, std::vector<uint8_t> const& data)
+{
+    size_t written{0};
+    while (written < data.size()) {
+        auto const count = ::write(fd, data.data() + written, data.size() - written);
+        REQUIRE(count > 0);
+        written += count;
+    }
+}
+
+QImage make_image(QSize const& size, QColor const& color)
+{
+    QImage image(size, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+}
+
+TEST_CASE("capture stream frame", "[effect],[unit]")
+{
+    pipe_pair pipe;
+
+    SECTION("round trip")
+    {
+        capture::frame_header header;
+        header.sequence = 7;
+        header.timestamp_us = 123456;
+        header.width = 64;
+        header.height = 32;
+        header.cursor_x = 5;
+        header.cursor_y = 6;
+        header.cursor_flags = capture::cursor_visible | capture::cursor_image_changed;
+
+        auto image = make_image({64, 32}, Qt::red);
+        image.setPixelColor(10, 12, Qt::green);
+        auto const cursor = make_image({4, 4}, Qt::blue);
+
+        std::vector<capture::frame_rect> rects{{8, 10, 4, 4}, {60, 30, 10, 10}};
+        auto const data = capture::encode_frame(header, image, {}, rects, cursor);
+
+        std::thread writer([&] { write_all(pipe.write_fd, data); });
+        auto frm = capture::read_frame(pipe.read_fd);
+        writer.join();
+
+        REQUIRE(frm);
+        REQUIRE(frm->header.sequence == 7);
+        REQUIRE(frm->header.timestamp_us == 123456);
+        REQUIRE(frm->header.width == 64);
+        REQUIRE(frm->header.height == 32);
+        REQUIRE(frm->header.format == QImage::Format_ARGB32);
+        REQUIRE(frm->header.cursor_x == 5);
+        REQUIRE(frm->header.cursor_y == 6);
+
+        // The second rect is clipped to the image.
+        REQUIRE(frm->rects.size() == 2);
+        REQUIRE(frm->rects[1].x == 60);
+        REQUIRE(frm->rects[1].y == 30);
+        REQUIRE(frm->rects[1].width == 4);
+        REQUIRE(frm->rects[1].height == 2);
+        REQUIRE(frm->pixels.size() == (4 * 4 + 4 * 2) * 4);
+
+        QImage target;
+        capture::apply_frame(target, *frm);
+        REQUIRE(target.size() == QSize(64, 32));
+        REQUIRE(target.pixelColor(10, 12) == QColor(Qt::green));
+        REQUIRE(target.pixelColor(8, 10) == QColor(Qt::red));
+        REQUIRE(target.pixelColor(62, 31) == QColor(Qt::red));
+
+        // Pixels outside the damage are untouched.
+        REQUIRE(target.pixelColor(0, 0) == QColor(Qt::transparent));
+
+        REQUIRE(frm->cursor.size() == QSize(4, 4));
+        REQUIRE(frm->cursor.pixelColor(1, 1) == QColor(Qt::blue));
+    }
+
+    SECTION("partial snapshot with offset")
+    {
+        capture::frame_header header;
+        header.width = 100;
+        header.height = 100;
+
+        auto const image = make_image({20, 20}, Qt::yellow);
+        std::vector<capture::frame_rect> rects{{45, 45, 10, 10}, {0, 0, 5, 5}};
+        auto const data = capture::encode_frame(header, image, {40, 40}, rects, {});
+
+        std::thread writer([&] { write_all(pipe.write_fd, data); });
+        auto frm = capture::read_frame(pipe.read_fd);
+        writer.join();
+
+        REQUIRE(frm);
+        REQUIRE(frm->rects.size() == 1);
+        REQUIRE(frm->rects[0].x == 45);
+        REQUIRE(frm->rects[0].y == 45);
+        REQUIRE(frm->cursor.isNull());
+
+        QImage target;
+        capture::apply_frame(target, *frm);
+        REQUIRE(target.pixelColor(50, 50) == QColor(Qt::yellow));
+        REQUIRE(target.pixelColor(44, 44) == QColor(Qt::transparent));
+    }
+
+    SECTION("end of stream")
+    {
+        pipe.close_write();
+        REQUIRE(!capture::read_frame(pipe.read_fd));
+    }
+
+    SECTION("bad magic")
+    {
+        capture::frame_header header;
+        header.magic = 0;
+        auto const data = capture::encode_frame(header, {}, {}, {}, {});
+        write_all(pipe.write_fd, data);
+        REQUIRE(!capture::read_frame(pipe.read_fd));
+    }
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/render/effect/interface/window_data.h"
+
+namespace como::detail::test
+{
+
+TEST_CASE("window data", "[effect],[unit]")
+{
+    effect::window_data_store store;
+
+    SECTION("typed slots")
+    {
+        REQUIRE(!store.get(effect::window_data::force_blur));
+
+        store.set(effect::window_data::force_blur, true);
+        REQUIRE(store.get(effect::window_data::force_blur));
+        REQUIRE(*store.get(effect::window_data::force_blur));
+        REQUIRE(!store.get(effect::window_data::force_background_contrast));
+
+        store.reset(WindowForceBlurRole);
+        REQUIRE(!store.get(effect::window_data::force_blur));
+    }
+
+    SECTION("variant compatibility")
+    {
+        int grabber{0};
+        store.set_variant(WindowClosedGrabRole, QVariant::fromValue(static_cast<void*>(&grabber)));
+
+        auto grab = store.get(effect::window_data::closed_grab);
+        REQUIRE(grab);
+        REQUIRE(*grab == &grabber);
+        REQUIRE(store.variant(WindowClosedGrabRole).value<void*>() == &grabber);
+
+        store.set(effect::window_data::force_background_contrast, true);
+        REQUIRE(store.variant(WindowForceBackgroundContrastRole).toBool());
+
+        store.set_variant(WindowClosedGrabRole, QVariant());
+        REQUIRE(!store.get(effect::window_data::closed_grab));
+        REQUIRE(!store.variant(WindowClosedGrabRole).isValid());
+    }
+
+    SECTION("custom roles")
+    {
+        constexpr int role{1000};
+        store.set_variant(role, QStringLiteral("value"));
+        REQUIRE(store.variant(role).toString() == QStringLiteral("value"));
+
+        store.reset(role);
+        REQUIRE(!store.variant(role).isValid());
+    }
+
+    SECTION("registered slots")
+    {
+        auto const slot = effect::register_window_data_slot<int>();
+        auto const other = effect::register_window_data_slot<int>();
+        REQUIRE(slot.role >= effect::window_data_registered_role_start);
+        REQUIRE(slot.role != other.role);
+
+        store.set(slot, 42);
+        REQUIRE(*store.get(slot) == 42);
+        REQUIRE(!store.get(other));
+        REQUIRE(!store.variant(slot.role).isValid());
+    }
+}
+
+}
@@ -0,0 +1,130 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "plugins/effects/wobblywindows/wobbly_grid.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <string>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+wobbly::parameters const params{
+    .stiffness = 0.15,
+    .drag = 0.80,
+    .move_factor = 0.10,
+    .min_velocity = 0.0,
+    .max_velocity = 1000.0,
+    .min_acceleration = 0.0,
+    .max_acceleration = 1000.0,
+};
+
+}
+
+TEST_CASE("wobbly grid", "[effect],[unit]")
+{
+    QRectF const geometry(100, 50, 600, 400);
+
+    SECTION("rest state")
+    {
+        auto side = GENERATE(2, 4, 8);
+
+        wobbly::grid grid(side, side);
+        grid.reset(geometry);
+
+        auto const res = grid.step(params, 10);
+        REQUIRE_THAT(res.acceleration_sum, Catch::Matchers::WithinAbs(0., 1e-9));
+        REQUIRE_THAT(res.velocity_sum, Catch::Matchers::WithinAbs(0., 1e-9));
+
+        for (size_t i = 0; i < grid.count; ++i) {
+            REQUIRE_THAT(grid.position_x[i], Catch::Matchers::WithinAbs(grid.origin_x[i], 1e-9));
+            REQUIRE_THAT(grid.position_y[i], Catch::Matchers::WithinAbs(grid.origin_y[i], 1e-9));
+        }
+    }
+
+    SECTION("converges after move")
+    {
+        wobbly::grid grid(4, 4);
+        grid.reset(geometry);
+
+        // Like the picked point on a window move.
+        grid.constraint[0] = true;
+        grid.set_origin(geometry.translated(50, -30));
+
+        wobbly::step_result res;
+        for (int i = 0; i < 2000; ++i) {
+            res = grid.step(params, 10);
+        }
+
+        REQUIRE(res.acceleration_sum < 0.5);
+        REQUIRE(res.velocity_sum < 0.5);
+
+        for (size_t i = 0; i < grid.count; ++i) {
+            REQUIRE_THAT(grid.position_x[i], Catch::Matchers::WithinAbs(grid.origin_x[i], 1e-6));
+            REQUIRE_THAT(grid.position_y[i], Catch::Matchers::WithinAbs(grid.origin_y[i], 1e-6));
+        }
+    }
+
+    SECTION("pinned edges")
+    {
+        wobbly::grid grid(4, 4);
+        grid.reset(geometry);
+        grid.can_wobble = {false, false, false, false};
+        grid.set_origin(geometry.translated(50, -30));
+
+        grid.step(params, 10);
+
+        for (size_t i = 0; i < grid.count; ++i) {
+            REQUIRE(grid.position_x[i] == grid.origin_x[i]);
+            REQUIRE(grid.position_y[i] == grid.origin_y[i]);
+        }
+    }
+
+    SECTION("bezier corners")
+    {
+        wobbly::grid grid(4, 4);
+        grid.reset(geometry);
+
+        std::vector<double> const u{0., 1., 0., 1., 0.5};
+        std::vector<double> const v{0., 0., 1., 1., 0.5};
+        std::vector<double> x(u.size());
+        std::vector<double> y(u.size());
+
+        grid.map_bezier(u, v, x, y);
+
+        for (size_t i = 0; i < u.size(); ++i) {
+            REQUIRE_THAT(x[i],
+                         Catch::Matchers::WithinAbs(geometry.x() + u[i] * geometry.width(), 1e-9));
+            REQUIRE_THAT(y[i],
+                         Catch::Matchers::WithinAbs(geometry.y() + v[i] * geometry.height(), 1e-9));
+        }
+    }
+}
+
+TEST_CASE("wobbly grid benchmark", "[effect],[unit],[!benchmark]")
+{
+    QRectF const geometry(100, 50, 600, 400);
+
+    auto side = GENERATE(4, 16, 64);
+
+    wobbly::grid grid(side, side);
+    grid.reset(geometry);
+    grid.constraint[0] = true;
+    grid.set_origin(geometry.translated(50, -30));
+
+    BENCHMARK("step " + std::to_string(side * side) + " points")
+    {
+        return grid.step(params, 10);
+    };
+}
+
+}
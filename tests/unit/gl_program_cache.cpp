@@ -0,0 +1,56 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/render/gl/interface/program_cache.h"
+
+#include <QTemporaryDir>
+
+namespace como::detail::test
+{
+
+TEST_CASE("gl program cache", "[unit]")
+{
+    SECTION("key")
+    {
+        auto const key = GLProgramCache::key("vertex", "fragment", "position texcoord");
+
+        REQUIRE(key == GLProgramCache::key("vertex", "fragment", "position texcoord"));
+        REQUIRE(key != GLProgramCache::key("vertex", "fragment", "vertex texCoord"));
+        REQUIRE(key != GLProgramCache::key("vertex2", "fragment", "position texcoord"));
+        REQUIRE(key != GLProgramCache::key("vertex", "fragment2", "position texcoord"));
+
+        // Sources are separated so moving text between them changes the key.
+        REQUIRE(GLProgramCache::key("ab", "c", "") != GLProgramCache::key("a", "bc", ""));
+    }
+
+    SECTION("saved time")
+    {
+        using namespace std::chrono_literals;
+
+        GLProgramCacheStats stats;
+        REQUIRE(stats.saved_time() == 0ns);
+
+        stats.misses = 2;
+        stats.compile_time = 40ms;
+        stats.hits = 3;
+        stats.load_time = 6ms;
+        REQUIRE(stats.saved_time() == 54ms);
+    }
+
+    SECTION("missing binary")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        GLProgramCache cache(dir.path());
+        REQUIRE(!cache.load(0, GLProgramCache::key("vertex", "fragment", {})));
+        REQUIRE(cache.stats().hits == 0);
+        REQUIRE(cache.stats().rejected == 0);
+    }
+}
+
+}
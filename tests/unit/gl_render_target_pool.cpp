@@ -0,0 +1,48 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/render/gl/interface/render_target_pool.h"
+
+namespace como::detail::test
+{
+
+TEST_CASE("gl render target pool", "[unit]")
+{
+    SECTION("size class")
+    {
+        // Small sizes are rounded up to multiples of 32.
+        REQUIRE(GLRenderTargetPool::sizeClass({1, 32}) == QSize(32, 32));
+        REQUIRE(GLRenderTargetPool::sizeClass({33, 100}) == QSize(64, 128));
+
+        // Larger ones in eighths of the enclosing power of two.
+        REQUIRE(GLRenderTargetPool::sizeClass({700, 513}) == QSize(768, 640));
+        REQUIRE(GLRenderTargetPool::sizeClass({1920, 1080}) == QSize(2048, 1280));
+
+        // Sizes of a class map to themselves.
+        REQUIRE(GLRenderTargetPool::sizeClass({768, 1280}) == QSize(768, 1280));
+    }
+
+    SECTION("resize steps share a class")
+    {
+        // Growing a window by a few pixels per step mostly stays in one class.
+        auto const first = GLRenderTargetPool::sizeClass({400, 300});
+        int changes{0};
+        auto current = first;
+
+        for (int step = 0; step < 64; step++) {
+            auto const next = GLRenderTargetPool::sizeClass({400 + step, 300 + step});
+            if (next != current) {
+                changes++;
+                current = next;
+            }
+        }
+
+        REQUIRE(changes <= 2);
+    }
+}
+
+}
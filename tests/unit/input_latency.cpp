@@ -0,0 +1,222 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/render/wayland/input_latency.h"
+
+namespace como::detail::test
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// Records an input with a kernel timestamp of @a event that is processed for 100 µs from @a begin.
+void add_input(base::wayland::input_latency_tracker& tracker,
+               std::chrono::milliseconds event,
+               std::chrono::nanoseconds begin)
+{
+    tracker.add(static_cast<uint32_t>(event.count()), begin, begin + 100us);
+}
+
+}
+
+TEST_CASE("input latency histogram", "[render],[unit]")
+{
+    render::wayland::latency_histogram histogram;
+
+    SECTION("buckets")
+    {
+        histogram.add(400us);
+        histogram.add(500us);
+        histogram.add(501us);
+        histogram.add(16700us);
+        histogram.add(16701us);
+
+        // Bounds are inclusive.
+        REQUIRE(histogram.counts[0] == 2);
+        REQUIRE(histogram.counts[1] == 1);
+        REQUIRE(histogram.counts[7] == 1);
+        REQUIRE(histogram.counts[8] == 1);
+        REQUIRE(histogram.count == 5);
+        REQUIRE(histogram.max == 16701us);
+
+        // Negative durations from clock differences count as zero.
+        histogram.add(-3ms);
+        REQUIRE(histogram.counts[0] == 3);
+        REQUIRE(histogram.sum == 400us + 500us + 501us + 16700us + 16701us);
+    }
+
+    SECTION("overflow")
+    {
+        histogram.add(100ms);
+        histogram.add(250ms);
+
+        auto const last = render::wayland::latency_histogram::bounds_us.size();
+        REQUIRE(histogram.counts[last - 1] == 1);
+        REQUIRE(histogram.counts[last] == 1);
+        REQUIRE(histogram.max == 250ms);
+
+        auto const json = histogram.to_json();
+        auto const buckets = json.value(QStringLiteral("buckets")).toArray();
+        REQUIRE(buckets.size() == static_cast<qsizetype>(last + 1));
+        REQUIRE(!buckets.last().toObject().contains(QStringLiteral("le_us")));
+        REQUIRE(buckets.last().toObject().value(QStringLiteral("count")).toInteger() == 1);
+    }
+
+    SECTION("percentiles")
+    {
+        REQUIRE(histogram.percentile(0.5) == 0us);
+
+        for (int i = 0; i < 9; i++) {
+            histogram.add(1ms);
+        }
+        histogram.add(30ms);
+
+        // The upper bound of the bucket the ranked duration is in.
+        REQUIRE(histogram.percentile(0.5) == 1000us);
+        REQUIRE(histogram.percentile(0.9) == 1000us);
+        REQUIRE(histogram.percentile(0.99) == 33400us);
+
+        // Durations above the last bound report the maximum.
+        histogram.add(300ms);
+        REQUIRE(histogram.percentile(0.99) == 300ms);
+
+        auto const json = histogram.to_json();
+        REQUIRE(json.value(QStringLiteral("p50_us")).toInteger() == 1000);
+        REQUIRE(json.value(QStringLiteral("p99_us")).toInteger() == 300000);
+    }
+}
+
+TEST_CASE("input latency tracker", "[render],[unit]")
+{
+    base::wayland::input_latency_tracker tracker;
+
+    SECTION("earliest input")
+    {
+        add_input(tracker, 10010ms, 10020ms);
+        add_input(tracker, 10005ms, 10021ms);
+        auto const id = tracker.last_id();
+        add_input(tracker, 10015ms, 10022ms);
+
+        auto input = tracker.earliest_since(0);
+        REQUIRE(input);
+        REQUIRE(input->event == 10005ms);
+        REQUIRE(input->process_begin == 10021ms);
+        REQUIRE(input->process_end == 10021ms + 100us);
+
+        input = tracker.earliest_since(id);
+        REQUIRE(input);
+        REQUIRE(input->event == 10015ms);
+
+        REQUIRE(!tracker.earliest_since(tracker.last_id()));
+    }
+
+    SECTION("timestamp wraparound")
+    {
+        // Millisecond timestamps wrap after 2^32 ms.
+        auto const wrap = std::chrono::milliseconds(uint64_t(1) << 32);
+        add_input(tracker, 40ms, wrap + 50ms);
+
+        auto const input = tracker.earliest_since(0);
+        REQUIRE(input);
+        REQUIRE(input->event == wrap + 40ms);
+    }
+
+    SECTION("dropped inputs")
+    {
+        // Timestamps that are not recent are not from the kernel and are ignored.
+        add_input(tracker, 0ms, 100s);
+        REQUIRE(tracker.last_id() == 0);
+        REQUIRE(!tracker.earliest_since(0));
+
+        // Only the latest 512 inputs are kept.
+        for (int i = 0; i < 600; i++) {
+            add_input(tracker, 1000ms + std::chrono::milliseconds(i), 2000ms);
+        }
+        REQUIRE(tracker.last_id() == 600);
+
+        auto const input = tracker.earliest_since(0);
+        REQUIRE(input);
+        REQUIRE(input->event == 1088ms);
+    }
+}
+
+TEST_CASE("input latency matcher", "[render],[unit]")
+{
+    base::wayland::input_latency_tracker tracker;
+    render::wayland::input_latency_matcher matcher;
+    render::wayland::input_latency_stats stats;
+
+    SECTION("presented frame")
+    {
+        add_input(tracker, 1000ms, 1002ms);
+        matcher.submitted(tracker, 1005ms, 1008ms);
+        matcher.presented(1016ms, stats);
+
+        REQUIRE(stats.total.count == 1);
+        REQUIRE(stats.total.sum == 16ms);
+        REQUIRE(stats.queue.sum == 2ms);
+        REQUIRE(stats.processing.sum == 100us);
+        REQUIRE(stats.wait.sum == 3ms - 100us);
+        REQUIRE(stats.paint.sum == 3ms);
+        REQUIRE(stats.scanout.sum == 8ms);
+
+        // The input was shown, the next frame has no input to match.
+        matcher.submitted(tracker, 1020ms, 1022ms);
+        matcher.presented(1032ms, stats);
+        REQUIRE(stats.total.count == 1);
+    }
+
+    SECTION("earliest input of a frame")
+    {
+        add_input(tracker, 1004ms, 1005ms);
+        add_input(tracker, 1001ms, 1006ms);
+        matcher.submitted(tracker, 1010ms, 1012ms);
+        matcher.presented(1020ms, stats);
+
+        REQUIRE(stats.total.count == 1);
+        REQUIRE(stats.total.sum == 19ms);
+    }
+
+    SECTION("unmatched")
+    {
+        // Presentations without submitted input record nothing.
+        matcher.presented(1000ms, stats);
+        matcher.submitted(tracker, 1010ms, 1012ms);
+        matcher.presented(1020ms, stats);
+        REQUIRE(stats.total.count == 0);
+
+        // Input after the frame was submitted is not part of it.
+        add_input(tracker, 1021ms, 1022ms);
+        matcher.presented(1030ms, stats);
+        REQUIRE(stats.total.count == 0);
+
+        matcher.submitted(tracker, 1030ms, 1032ms);
+        matcher.presented(1040ms, stats);
+        REQUIRE(stats.total.count == 1);
+        REQUIRE(stats.total.sum == 19ms);
+    }
+
+    SECTION("dropped frame")
+    {
+        // A frame is submitted but replaced before it is presented.
+        add_input(tracker, 1000ms, 1001ms);
+        matcher.submitted(tracker, 1002ms, 1004ms);
+        add_input(tracker, 1010ms, 1011ms);
+        matcher.submitted(tracker, 1012ms, 1014ms);
+        matcher.presented(1020ms, stats);
+
+        // The input of the dropped frame is shown with the next one.
+        REQUIRE(stats.total.count == 1);
+        REQUIRE(stats.total.sum == 20ms);
+        REQUIRE(stats.paint.sum == 2ms);
+        REQUIRE(stats.scanout.sum == 6ms);
+    }
+}
+
+}
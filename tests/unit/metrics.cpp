@@ -0,0 +1,123 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/debug/perf/metrics.h"
+
+#include <QByteArrayList>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+bool has_line(QByteArray const& text, QByteArray const& line)
+{
+    return text.split('\n').contains(line);
+}
+
+}
+
+TEST_CASE("metrics", "[debug],[unit]")
+{
+    // The registry is process wide, so every section uses its own metric names.
+    auto& registry = debug::metrics_registry::instance();
+
+    SECTION("counter")
+    {
+        auto& counter = registry.counter(QStringLiteral("test_counter_total"),
+                                         QStringLiteral("Test counter."),
+                                         {{QStringLiteral("output"), QStringLiteral("A-1")}});
+        counter.add();
+        counter.add(2);
+        REQUIRE(counter.value() == 3);
+
+        // Same name and labels give the same counter.
+        auto& same = registry.counter(QStringLiteral("test_counter_total"),
+                                      QStringLiteral("Test counter."),
+                                      {{QStringLiteral("output"), QStringLiteral("A-1")}});
+        REQUIRE(&same == &counter);
+
+        auto& other = registry.counter(QStringLiteral("test_counter_total"),
+                                       QStringLiteral("Test counter."),
+                                       {{QStringLiteral("output"), QStringLiteral("B-1")}});
+        REQUIRE(&other != &counter);
+
+        auto const text = registry.prometheus();
+        REQUIRE(has_line(text, "# HELP test_counter_total Test counter."));
+        REQUIRE(has_line(text, "# TYPE test_counter_total counter"));
+        REQUIRE(has_line(text, "test_counter_total{output=\"A-1\"} 3"));
+        REQUIRE(has_line(text, "test_counter_total{output=\"B-1\"} 0"));
+    }
+
+    SECTION("gauge")
+    {
+        auto& gauge = registry.gauge(QStringLiteral("test_gauge"), QStringLiteral("Test gauge."));
+        gauge.set(5);
+        gauge.add(-1.5);
+
+        auto const text = registry.prometheus();
+        REQUIRE(has_line(text, "# TYPE test_gauge gauge"));
+        REQUIRE(has_line(text, "test_gauge 3.5"));
+    }
+
+    SECTION("histogram")
+    {
+        auto& histogram = registry.histogram(
+            QStringLiteral("test_duration_seconds"), QStringLiteral("Test histogram."), {0.1, 1});
+        histogram.observe(0.05);
+        histogram.observe(0.1);
+        histogram.observe(std::chrono::milliseconds(500));
+        histogram.observe(2.);
+
+        auto const text = registry.prometheus();
+        REQUIRE(has_line(text, "# TYPE test_duration_seconds histogram"));
+
+        // Buckets are cumulative and include their upper bound.
+        REQUIRE(has_line(text, "test_duration_seconds_bucket{le=\"0.1\"} 2"));
+        REQUIRE(has_line(text, "test_duration_seconds_bucket{le=\"1\"} 3"));
+        REQUIRE(has_line(text, "test_duration_seconds_bucket{le=\"+Inf\"} 4"));
+        REQUIRE(has_line(text, "test_duration_seconds_sum 2.65"));
+        REQUIRE(has_line(text, "test_duration_seconds_count 4"));
+    }
+
+    SECTION("remove")
+    {
+        debug::metric_labels const removed{{QStringLiteral("output"), QStringLiteral("R-1")}};
+        debug::metric_labels const kept{{QStringLiteral("output"), QStringLiteral("R-2")}};
+
+        registry.counter(QStringLiteral("test_removed_total"), QStringLiteral("Test."), removed)
+            .add();
+        registry.counter(QStringLiteral("test_removed_total"), QStringLiteral("Test."), kept).add();
+        registry.gauge(QStringLiteral("test_removed"), QStringLiteral("Test."), removed).set(1);
+
+        registry.remove(removed);
+
+        auto const text = registry.prometheus();
+        REQUIRE(!has_line(text, "test_removed_total{output=\"R-1\"} 1"));
+        REQUIRE(has_line(text, "test_removed_total{output=\"R-2\"} 1"));
+
+        // Families without series are not exposed.
+        REQUIRE(!text.contains("# TYPE test_removed gauge"));
+
+        // The series is created anew on the next request.
+        auto& counter = registry.counter(
+            QStringLiteral("test_removed_total"), QStringLiteral("Test."), removed);
+        REQUIRE(counter.value() == 0);
+    }
+
+    SECTION("label escaping")
+    {
+        registry.counter(QStringLiteral("test_escaped_total"),
+                         QStringLiteral("Test escaping."),
+                         {{QStringLiteral("name"), QStringLiteral("a\"b\\c")}});
+
+        REQUIRE(has_line(registry.prometheus(), "test_escaped_total{name=\"a\\\"b\\\\c\"} 0"));
+    }
+}
+
+}
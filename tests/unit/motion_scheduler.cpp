@@ -0,0 +1,124 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/input/wayland/motion_scheduler.h"
+
+#include <vector>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+struct mock_device {
+    mock_device()
+        : motions{*this}
+    {
+    }
+
+    std::chrono::milliseconds frame_interval() const
+    {
+        return std::chrono::milliseconds(16);
+    }
+
+    void process_motion(input::motion_event const& event)
+    {
+        relative.push_back(event);
+    }
+
+    void process_motion_absolute(input::motion_absolute_event const& event)
+    {
+        absolute.push_back(event);
+    }
+
+    std::vector<input::motion_event> relative;
+    std::vector<input::motion_absolute_event> absolute;
+    input::wayland::motion_scheduler<mock_device> motions;
+};
+
+}
+
+TEST_CASE("motion scheduler", "[input],[unit]")
+{
+    mock_device device;
+    auto& motions = device.motions;
+
+    SECTION("disabled")
+    {
+        REQUIRE(!motions.coalesce(input::motion_event{{1, 1}, {1, 1}, {nullptr, 1}}));
+        REQUIRE(!motions.coalesce(input::motion_absolute_event{{0.5, 0.5}, {nullptr, 1}}));
+    }
+
+    SECTION("relative")
+    {
+        motions.set_coalescing(true);
+
+        REQUIRE(motions.coalesce(input::motion_event{{1, 2}, {2, 4}, {nullptr, 1}}));
+        REQUIRE(motions.coalesce(input::motion_event{{3, 4}, {6, 8}, {nullptr, 2}}));
+        REQUIRE(device.relative.empty());
+
+        motions.flush();
+        REQUIRE(device.relative.size() == 1);
+
+        auto const& event = device.relative.front();
+        REQUIRE(event.delta == QPointF(4, 6));
+        REQUIRE(event.unaccel_delta == QPointF(8, 12));
+        REQUIRE(event.base.time_msec == 2);
+
+        // The individual motions are retained for relative pointer clients.
+        REQUIRE(event.samples.size() == 2);
+        REQUIRE(event.samples.at(0).unaccel_delta == QPointF(2, 4));
+        REQUIRE(event.samples.at(0).time_msec == 1);
+        REQUIRE(event.samples.at(1).unaccel_delta == QPointF(6, 8));
+        REQUIRE(event.samples.at(1).time_msec == 2);
+
+        motions.flush();
+        REQUIRE(device.relative.size() == 1);
+    }
+
+    SECTION("single relative")
+    {
+        motions.set_coalescing(true);
+
+        REQUIRE(motions.coalesce(input::motion_event{{1, 2}, {2, 4}, {nullptr, 1}}));
+        motions.flush();
+
+        REQUIRE(device.relative.size() == 1);
+        REQUIRE(device.relative.front().samples.empty());
+    }
+
+    SECTION("absolute")
+    {
+        motions.set_coalescing(true);
+
+        REQUIRE(motions.coalesce(input::motion_absolute_event{{0.1, 0.1}, {nullptr, 1}}));
+        REQUIRE(motions.coalesce(input::motion_absolute_event{{0.2, 0.3}, {nullptr, 2}}));
+        motions.flush();
+
+        REQUIRE(device.absolute.size() == 1);
+        REQUIRE(device.absolute.front().pos == QPointF(0.2, 0.3));
+        REQUIRE(device.absolute.front().base.time_msec == 2);
+    }
+
+    SECTION("order")
+    {
+        motions.set_coalescing(true);
+
+        // Switching between relative and absolute motions flushes.
+        REQUIRE(motions.coalesce(input::motion_event{{1, 2}, {1, 2}, {nullptr, 1}}));
+        REQUIRE(motions.coalesce(input::motion_absolute_event{{0.2, 0.3}, {nullptr, 2}}));
+        REQUIRE(device.relative.size() == 1);
+        REQUIRE(device.absolute.empty());
+
+        motions.set_coalescing(false);
+        REQUIRE(device.absolute.size() == 1);
+        REQUIRE(!motions.coalesce(input::motion_event{{1, 2}, {1, 2}, {nullptr, 3}}));
+    }
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/render/post/night_color_ramps.h"
+
+namespace como::detail::test
+{
+
+TEST_CASE("night color ramps", "[render],[unit]")
+{
+    SECTION("day temperature is linear")
+    {
+        auto const ramp = render::post::create_night_color_ramp(6500, 256);
+        REQUIRE(ramp.size() == 256);
+
+        for (uint32_t i = 0; i < 256; i++) {
+            REQUIRE(ramp.red()[i] == i * 256);
+            REQUIRE(ramp.green()[i] == i * 256);
+            REQUIRE(ramp.blue()[i] == i * 256);
+        }
+    }
+
+    SECTION("minimum temperature has no blue")
+    {
+        auto const ramp = render::post::create_night_color_ramp(1000, 256);
+
+        for (uint32_t i = 0; i < 256; i++) {
+            REQUIRE(ramp.red()[i] == i * 256);
+            REQUIRE(ramp.green()[i] < ramp.red()[i] || i == 0);
+            REQUIRE(ramp.blue()[i] == 0);
+        }
+    }
+
+    SECTION("cache")
+    {
+        render::post::night_color_ramps ramps;
+
+        auto const& ramp = ramps.get(4500, 256);
+        REQUIRE(ramp == render::post::create_night_color_ramp(4500, 256));
+        REQUIRE(&ramps.get(4500, 256) == &ramp);
+
+        REQUIRE(ramps.get(4500, 1024).size() == 1024);
+        REQUIRE(ramps.get(4550, 256) != ramp);
+    }
+}
+
+}
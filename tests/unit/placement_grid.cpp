@@ -0,0 +1,177 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/win/placement_grid.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <random>
+#include <string>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+using rect = win::placement_grid::rect;
+
+// References to compare the grid with.
+long int overlap_linear(std::vector<rect> const& rects, int left, int top, int right, int bottom)
+{
+    long int overlap = 0;
+    for (auto const& rect : rects) {
+        if (left < rect.right && right > rect.left && top < rect.bottom && bottom > rect.top) {
+            overlap += rect.weight * (std::min(right, rect.right) - std::max(left, rect.left))
+                * (std::min(bottom, rect.bottom) - std::max(top, rect.top));
+        }
+    }
+    return overlap;
+}
+
+int next_row_linear(std::vector<rect> const& rects, int y, int height, int possible)
+{
+    for (auto const& rect : rects) {
+        if (rect.bottom > y && possible > rect.bottom) {
+            possible = rect.bottom;
+        }
+        if (rect.top - height > y && possible > rect.top - height) {
+            possible = rect.top - height;
+        }
+    }
+    return possible;
+}
+
+int next_column_linear(std::vector<rect> const& rects,
+                       int x,
+                       int y,
+                       int width,
+                       int height,
+                       int possible)
+{
+    for (auto const& rect : rects) {
+        if (y < rect.bottom && rect.top < height + y) {
+            if (rect.right > x && possible > rect.right) {
+                possible = rect.right;
+            }
+            if (rect.left - width > x && possible > rect.left - width) {
+                possible = rect.left - width;
+            }
+        }
+    }
+    return possible;
+}
+
+std::vector<rect> random_rects(int count)
+{
+    std::mt19937 gen(count);
+    std::uniform_int_distribution<> pos(0, 3840);
+    std::uniform_int_distribution<> size(100, 1200);
+    std::uniform_int_distribution<> weight(0, 2);
+
+    std::vector<rect> rects;
+    for (int i = 0; i < count; ++i) {
+        auto const x = pos(gen);
+        auto const y = pos(gen);
+        auto const w = weight(gen);
+        rects.push_back({x, y, x + size(gen), y + size(gen), w == 2 ? 16 : w});
+    }
+    return rects;
+}
+
+}
+
+TEST_CASE("placement grid", "[win],[unit]")
+{
+    SECTION("empty")
+    {
+        win::placement_grid grid({});
+        REQUIRE(grid.overlap(0, 0, 100, 100) == 0);
+        REQUIRE(grid.next_row(0, 100, 500) == 500);
+        REQUIRE(grid.next_column(0, 0, 100, 100, 500) == 500);
+    }
+
+    SECTION("weighted overlap")
+    {
+        win::placement_grid grid({{0, 0, 100, 100, 1}, {50, 50, 150, 150, 16}, {0, 0, 10, 10, 0}});
+
+        REQUIRE(grid.overlap(0, 0, 50, 50) == 2500);
+        REQUIRE(grid.overlap(50, 50, 100, 100) == 2500 * 17);
+        REQUIRE(grid.overlap(100, 100, 200, 200) == 2500 * 16);
+        REQUIRE(grid.overlap(-100, -100, 0, 0) == 0);
+        REQUIRE(grid.overlap(150, 0, 300, 300) == 0);
+    }
+
+    SECTION("next positions")
+    {
+        win::placement_grid grid({{0, 0, 100, 100, 1}, {300, 0, 400, 100, 0}});
+
+        // After the right edge of the first window.
+        REQUIRE(grid.next_column(0, 0, 50, 50, 1000) == 100);
+
+        // Before the left edge of the second window.
+        REQUIRE(grid.next_column(100, 0, 50, 50, 1000) == 250);
+
+        // Windows out of the row are ignored.
+        REQUIRE(grid.next_column(0, 200, 50, 50, 1000) == 1000);
+
+        REQUIRE(grid.next_row(0, 50, 1000) == 100);
+        REQUIRE(grid.next_row(100, 50, 1000) == 1000);
+    }
+
+    SECTION("compare with linear search")
+    {
+        auto const rects = random_rects(200);
+        win::placement_grid grid(rects);
+
+        std::mt19937 gen(0);
+        std::uniform_int_distribution<> pos(-500, 4500);
+        std::uniform_int_distribution<> size(0, 1500);
+
+        for (int i = 0; i < 1000; ++i) {
+            auto const x = pos(gen);
+            auto const y = pos(gen);
+            auto const width = size(gen);
+            auto const height = size(gen);
+            auto const possible = pos(gen);
+
+            REQUIRE(grid.overlap(x, y, x + width, y + height)
+                    == overlap_linear(rects, x, y, x + width, y + height));
+            REQUIRE(grid.next_row(y, height, possible)
+                    == next_row_linear(rects, y, height, possible));
+            REQUIRE(grid.next_column(x, y, width, height, possible)
+                    == next_column_linear(rects, x, y, width, height, possible));
+        }
+    }
+}
+
+TEST_CASE("placement grid benchmark", "[win],[unit],[!benchmark]")
+{
+    auto count = GENERATE(100, 1000);
+    auto const rects = random_rects(count);
+
+    BENCHMARK("grid " + std::to_string(count) + " windows")
+    {
+        win::placement_grid grid(rects);
+        long int overlap = 0;
+        for (int x = 0; x < 3840; x += 64) {
+            overlap += grid.overlap(x, 1000, x + 640, 1480);
+        }
+        return overlap;
+    };
+
+    BENCHMARK("linear " + std::to_string(count) + " windows")
+    {
+        long int overlap = 0;
+        for (int x = 0; x < 3840; x += 64) {
+            overlap += overlap_linear(rects, x, 1000, x + 640, 1480);
+        }
+        return overlap;
+    };
+}
+
+}
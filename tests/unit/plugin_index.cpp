@@ -0,0 +1,184 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/base/plugin_index.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <utime.h>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+QString const plugin_index_type{QStringLiteral("KWin/Script")};
+QString const plugin_index_root{QStringLiteral("como/plugin-index-test")};
+
+void write_package(QString const& dir, QString const& id, QString const& name)
+{
+    REQUIRE(QDir().mkpath(dir + QLatin1Char('/') + id));
+
+    QJsonObject const metadata{
+        {QStringLiteral("KPackageStructure"), plugin_index_type},
+        {QStringLiteral("KPlugin"),
+         QJsonObject{{QStringLiteral("Id"), id}, {QStringLiteral("Name"), name}}},
+    };
+
+    QFile file(dir + QLatin1Char('/') + id + QStringLiteral("/metadata.json"));
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(QJsonDocument(metadata).toJson());
+}
+
+QString package_name(base::plugin_index& index, QString const& id)
+{
+    return index.find_package(plugin_index_type, plugin_index_root, id).name();
+}
+
+QJsonObject read_index(QString const& path)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+void write_index(QString const& path, QByteArray const& data)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(data);
+}
+
+// Replaces the name in the persisted metadata of all packages. A restored index returns it, a
+// rescan returns the name on disk.
+void rename_in_index(QString const& path, QString const& name)
+{
+    auto root = read_index(path);
+    auto sources = root.value(QStringLiteral("sources")).toObject();
+
+    for (auto const& key : sources.keys()) {
+        auto src = sources.value(key).toObject();
+        QJsonArray files;
+        for (auto const& value : src.value(QStringLiteral("files")).toArray()) {
+            auto file = value.toObject();
+            auto metadata = file.value(QStringLiteral("metadata")).toObject();
+            auto plugin = metadata.value(QStringLiteral("KPlugin")).toObject();
+            plugin[QStringLiteral("Name")] = name;
+            metadata[QStringLiteral("KPlugin")] = plugin;
+            file[QStringLiteral("metadata")] = metadata;
+            files.append(file);
+        }
+        src[QStringLiteral("files")] = files;
+        sources[key] = src;
+    }
+
+    root[QStringLiteral("sources")] = sources;
+    write_index(path, QJsonDocument(root).toJson());
+}
+
+struct standard_paths_test_mode {
+    standard_paths_test_mode()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+    }
+    ~standard_paths_test_mode()
+    {
+        QStandardPaths::setTestModeEnabled(false);
+    }
+};
+
+}
+
+TEST_CASE("plugin index", "[base],[unit]")
+{
+    standard_paths_test_mode test_mode;
+    qunsetenv("KWIN_PLUGIN_INDEX_CACHE");
+
+    auto const data_dir = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation)
+        + QLatin1Char('/') + plugin_index_root;
+    auto const cache_dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+        + QStringLiteral("/como");
+    auto const index_file = cache_dir + QStringLiteral("/plugin-index.json");
+
+    QDir(data_dir).removeRecursively();
+    QDir(cache_dir).removeRecursively();
+
+    write_package(data_dir, QStringLiteral("first"), QStringLiteral("First"));
+    write_package(data_dir, QStringLiteral("second"), QStringLiteral("Second"));
+
+    {
+        base::plugin_index index;
+        auto const packages = index.packages(plugin_index_type, plugin_index_root);
+        REQUIRE(packages.size() == 2);
+        REQUIRE(package_name(index, QStringLiteral("first")) == QStringLiteral("First"));
+    }
+
+    REQUIRE(QFile::exists(index_file));
+    rename_in_index(index_file, QStringLiteral("Cached"));
+
+    SECTION("warm hit")
+    {
+        base::plugin_index index;
+
+        auto const packages = index.packages(plugin_index_type, plugin_index_root);
+        REQUIRE(packages.size() == 2);
+        for (auto const& data : packages) {
+            REQUIRE(data.name() == QStringLiteral("Cached"));
+        }
+        REQUIRE(package_name(index, QStringLiteral("second")) == QStringLiteral("Cached"));
+    }
+
+    SECTION("directory change")
+    {
+        // Any different modification time of a search directory invalidates its source.
+        utimbuf const times{1000, 1000};
+        REQUIRE(utime(QFile::encodeName(data_dir).constData(), &times) == 0);
+
+        base::plugin_index index;
+        REQUIRE(package_name(index, QStringLiteral("first")) == QStringLiteral("First"));
+
+        // The rescanned source is persisted again.
+        auto const sources = read_index(index_file).value(QStringLiteral("sources")).toObject();
+        REQUIRE(!sources.isEmpty());
+        auto const src = sources.begin().value().toObject();
+        auto const directories = src.value(QStringLiteral("directories")).toArray();
+        REQUIRE(directories.first().toObject().value(QStringLiteral("mtime")).toInteger()
+                == 1000 * 1000);
+    }
+
+    SECTION("corrupt index")
+    {
+        write_index(index_file, QByteArrayLiteral("{\"version\": 1, \"sources\": {"));
+
+        base::plugin_index index;
+        REQUIRE(package_name(index, QStringLiteral("first")) == QStringLiteral("First"));
+
+        // The index is rebuilt.
+        REQUIRE(read_index(index_file).value(QStringLiteral("version")).toInt() == 1);
+    }
+
+    SECTION("foreign version")
+    {
+        auto root = read_index(index_file);
+        root[QStringLiteral("version")] = 1000;
+        write_index(index_file, QJsonDocument(root).toJson());
+
+        base::plugin_index index;
+        REQUIRE(package_name(index, QStringLiteral("first")) == QStringLiteral("First"));
+        REQUIRE(read_index(index_file).value(QStringLiteral("version")).toInt() == 1);
+    }
+
+    QDir(data_dir).removeRecursively();
+    QDir(cache_dir).removeRecursively();
+}
+
+}
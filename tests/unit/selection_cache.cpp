@@ -0,0 +1,60 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/xwl/selection_cache.h"
+
+namespace como::detail::test
+{
+
+TEST_CASE("selection cache", "[xwl],[unit]")
+{
+    xwl::selection_cache cache;
+    auto& metrics = xwl::selection_cache_metrics::instance();
+
+    SECTION("hit and miss")
+    {
+        auto const hits = metrics.hits.value();
+        auto const misses = metrics.misses.value();
+        auto const served = metrics.served.value();
+
+        REQUIRE(!cache.get(1));
+        REQUIRE(metrics.misses.value() == misses + 1);
+
+        cache.insert(1, QByteArrayLiteral("text"));
+        auto data = cache.get(1);
+        REQUIRE(data);
+        REQUIRE(*data == QByteArrayLiteral("text"));
+        REQUIRE(metrics.hits.value() == hits + 1);
+        REQUIRE(metrics.served.value() == served + 4);
+
+        // Data is cached per target.
+        REQUIRE(!cache.get(2));
+    }
+
+    SECTION("first data is kept")
+    {
+        cache.insert(1, QByteArrayLiteral("first"));
+        cache.insert(1, QByteArrayLiteral("second"));
+        REQUIRE(*cache.get(1) == QByteArrayLiteral("first"));
+    }
+
+    SECTION("size limit")
+    {
+        auto const half = static_cast<qsizetype>(xwl::selection_cache::max_size / 2);
+
+        cache.insert(1, QByteArray(half, 'a'));
+        cache.insert(2, QByteArray(half, 'b'));
+        REQUIRE(cache.get(1));
+        REQUIRE(cache.get(2));
+
+        // The cache is full.
+        cache.insert(3, QByteArrayLiteral("c"));
+        REQUIRE(!cache.get(3));
+    }
+}
+
+}
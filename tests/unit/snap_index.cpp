@@ -0,0 +1,151 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/win/snap_index.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <random>
+#include <string>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+std::vector<int> near(win::snap_index<int> const& index, QRect const& geo, int distance)
+{
+    std::vector<int> found;
+    index.for_each_near({geo.x(), geo.x() + geo.width()},
+                        {geo.y(), geo.y() + geo.height()},
+                        distance,
+                        [&](int win) { found.push_back(win); });
+    return found;
+}
+
+bool is_near(int edge, int pos, int distance)
+{
+    return std::abs(edge - pos) < distance;
+}
+
+// Reference to compare the index with.
+std::vector<int> near_linear(std::vector<QRect> const& geos, QRect const& geo, int distance)
+{
+    std::vector<int> found;
+
+    for (size_t i = 0; i < geos.size(); ++i) {
+        auto const& other = geos[i];
+        bool found_x{false};
+        bool found_y{false};
+
+        for (auto pos : {geo.x(), geo.x() + geo.width()}) {
+            found_x |= is_near(other.x(), pos, distance)
+                || is_near(other.x() + other.width(), pos, distance);
+        }
+        for (auto pos : {geo.y(), geo.y() + geo.height()}) {
+            found_y |= is_near(other.y(), pos, distance)
+                || is_near(other.y() + other.height(), pos, distance);
+        }
+
+        if (found_x || found_y) {
+            found.push_back(static_cast<int>(i));
+        }
+    }
+
+    return found;
+}
+
+std::vector<QRect> random_geometries(int count)
+{
+    std::mt19937 gen(count);
+    std::uniform_int_distribution<> pos(0, 3840);
+    std::uniform_int_distribution<> size(100, 1200);
+
+    std::vector<QRect> geos;
+    for (int i = 0; i < count; ++i) {
+        geos.emplace_back(pos(gen), pos(gen), size(gen), size(gen));
+    }
+    return geos;
+}
+
+}
+
+TEST_CASE("snap index", "[win],[unit]")
+{
+    win::snap_index<int> index;
+
+    SECTION("find edges")
+    {
+        index.add(0, QRect(0, 0, 100, 100));
+        index.add(1, QRect(500, 500, 100, 100));
+        index.add(2, QRect(105, 300, 50, 50));
+        REQUIRE(index.size() == 3);
+
+        // The right edge of the first window at 100 and the left edge of the third one at 105.
+        REQUIRE(near(index, QRect(93, 1000, 4, 10), 10) == std::vector<int>{0, 2});
+        REQUIRE(near(index, QRect(93, 1000, 4, 10), 5) == std::vector<int>{0});
+
+        // The bottom edge of the second window at 600.
+        REQUIRE(near(index, QRect(2000, 580, 10, 10), 11) == std::vector<int>{1});
+        REQUIRE(near(index, QRect(2000, 580, 10, 10), 10).empty());
+    }
+
+    SECTION("update and remove")
+    {
+        index.add(0, QRect(0, 0, 100, 100));
+        index.add(1, QRect(500, 500, 100, 100));
+
+        index.update(0, QRect(490, 0, 10, 10));
+        REQUIRE(near(index, QRect(495, 1000, 10, 10), 6) == std::vector<int>{0, 1});
+
+        index.remove(0);
+        REQUIRE(index.size() == 1);
+        REQUIRE(near(index, QRect(495, 1000, 10, 10), 6) == std::vector<int>{1});
+
+        // Adding a window again places it after the others.
+        index.add(0, QRect(600, 0, 10, 10));
+        REQUIRE(near(index, QRect(595, 1000, 10, 10), 6) == std::vector<int>{1, 0});
+    }
+
+    SECTION("compare with linear search")
+    {
+        auto const geos = random_geometries(500);
+        for (size_t i = 0; i < geos.size(); ++i) {
+            index.add(static_cast<int>(i), geos[i]);
+        }
+
+        for (auto const& geo : random_geometries(50)) {
+            REQUIRE(near(index, geo, 16) == near_linear(geos, geo, 16));
+        }
+    }
+}
+
+TEST_CASE("snap index benchmark", "[win],[unit],[!benchmark]")
+{
+    auto count = GENERATE(100, 1000);
+
+    auto const geos = random_geometries(count);
+    win::snap_index<int> index;
+    for (int i = 0; i < count; ++i) {
+        index.add(i, geos[i]);
+    }
+
+    QRect const geo(1000, 800, 640, 480);
+
+    BENCHMARK("index " + std::to_string(count) + " windows")
+    {
+        return near(index, geo, 16);
+    };
+
+    BENCHMARK("linear " + std::to_string(count) + " windows")
+    {
+        return near_linear(geos, geo, 16);
+    };
+}
+
+}